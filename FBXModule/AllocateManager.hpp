@@ -10,12 +10,14 @@
 
 
 #include <cassert>
+#include <atomic>
 
 #include <jemalloc/jemalloc.h>
 
 
-size_t dynamicAllocCount = 0u;
-size_t dynamicAlignAllocCount = 0u;
+// counted atomically, since allocating code runs in parallel loops(std::execution::par)
+std::atomic<size_t> dynamicAllocCount{ 0u };
+std::atomic<size_t> dynamicAlignAllocCount{ 0u };
 
 
 void* FBXM_ALLOC(std::size_t size){
@@ -13,3 +13,12 @@
 bool SIMDCompetible(){
     return DirectX::XMVerifyCPUSupport();
 }
+
+void GetBindWorldMatrix(float* pOutMatrix, const FBXNode* pNode){
+    auto xmm4_ret = DirectX::XMLoadFloat4x4((const DirectX::XMFLOAT4X4*)pNode->TransformMatrix.Values);
+    for(pNode = pNode->Parent; pNode; pNode = pNode->Parent){
+        auto xmm4_tmp = DirectX::XMLoadFloat4x4((const DirectX::XMFLOAT4X4*)pNode->TransformMatrix.Values);
+        xmm4_ret = DirectX::XMMatrixMultiply(xmm4_ret, xmm4_tmp);
+    }
+    DirectX::XMStoreFloat4x4((DirectX::XMFLOAT4X4*)pOutMatrix, xmm4_ret);
+}
@@ -30,6 +30,8 @@
 #include "DirectXMath/Extensions/DirectXMathFMA3.h"
 #endif
 
+#include <FBXAnimation.hpp>
+
 #include "FBXUtilites.h"
 
 
@@ -179,3 +181,344 @@ static inline Float3 Normalize3(const Float3& flt3){
 
     return ret;
 }
+
+
+static inline __m128i XMMHashAccumulate(__m128i xmm_acc, __m128i xmm_data, __m128i xmm_secret){
+    auto xmm_key = _mm_xor_si128(xmm_data, xmm_secret);
+    auto xmm_keyHi = _mm_shuffle_epi32(xmm_key, _MM_SHUFFLE(0, 3, 0, 1));
+    auto xmm_product = _mm_mul_epu32(xmm_key, xmm_keyHi);
+
+    auto xmm_swapped = _mm_shuffle_epi32(xmm_data, _MM_SHUFFLE(1, 0, 3, 2));
+
+    xmm_acc = _mm_add_epi64(xmm_acc, xmm_swapped);
+    xmm_acc = _mm_add_epi64(xmm_acc, xmm_product);
+
+    return xmm_acc;
+}
+static inline unsigned long long MixHash64(unsigned long long h){
+    h ^= h >> 37;
+    h *= 0x165667919E3779F9ull;
+    h ^= h >> 32;
+    return h;
+}
+static inline unsigned long long CombineHash64(unsigned long long seed, unsigned long long v){
+    return MixHash64((seed ^ v) * 0x9E3779B185EBCA87ull + 0x27D4EB2F165667C5ull);
+}
+// -0. + 0. gives +0., so both zeros feed identical bits while NaN stays unequal anyway
+static inline __m128i XMMHashCanonical(__m128d xmm_val){ return _mm_castpd_si128(_mm_add_pd(xmm_val, _mm_setzero_pd())); }
+static inline __m128i XMMHashCanonical(__m128 xmm_val){ return _mm_castps_si128(_mm_add_ps(xmm_val, _mm_setzero_ps())); }
+
+// xxh3 styled hash over double streams. hashes equal for values which compare equal by operator==, except NaN
+static inline unsigned long long MakeHash64(const double* data, size_t count, unsigned long long seed = 0ull){
+    const auto xmm_secret0 = _mm_set_epi64x(0x1CAD21F72C81017Cll, (long long)0xBE4BA423396CFEB8ull);
+    const auto xmm_secret1 = _mm_set_epi64x((long long)0xDB979083E96DD4DEll, 0x1F67B3B7A4A44072ll);
+
+    auto xmm_acc0 = _mm_set_epi64x((long long)0x9E3779B185EBCA87ull, (long long)(seed ^ 0xC2B2AE3D27D4EB4Full));
+    auto xmm_acc1 = _mm_set_epi64x((long long)0x165667B19E3779F9ull, (long long)(seed + 0x85EBCA77C2B2AE63ull));
+
+    const auto* p = data;
+    for(; FBX_PTRDIFFU((data + count) - p) >= 4u; p += 4){
+        xmm_acc0 = XMMHashAccumulate(xmm_acc0, XMMHashCanonical(_mm_loadu_pd(p)), xmm_secret0);
+        xmm_acc1 = XMMHashAccumulate(xmm_acc1, XMMHashCanonical(_mm_loadu_pd(p + 2)), xmm_secret1);
+    }
+    if(FBX_PTRDIFFU((data + count) - p) >= 2u){
+        xmm_acc0 = XMMHashAccumulate(xmm_acc0, XMMHashCanonical(_mm_loadu_pd(p)), xmm_secret0);
+        p += 2;
+    }
+    if(p != (data + count))
+        xmm_acc1 = XMMHashAccumulate(xmm_acc1, XMMHashCanonical(_mm_load_sd(p)), xmm_secret1);
+
+    alignas(16) unsigned long long acc[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(&acc[0]), xmm_acc0);
+    _mm_store_si128(reinterpret_cast<__m128i*>(&acc[2]), xmm_acc1);
+
+    auto result = (unsigned long long)count * 0x9E3779B185EBCA87ull;
+    for(const auto& i : acc)
+        result = CombineHash64(result, i);
+
+    return result;
+}
+static inline unsigned long long MakeHash64(const float* data, size_t count, unsigned long long seed = 0ull){
+    const auto xmm_secret0 = _mm_set_epi64x(0x1CAD21F72C81017Cll, (long long)0xBE4BA423396CFEB8ull);
+    const auto xmm_secret1 = _mm_set_epi64x((long long)0xDB979083E96DD4DEll, 0x1F67B3B7A4A44072ll);
+
+    auto xmm_acc0 = _mm_set_epi64x((long long)0x9E3779B185EBCA87ull, (long long)(seed ^ 0xC2B2AE3D27D4EB4Full));
+    auto xmm_acc1 = _mm_set_epi64x((long long)0x165667B19E3779F9ull, (long long)(seed + 0x85EBCA77C2B2AE63ull));
+
+    const auto* p = data;
+    for(; FBX_PTRDIFFU((data + count) - p) >= 8u; p += 8){
+        xmm_acc0 = XMMHashAccumulate(xmm_acc0, XMMHashCanonical(_mm_loadu_ps(p)), xmm_secret0);
+        xmm_acc1 = XMMHashAccumulate(xmm_acc1, XMMHashCanonical(_mm_loadu_ps(p + 4)), xmm_secret1);
+    }
+    if(p != (data + count)){
+        alignas(16) float tail[8] = { 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f };
+        for(auto* d = tail; p != (data + count); ++p, ++d)
+            *d = *p;
+
+        xmm_acc0 = XMMHashAccumulate(xmm_acc0, XMMHashCanonical(_mm_load_ps(tail)), xmm_secret0);
+        xmm_acc1 = XMMHashAccumulate(xmm_acc1, XMMHashCanonical(_mm_load_ps(tail + 4)), xmm_secret1);
+    }
+
+    alignas(16) unsigned long long acc[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(&acc[0]), xmm_acc0);
+    _mm_store_si128(reinterpret_cast<__m128i*>(&acc[2]), xmm_acc1);
+
+    auto result = (unsigned long long)count * 0x9E3779B185EBCA87ull;
+    for(const auto& i : acc)
+        result = CombineHash64(result, i);
+
+    return result;
+}
+
+
+template<typename T, unsigned long N>
+static inline void InterpolateKeyValue(T(&pOut)[N], const FBXStaticArray<T, N>* pV0, const FBXStaticArray<T, N>* pV1, float t){}
+template<>
+inline void InterpolateKeyValue(float(&pOut)[3], const FBXStaticArray<float, 3>* pV0, const FBXStaticArray<float, 3>* pV1, float t){
+    auto xmm_v0 = DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)pV0->Values);
+    auto xmm_v1 = DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)pV1->Values);
+
+    auto xmm_v = DirectX::XMVectorLerp(xmm_v0, xmm_v1, t);
+    DirectX::XMStoreFloat3((DirectX::XMFLOAT3*)pOut, xmm_v);
+}
+template<>
+inline void InterpolateKeyValue(float(&pOut)[4], const FBXStaticArray<float, 4>* pV0, const FBXStaticArray<float, 4>* pV1, float t){
+    auto xmm_v0 = DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)pV0->Values);
+    auto xmm_v1 = DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)pV1->Values);
+
+    auto xmm_v = DirectX::XMQuaternionSlerp(xmm_v0, xmm_v1, t);
+    xmm_v = DirectX::XMQuaternionNormalize(xmm_v);
+    DirectX::XMStoreFloat4((DirectX::XMFLOAT4*)pOut, xmm_v);
+}
+
+// tangents are slopes per second, so they are scaled by the segment duration
+template<typename T, unsigned long N>
+static inline void HermiteKeyValue(T(&pOut)[N], const FBXStaticArray<T, N>* pV0, const FBXStaticArray<T, N>* pT0, const FBXStaticArray<T, N>* pV1, const FBXStaticArray<T, N>* pT1, float t, float duration){}
+template<>
+inline void HermiteKeyValue(float(&pOut)[3], const FBXStaticArray<float, 3>* pV0, const FBXStaticArray<float, 3>* pT0, const FBXStaticArray<float, 3>* pV1, const FBXStaticArray<float, 3>* pT1, float t, float duration){
+    auto xmm_v0 = DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)pV0->Values);
+    auto xmm_t0 = DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)pT0->Values);
+    auto xmm_v1 = DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)pV1->Values);
+    auto xmm_t1 = DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)pT1->Values);
+
+    xmm_t0 = DirectX::XMVectorScale(xmm_t0, duration);
+    xmm_t1 = DirectX::XMVectorScale(xmm_t1, duration);
+
+    auto xmm_v = DirectX::XMVectorHermite(xmm_v0, xmm_t0, xmm_v1, xmm_t1, t);
+    DirectX::XMStoreFloat3((DirectX::XMFLOAT3*)pOut, xmm_v);
+}
+template<>
+inline void HermiteKeyValue(float(&pOut)[4], const FBXStaticArray<float, 4>* pV0, const FBXStaticArray<float, 4>* pT0, const FBXStaticArray<float, 4>* pV1, const FBXStaticArray<float, 4>* pT1, float t, float duration){
+    auto xmm_v0 = DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)pV0->Values);
+    auto xmm_t0 = DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)pT0->Values);
+    auto xmm_v1 = DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)pV1->Values);
+    auto xmm_t1 = DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)pT1->Values);
+
+    // same hemisphere as the first key, as slerp does
+    if(DirectX::XMVectorGetX(DirectX::XMVector4Dot(xmm_v0, xmm_v1)) < 0.f){
+        xmm_v1 = DirectX::XMVectorNegate(xmm_v1);
+        xmm_t1 = DirectX::XMVectorNegate(xmm_t1);
+    }
+
+    xmm_t0 = DirectX::XMVectorScale(xmm_t0, duration);
+    xmm_t1 = DirectX::XMVectorScale(xmm_t1, duration);
+
+    auto xmm_v = DirectX::XMVectorHermite(xmm_v0, xmm_t0, xmm_v1, xmm_t1, t);
+    xmm_v = DirectX::XMQuaternionNormalize(xmm_v);
+    DirectX::XMStoreFloat4((DirectX::XMFLOAT4*)pOut, xmm_v);
+}
+
+// tracks without cubic keys carry no tangents, which read as flat
+template<typename T>
+static inline const FBXAnimationKeyTangent<T>& GetKeyTangent(const FBXDynamicArray<FBXAnimationKeyTangent<T>>& tangents, size_t idxKey){
+    static const FBXAnimationKeyTangent<T> flatTangent{};
+    return (idxKey < tangents.Length) ? tangents.Values[idxKey] : flatTangent;
+}
+
+template<typename T, unsigned long N>
+static inline void ComputeLocalKeyByTime(T(&pOut)[N], float time, const FBXDynamicArray<FBXAnimationKeyFrame<FBXStaticArray<T, N>>>* pTable, const FBXDynamicArray<FBXAnimationKeyTangent<FBXStaticArray<T, N>>>* pTangents, unsigned long* pCursor = nullptr){
+    const auto idxKey = FindAnimationKey(*pTable, time, pCursor ? (*pCursor) : 0);
+    if(pCursor)
+        (*pCursor) = idxKey;
+
+    const auto* pData = &pTable->Values[idxKey];
+    if((idxKey + 1) < pTable->Length){
+        const auto* pNextData = pData + 1;
+        switch(pData->InterpolationType){
+        case FBXAnimationInterpolationType::FBXAnimationInterpolationType_Stepped:
+        {
+            CopyArrayData(pOut, pData->Local.Values);
+            return;
+        }
+        case FBXAnimationInterpolationType::FBXAnimationInterpolationType_Linear:
+        {
+            auto fTime = (time - pData->Time) / (pNextData->Time - pData->Time);
+            InterpolateKeyValue<T, N>(pOut, &pData->Local, &pNextData->Local, fTime);
+            return;
+        }
+        case FBXAnimationInterpolationType::FBXAnimationInterpolationType_Cubic:
+        {
+            auto fDuration = pNextData->Time - pData->Time;
+            auto fTime = (time - pData->Time) / fDuration;
+            HermiteKeyValue<T, N>(pOut, &pData->Local, &GetKeyTangent(*pTangents, idxKey).Local.Out, &pNextData->Local, &GetKeyTangent(*pTangents, idxKey + 1).Local.In, fTime, fDuration);
+            return;
+        }
+        }
+    }
+
+    CopyArrayData(pOut, pData->Local.Values);
+}
+template<typename T, unsigned long N>
+static inline void ComputeWorldKeyByTime(T(&pOut)[N], float time, const FBXDynamicArray<FBXAnimationKeyFrame<FBXStaticArray<T, N>>>* pTable, const FBXDynamicArray<FBXAnimationKeyTangent<FBXStaticArray<T, N>>>* pTangents, unsigned long* pCursor = nullptr){
+    const auto idxKey = FindAnimationKey(*pTable, time, pCursor ? (*pCursor) : 0);
+    if(pCursor)
+        (*pCursor) = idxKey;
+
+    const auto* pData = &pTable->Values[idxKey];
+    if((idxKey + 1) < pTable->Length){
+        const auto* pNextData = pData + 1;
+        switch(pData->InterpolationType){
+        case FBXAnimationInterpolationType::FBXAnimationInterpolationType_Stepped:
+        {
+            CopyArrayData(pOut, pData->World.Values);
+            return;
+        }
+        case FBXAnimationInterpolationType::FBXAnimationInterpolationType_Linear:
+        {
+            auto fTime = (time - pData->Time) / (pNextData->Time - pData->Time);
+            InterpolateKeyValue<T, N>(pOut, &pData->World, &pNextData->World, fTime);
+            return;
+        }
+        case FBXAnimationInterpolationType::FBXAnimationInterpolationType_Cubic:
+        {
+            auto fDuration = pNextData->Time - pData->Time;
+            auto fTime = (time - pData->Time) / fDuration;
+            HermiteKeyValue<T, N>(pOut, &pData->World, &GetKeyTangent(*pTangents, idxKey).World.Out, &pNextData->World, &GetKeyTangent(*pTangents, idxKey + 1).World.In, fTime, fDuration);
+            return;
+        }
+        }
+    }
+
+    CopyArrayData(pOut, pData->World.Values);
+}
+
+// XMMatrixDecompose gives up on sheared matrices, which non-uniform scale of an ancestor leaves in world transforms.
+// rows are orthonormalized from x then, so that rotation is always valid
+static inline void DecomposeTransform(DirectX::XMVECTOR* pOutScale, DirectX::XMVECTOR* pOutRotation, DirectX::XMVECTOR* pOutTranslation, DirectX::FXMMATRIX xmm4_transform){
+    if(DirectX::XMMatrixDecompose(pOutScale, pOutRotation, pOutTranslation, xmm4_transform))
+        return;
+
+    auto xmm_scale = DirectX::XMVectorSet(
+        DirectX::XMVectorGetX(DirectX::XMVector3Length(xmm4_transform.r[0])),
+        DirectX::XMVectorGetX(DirectX::XMVector3Length(xmm4_transform.r[1])),
+        DirectX::XMVectorGetX(DirectX::XMVector3Length(xmm4_transform.r[2])),
+        0.f
+    );
+
+    DirectX::XMMATRIX xmm4_basis;
+    xmm4_basis.r[0] = DirectX::XMVector3Normalize(xmm4_transform.r[0]);
+    xmm4_basis.r[2] = DirectX::XMVector3Normalize(DirectX::XMVector3Cross(xmm4_basis.r[0], xmm4_transform.r[1]));
+    xmm4_basis.r[1] = DirectX::XMVector3Cross(xmm4_basis.r[2], xmm4_basis.r[0]);
+    xmm4_basis.r[3] = DirectX::g_XMIdentityR3;
+
+    // mirrored. the flip goes to x as XMMatrixDecompose does
+    if(DirectX::XMVectorGetX(DirectX::XMVector3Dot(xmm4_basis.r[2], xmm4_transform.r[2])) < 0.f){
+        xmm_scale = DirectX::XMVectorMultiply(xmm_scale, DirectX::g_XMNegateX);
+        xmm4_basis.r[0] = DirectX::XMVectorNegate(xmm4_basis.r[0]);
+        xmm4_basis.r[2] = DirectX::XMVectorNegate(xmm4_basis.r[2]);
+    }
+
+    *pOutScale = xmm_scale;
+    *pOutRotation = DirectX::XMQuaternionNormalize(DirectX::XMQuaternionRotationMatrix(xmm4_basis));
+    *pOutTranslation = xmm4_transform.r[3];
+}
+
+// error of scaling is relative, of rotation is angle in radian, and of translation is distance
+enum class KeyErrorType : unsigned char{
+    KeyErrorType_Scaling,
+    KeyErrorType_Rotation,
+    KeyErrorType_Translation,
+};
+
+template<KeyErrorType TYPE>
+static inline float ComputeKeyError(DirectX::FXMVECTOR xmm_source, DirectX::FXMVECTOR xmm_reduced){
+    switch(TYPE){
+    case KeyErrorType::KeyErrorType_Scaling:
+    {
+        auto xmm_scale = DirectX::XMVectorMax(DirectX::XMVectorAbs(xmm_source), DirectX::XMVectorReplicate(FLT_EPSILON));
+        auto xmm_error = DirectX::XMVectorDivide(DirectX::XMVectorAbs(DirectX::XMVectorSubtract(xmm_source, xmm_reduced)), xmm_scale);
+        return std::max(std::max(DirectX::XMVectorGetX(xmm_error), DirectX::XMVectorGetY(xmm_error)), DirectX::XMVectorGetZ(xmm_error));
+    }
+    case KeyErrorType::KeyErrorType_Rotation:
+    {
+        // acos of the dot loses every small angle in float, so the angle is taken from the difference rotation
+        auto xmm_delta = DirectX::XMQuaternionMultiply(DirectX::XMQuaternionConjugate(xmm_source), xmm_reduced);
+        auto fSin = DirectX::XMVectorGetX(DirectX::XMVector3Length(xmm_delta));
+        return 2.f * std::atan2(fSin, std::fabs(DirectX::XMVectorGetW(xmm_delta)));
+    }
+    default:
+        return DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMVectorSubtract(xmm_source, xmm_reduced)));
+    }
+}
+
+static inline void ComputeLocalTransformByTime(Float3* pOutScale, Float4* pOutRotation, Float3* pOutTranslation, const FBXAnimationNode* pAnimationNode, FBXAnimationCursor* pCursor, float time){
+    fbxsdk::FbxAMatrix matRef;
+    CopyArrayData<pAnimationNode->BindNode->TransformMatrix.Length>((double*)matRef, pAnimationNode->BindNode->TransformMatrix.Values);
+
+    if(!pAnimationNode->ScalingKeys.Length){
+        auto vValue = matRef.GetS();
+        CopyArrayData(pOutScale->raw, vValue.mData);
+    }
+    else{
+        auto fTime = std::clamp(time, pAnimationNode->ScalingKeys.Values[0].Time, pAnimationNode->ScalingKeys.Values[pAnimationNode->ScalingKeys.Length - 1].Time);
+        ComputeLocalKeyByTime(pOutScale->raw, fTime, &pAnimationNode->ScalingKeys, &pAnimationNode->ScalingTangents, pCursor ? &pCursor->ScalingKey : nullptr);
+    }
+
+    if(!pAnimationNode->RotationKeys.Length){
+        auto vValue = matRef.GetQ();
+        CopyArrayData(pOutRotation->raw, vValue.mData);
+    }
+    else{
+        auto fTime = std::clamp(time, pAnimationNode->RotationKeys.Values[0].Time, pAnimationNode->RotationKeys.Values[pAnimationNode->RotationKeys.Length - 1].Time);
+        ComputeLocalKeyByTime(pOutRotation->raw, fTime, &pAnimationNode->RotationKeys, &pAnimationNode->RotationTangents, pCursor ? &pCursor->RotationKey : nullptr);
+    }
+
+    if(!pAnimationNode->TranslationKeys.Length){
+        auto vValue = matRef.GetT();
+        CopyArrayData(pOutTranslation->raw, vValue.mData);
+    }
+    else{
+        auto fTime = std::clamp(time, pAnimationNode->TranslationKeys.Values[0].Time, pAnimationNode->TranslationKeys.Values[pAnimationNode->TranslationKeys.Length - 1].Time);
+        ComputeLocalKeyByTime(pOutTranslation->raw, fTime, &pAnimationNode->TranslationKeys, &pAnimationNode->TranslationTangents, pCursor ? &pCursor->TranslationKey : nullptr);
+    }
+}
+static inline void ComputeWorldTransformByTime(Float3* pOutScale, Float4* pOutRotation, Float3* pOutTranslation, const FBXAnimationNode* pAnimationNode, FBXAnimationCursor* pCursor, float time){
+    const auto matRef = GetBindWorldTransform(pAnimationNode->BindNode);
+
+    if(!pAnimationNode->ScalingKeys.Length){
+        auto vValue = matRef.GetS();
+        CopyArrayData(pOutScale->raw, vValue.mData);
+    }
+    else{
+        auto fTime = std::clamp(time, pAnimationNode->ScalingKeys.Values[0].Time, pAnimationNode->ScalingKeys.Values[pAnimationNode->ScalingKeys.Length - 1].Time);
+        ComputeWorldKeyByTime(pOutScale->raw, fTime, &pAnimationNode->ScalingKeys, &pAnimationNode->ScalingTangents, pCursor ? &pCursor->ScalingKey : nullptr);
+    }
+
+    if(!pAnimationNode->RotationKeys.Length){
+        auto vValue = matRef.GetQ();
+        CopyArrayData(pOutRotation->raw, vValue.mData);
+    }
+    else{
+        auto fTime = std::clamp(time, pAnimationNode->RotationKeys.Values[0].Time, pAnimationNode->RotationKeys.Values[pAnimationNode->RotationKeys.Length - 1].Time);
+        ComputeWorldKeyByTime(pOutRotation->raw, fTime, &pAnimationNode->RotationKeys, &pAnimationNode->RotationTangents, pCursor ? &pCursor->RotationKey : nullptr);
+    }
+
+    if(!pAnimationNode->TranslationKeys.Length){
+        auto vValue = matRef.GetT();
+        CopyArrayData(pOutTranslation->raw, vValue.mData);
+    }
+    else{
+        auto fTime = std::clamp(time, pAnimationNode->TranslationKeys.Values[0].Time, pAnimationNode->TranslationKeys.Values[pAnimationNode->TranslationKeys.Length - 1].Time);
+        ComputeWorldKeyByTime(pOutTranslation->raw, fTime, &pAnimationNode->TranslationKeys, &pAnimationNode->TranslationTangents, pCursor ? &pCursor->TranslationKey : nullptr);
+    }
+}
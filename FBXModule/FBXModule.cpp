@@ -14,6 +14,13 @@ __FBXM_MAKE_FUNC(const void*, FBXGetRoot, void){
     return shr_root;
 }
 
+__FBXM_MAKE_FUNC(void, FBXGetBoneCombinationReport, unsigned long* pGreedyCount, unsigned long* pCount){
+    if(pGreedyCount)
+        (*pGreedyCount) = shr_boneCombinationReport.GreedyCount;
+    if(pCount)
+        (*pCount) = shr_boneCombinationReport.Count;
+}
+
 __FBXM_MAKE_FUNC(void, __hidden_FBXModule_DeleteInnerObject, void* pObj){
     if(pObj)
         FBXDelete(pObj);
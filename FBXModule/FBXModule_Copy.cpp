@@ -178,105 +178,7 @@ __FBXM_MAKE_FUNC(bool, __hidden_FBXModule_CollapseMesh, void** pDest, const void
         pNewMesh->Name = pOldMesh->Name;
         pNewMesh->TransformMatrix = pOldMesh->TransformMatrix;
 
-        pNewMesh->Attributes.Assign(genNodeData.bufMeshAttribute.size());
-        for(size_t idxAttr = 0u; idxAttr < pNewMesh->Attributes.Length; ++idxAttr){
-            const auto& iOldAttr = genNodeData.bufMeshAttribute[idxAttr];
-            auto& iNewAttr = pNewMesh->Attributes.Values[idxAttr];
-
-            iNewAttr.VertexStart = iOldAttr.VertexFirst;
-            iNewAttr.IndexStart = iOldAttr.PolygonFirst;
-
-            iNewAttr.VertexCount = 1 + iOldAttr.VertexLast - iOldAttr.VertexFirst;
-            iNewAttr.IndexCount = 1 + iOldAttr.PolygonLast - iOldAttr.PolygonFirst;
-        }
-
-        pNewMesh->Indices.Assign(genNodeData.bufIndices.size());
-        for(size_t idxInd = 0u; idxInd < pNewMesh->Indices.Length; ++idxInd){
-            auto& iInd = pNewMesh->Indices.Values[idxInd];
-
-            CopyArrayData(iInd.Values, genNodeData.bufIndices[idxInd].raw);
-        }
-
-        pNewMesh->Vertices.Assign(genNodeData.bufPositions.size());
-        for(size_t idxVert = 0u; idxVert < pNewMesh->Vertices.Length; ++idxVert){
-            auto& iVert = pNewMesh->Vertices.Values[idxVert];
-
-            CopyArrayData(iVert.Values, genNodeData.bufPositions[idxVert].mData);
-        }
-
-        pNewMesh->LayeredElements.Assign(genNodeData.bufLayers.size());
-        for(size_t idxLayer = 0u; idxLayer < pNewMesh->LayeredElements.Length; ++idxLayer){
-            auto& iLayer = pNewMesh->LayeredElements.Values[idxLayer];
-            const auto& nodeLayer = genNodeData.bufLayers[idxLayer];
-
-            {
-                auto& iObject = iLayer.Material;
-                const auto& nodeObject = nodeLayer.materials;
-
-                if(nodeObject.empty())
-                    iObject.Assign(0u);
-                else{
-                    iObject.Assign(genNodeData.bufMeshAttribute.size());
-                    for(size_t idxMat = 0u; idxMat < iObject.Length; ++idxMat){
-                        const auto idxOldMat = pNewMesh->Attributes.Values[idxMat].IndexStart;
-                        iObject.Values[idxMat] = nodeObject[idxOldMat];
-                    }
-                }
-            }
-
-            {
-                auto& iObject = iLayer.Color;
-                const auto& nodeObject = nodeLayer.colors;
-
-                iObject.Assign(nodeObject.size());
-                for(size_t idxElem = 0u; idxElem < iObject.Length; ++idxElem)
-                    CopyArrayData(iObject.Values[idxElem].Values, nodeObject[idxElem].mData);
-            }
-
-            {
-                auto& iObject = iLayer.Normal;
-                const auto& nodeObject = nodeLayer.normals;
-
-                iObject.Assign(nodeObject.size());
-                for(size_t idxElem = 0u; idxElem < iObject.Length; ++idxElem)
-                    CopyArrayData(iObject.Values[idxElem].Values, nodeObject[idxElem].mData);
-            }
-
-            {
-                auto& iObject = iLayer.Binormal;
-                const auto& nodeObject = nodeLayer.binormals;
-
-                iObject.Assign(nodeObject.size());
-                for(size_t idxElem = 0u; idxElem < iObject.Length; ++idxElem)
-                    CopyArrayData(iObject.Values[idxElem].Values, nodeObject[idxElem].mData);
-            }
-
-            {
-                auto& iObject = iLayer.Tangent;
-                const auto& nodeObject = nodeLayer.tangents;
-
-                iObject.Assign(nodeObject.size());
-                for(size_t idxElem = 0u; idxElem < iObject.Length; ++idxElem)
-                    CopyArrayData(iObject.Values[idxElem].Values, nodeObject[idxElem].mData);
-            }
-
-            {
-                auto& iObject = iLayer.Texcoord;
-                const auto& nodeObject = nodeLayer.texcoords.table;
-
-                iObject.Assign(nodeObject.size());
-                for(size_t idxElem = 0u; idxElem < iObject.Length; ++idxElem)
-                    CopyArrayData(iObject.Values[idxElem].Values, nodeObject[idxElem].mData);
-            }
-        }
-
-        pNewMesh->Materials.Assign(genNodeData.bufMaterials.size());
-        for(size_t idxMaterial = 0u; idxMaterial < pNewMesh->Materials.Length; ++idxMaterial){
-            auto& iMaterial = pNewMesh->Materials.Values[idxMaterial];
-            const auto& nodeMaterial = genNodeData.bufMaterials[idxMaterial];
-
-            iMaterial = nodeMaterial;
-        }
+        SHRStoreOptimizedMesh(&genNodeData, pNewMesh);
     }
 
     {
@@ -321,6 +223,24 @@ __FBXM_MAKE_FUNC(bool, __hidden_FBXModule_CollapseMesh, void** pDest, const void
 
             ++iDeform;
         }
+
+        SHRStoreBoneBudgets(&genNodeData, pNewMesh);
+        for(size_t idxBudget = 0u; idxBudget < pNewMesh->BoneBudgets.Length; ++idxBudget){
+            auto& iBudget = pNewMesh->BoneBudgets.Values[idxBudget];
+            const auto& nodeBudget = genNodeData.bufBoneBudgets[idxBudget];
+
+            for(size_t idxAttr = 0u; idxAttr < iBudget.BoneCombinations.Length; ++idxAttr){
+                auto& iAttr = iBudget.BoneCombinations.Values[idxAttr];
+                const auto& nodeAttr = nodeBudget.bufBoneCombination[idxAttr];
+
+                for(size_t idxBC = 0u; idxBC < iAttr.Length; ++idxBC){
+                    auto*& iCluster = iAttr.Values[idxBC];
+                    auto* nodeCluster = nodeAttr[idxBC];
+
+                    iCluster = reinterpret_cast<decltype(iCluster)>(nodeCluster);
+                }
+            }
+        }
     }
 
     (*pDest) = pNewMesh;
@@ -49,19 +49,38 @@ static FbxIOSettings* ins_IOSettings = nullptr;
 static std::filesystem::path ins_filePath;
 static unsigned char ins_fileMode = 0;
 
+static fbx_vector<unsigned long> ins_extraBoneCountPerMesh;
+
 
 __FBXM_MAKE_FUNC(bool, FBXOpenFile, const FBX_CHAR* szFilePath, const FBX_CHAR* mode, const void* ioSetting){
     static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXOpenFile(const char*, const char*, unsigned long, const void*)");
 
 
-    if(ioSetting)
-        shr_ioSetting = (*reinterpret_cast<const FBXIOSetting*>(ioSetting));
+    if(ioSetting){
+        const auto* pConvIOSetting = reinterpret_cast<const FBXIOSetting*>(ioSetting);
+        if(pConvIOSetting->ExtraBoneBudgetCount && !pConvIOSetting->ExtraBoneCountPerMesh){
+            SHRPushErrorMessage(FBX_TEXT("\'ExtraBoneCountPerMesh\' must not be null if \'ExtraBoneBudgetCount\' is not 0"), __name_of_this_func);
+            return false;
+        }
+
+        shr_ioSetting = (*pConvIOSetting);
+
+        // the caller's budget list may not outlive this call
+        ins_extraBoneCountPerMesh.assign(shr_ioSetting.ExtraBoneCountPerMesh, shr_ioSetting.ExtraBoneCountPerMesh + shr_ioSetting.ExtraBoneBudgetCount);
+        shr_ioSetting.ExtraBoneCountPerMesh = ins_extraBoneCountPerMesh.data();
+    }
 
     {
         if(shr_ioSetting.MaxBoneCountPerMesh < shr_ioSetting.MaxParticipateClusterPerVertex){
             SHRPushErrorMessage(FBX_TEXT("\'MaxBoneCountPerMesh\' must be bigger or equal to \'MaxParticipateClusterPerVertex\'"), __name_of_this_func);
             return false;
         }
+        for(const auto& maxBoneCount : ins_extraBoneCountPerMesh){
+            if(maxBoneCount < shr_ioSetting.MaxParticipateClusterPerVertex){
+                SHRPushErrorMessage(FBX_TEXT("\'ExtraBoneCountPerMesh\' must be bigger or equal to \'MaxParticipateClusterPerVertex\'"), __name_of_this_func);
+                return false;
+            }
+        }
 
         { // axis converter & unit setting
             FbxAxisSystem::EUpVector kUpVector = FbxAxisSystem::eYAxis;
@@ -53,12 +53,16 @@ __FBXM_MAKE_FUNC(bool, FBXReadScene, void){
     {
         shr_materialTable.clear();
         shr_fbxNodeToExportNode.clear();
+        shr_boneCombinationReport = { 0, 0 };
 
         if(!SHRGenerateNodeTree(shr_SDKManager, shr_scene, shr_materialTable, shr_fbxNodeToExportNode, &shr_root->Nodes)){
             SHRPushErrorMessage(FBX_TEXT("an error occurred while generating object nodes"), __name_of_this_func);
             return false;
         }
 
+        if(shr_ioSetting.ShareInstancedMesh)
+            SHRGenerateMeshInstances(shr_root->Nodes, &shr_root->MeshInstances);
+
         if(!SHRLoadMaterials(shr_materialTable, &shr_root->Materials)){
             SHRPushErrorMessage(FBX_TEXT("an error occurred while loading material data"), __name_of_this_func);
             return false;
@@ -13,76 +13,6 @@
 #include "FBXShared.h"
 
 
-template<typename T, unsigned long N>
-static inline void ins_interpolateValue(T(&pOut)[N], const FBXStaticArray<T, N>* pV0, const FBXStaticArray<T, N>* pV1, float t){}
-template<>
-inline void ins_interpolateValue(float(&pOut)[3], const FBXStaticArray<float, 3>* pV0, const FBXStaticArray<float, 3>* pV1, float t){
-    auto xmm_v0 = DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)pV0->Values);
-    auto xmm_v1 = DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)pV1->Values);
-
-    auto xmm_v = DirectX::XMVectorLerp(xmm_v0, xmm_v1, t);
-    DirectX::XMStoreFloat3((DirectX::XMFLOAT3*)pOut, xmm_v);
-}
-template<>
-inline void ins_interpolateValue(float(&pOut)[4], const FBXStaticArray<float, 4>* pV0, const FBXStaticArray<float, 4>* pV1, float t){
-    auto xmm_v0 = DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)pV0->Values);
-    auto xmm_v1 = DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)pV1->Values);
-
-    auto xmm_v = DirectX::XMQuaternionSlerp(xmm_v0, xmm_v1, t);
-    xmm_v = DirectX::XMQuaternionNormalize(xmm_v);
-    DirectX::XMStoreFloat4((DirectX::XMFLOAT4*)pOut, xmm_v);
-}
-
-template<typename T, unsigned long N>
-static inline void ins_computeLocalByTime(T(&pOut)[N], float time, const FBXDynamicArray<FBXAnimationKeyFrame<FBXStaticArray<T, N>>>* pTable){
-    const FBXAnimationKeyFrame<FBXStaticArray<T, N>>* pNextData = pTable->Values;
-    const FBXAnimationKeyFrame<FBXStaticArray<T, N>>* pData = pNextData++;
-    for(; FBX_PTRDIFFU(pNextData - pTable->Values) < pTable->Length; pData = pNextData++){
-        if(pNextData->Time > time){
-            switch(pData->InterpolationType){
-            case FBXAnimationInterpolationType::FBXAnimationInterpolationType_Stepped:
-            {
-                CopyArrayData(pOut, pData->Local.Values);
-                return;
-            }
-            case FBXAnimationInterpolationType::FBXAnimationInterpolationType_Linear:
-            {
-                auto fTime = (time - pData->Time) / (pNextData->Time - pData->Time);
-                ins_interpolateValue<T, N>(pOut, &pData->Local, &pNextData->Local, fTime);
-                return;
-            }
-            }
-        }
-    }
-
-    CopyArrayData(pOut, pData->Local.Values);
-}
-template<typename T, unsigned long N>
-static inline void ins_computeWorldByTime(T(&pOut)[N], float time, const FBXDynamicArray<FBXAnimationKeyFrame<FBXStaticArray<T, N>>>* pTable){
-    const FBXAnimationKeyFrame<FBXStaticArray<T, N>>* pNextData = pTable->Values;
-    const FBXAnimationKeyFrame<FBXStaticArray<T, N>>* pData = pNextData++;
-    for(; FBX_PTRDIFFU(pNextData - pTable->Values) < pTable->Length; pData = pNextData++){
-        if(pNextData->Time > time){
-            switch(pData->InterpolationType){
-            case FBXAnimationInterpolationType::FBXAnimationInterpolationType_Stepped:
-            {
-                CopyArrayData(pOut, pData->World.Values);
-                return;
-            }
-            case FBXAnimationInterpolationType::FBXAnimationInterpolationType_Linear:
-            {
-                auto fTime = (time - pData->Time) / (pNextData->Time - pData->Time);
-                ins_interpolateValue<T, N>(pOut, &pData->World, &pNextData->World, fTime);
-                return;
-            }
-            }
-        }
-    }
-
-    CopyArrayData(pOut, pData->World.Values);
-}
-
-
 __FBXM_MAKE_FUNC(void, FBXGetWorldMatrix, void* pOutMatrix, const void* pNode){
     const auto* pConvNode = reinterpret_cast<const FBXNode*>(pNode);
 
@@ -95,12 +25,7 @@ __FBXM_MAKE_FUNC(void, FBXGetWorldMatrix, void* pOutMatrix, const void* pNode){
     //}
     //CopyArrayData<16>((float*)pOutMatrix, (double*)kMatRes);
 
-    auto xmm4_ret = DirectX::XMLoadFloat4x4((const DirectX::XMFLOAT4X4*)pConvNode->TransformMatrix.Values);
-    for(pConvNode = pConvNode->Parent; pConvNode; pConvNode = pConvNode->Parent){
-        auto xmm4_tmp = DirectX::XMLoadFloat4x4((const DirectX::XMFLOAT4X4*)pConvNode->TransformMatrix.Values);
-        xmm4_ret = DirectX::XMMatrixMultiply(xmm4_ret, xmm4_tmp);
-    }
-    DirectX::XMStoreFloat4x4((DirectX::XMFLOAT4X4*)pOutMatrix, xmm4_ret);
+    GetBindWorldMatrix((float*)pOutMatrix, pConvNode);
 }
 __FBXM_MAKE_FUNC(void, FBXTransformCoord, void* pOutVec3, const void* pVec3, const void* pMatrix){
     auto xmm4_srt = DirectX::XMLoadFloat4x4((const DirectX::XMFLOAT4X4*)pMatrix);
@@ -128,81 +53,52 @@ __FBXM_MAKE_FUNC(void, FBXComputeAnimationLocalTransform, void* pOutScale, void*
     Float4* pConvOutRotation = reinterpret_cast<decltype(pConvOutRotation)>(pOutRotation);
     Float3* pConvOutTranslation = reinterpret_cast<decltype(pConvOutTranslation)>(pOutTranslation);
 
-    FbxAMatrix matRef;
-    CopyArrayData<pConvAnimationNode->BindNode->TransformMatrix.Length>((double*)matRef, pConvAnimationNode->BindNode->TransformMatrix.Values);
+    ComputeLocalTransformByTime(pConvOutScale, pConvOutRotation, pConvOutTranslation, pConvAnimationNode, nullptr, time);
+}
+__FBXM_MAKE_FUNC(void, FBXComputeAnimationLocalTransformWithCursor, void* pOutScale, void* pOutRotation, void* pOutTranslation, void* pCursor, const void* pAnimationNode, float time){
+    const auto* pConvAnimationNode = reinterpret_cast<const FBXAnimationNode*>(pAnimationNode);
 
-    if(!pConvAnimationNode->ScalingKeys.Length){
-        auto vValue = matRef.GetS();
-        CopyArrayData(pConvOutScale->raw, vValue.mData);
-    }
-    else{
-        auto fTime = std::min(time, pConvAnimationNode->ScalingKeys.Values[pConvAnimationNode->ScalingKeys.Length - 1].Time);
-        ins_computeLocalByTime(pConvOutScale->raw, fTime, &pConvAnimationNode->ScalingKeys);
-    }
+    Float3* pConvOutScale = reinterpret_cast<decltype(pConvOutScale)>(pOutScale);
+    Float4* pConvOutRotation = reinterpret_cast<decltype(pConvOutRotation)>(pOutRotation);
+    Float3* pConvOutTranslation = reinterpret_cast<decltype(pConvOutTranslation)>(pOutTranslation);
 
-    if(!pConvAnimationNode->RotationKeys.Length){
-        auto vValue = matRef.GetQ();
-        CopyArrayData(pConvOutRotation->raw, vValue.mData);
-    }
-    else{
-        auto fTime = std::min(time, pConvAnimationNode->RotationKeys.Values[pConvAnimationNode->RotationKeys.Length - 1].Time);
-        ins_computeLocalByTime(pConvOutRotation->raw, fTime, &pConvAnimationNode->RotationKeys);
-    }
+    auto* pConvCursor = reinterpret_cast<FBXAnimationCursor*>(pCursor);
 
-    if(!pConvAnimationNode->TranslationKeys.Length){
-        auto vValue = matRef.GetT();
-        CopyArrayData(pConvOutTranslation->raw, vValue.mData);
-    }
-    else{
-        auto fTime = std::min(time, pConvAnimationNode->TranslationKeys.Values[pConvAnimationNode->TranslationKeys.Length - 1].Time);
-        ins_computeLocalByTime(pConvOutTranslation->raw, fTime, &pConvAnimationNode->TranslationKeys);
-    }
+    ComputeLocalTransformByTime(pConvOutScale, pConvOutRotation, pConvOutTranslation, pConvAnimationNode, pConvCursor, time);
 }
 __FBXM_MAKE_FUNC(void, FBXComputeAnimationWorldTransform, void* pOutScale, void* pOutRotation, void* pOutTranslation, const void* pAnimationNode, float time){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXComputeAnimationWorldTransform(void*, void*, void*, const void*, float)");
+
+
     const auto* pConvAnimationNode = reinterpret_cast<const FBXAnimationNode*>(pAnimationNode);
+    if(!pConvAnimationNode->HasWorldKeys){
+        SHRPushErrorMessage(FBX_TEXT("world keys are not filled. FBXBuildAnimationWorldKeys must be called on the animation first"), __name_of_this_func);
+        return;
+    }
 
     Float3* pConvOutScale = reinterpret_cast<decltype(pConvOutScale)>(pOutScale);
     Float4* pConvOutRotation = reinterpret_cast<decltype(pConvOutRotation)>(pOutRotation);
     Float3* pConvOutTranslation = reinterpret_cast<decltype(pConvOutTranslation)>(pOutTranslation);
 
-    FbxAMatrix matRef;
-    {
-        auto xmm4_ret = DirectX::XMLoadFloat4x4((const DirectX::XMFLOAT4X4*)pConvAnimationNode->BindNode->TransformMatrix.Values);
-        for(auto* pNode = pConvAnimationNode->BindNode->Parent; pNode; pNode = pNode->Parent){
-            auto xmm4_tmp = DirectX::XMLoadFloat4x4((const DirectX::XMFLOAT4X4*)pNode->TransformMatrix.Values);
-            xmm4_ret = DirectX::XMMatrixMultiply(xmm4_ret, xmm4_tmp);
-        }
-        DirectX::XMFLOAT4X4A matFlt;
-        DirectX::XMStoreFloat4x4A(&matFlt, xmm4_ret);
-        CopyArrayData<pConvAnimationNode->BindNode->TransformMatrix.Length>((double*)matRef, (float*)&matFlt);
-    }
+    ComputeWorldTransformByTime(pConvOutScale, pConvOutRotation, pConvOutTranslation, pConvAnimationNode, nullptr, time);
+}
+__FBXM_MAKE_FUNC(void, FBXComputeAnimationWorldTransformWithCursor, void* pOutScale, void* pOutRotation, void* pOutTranslation, void* pCursor, const void* pAnimationNode, float time){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXComputeAnimationWorldTransformWithCursor(void*, void*, void*, void*, const void*, float)");
 
-    if(!pConvAnimationNode->ScalingKeys.Length){
-        auto vValue = matRef.GetS();
-        CopyArrayData(pConvOutScale->raw, vValue.mData);
-    }
-    else{
-        auto fTime = std::min(time, pConvAnimationNode->ScalingKeys.Values[pConvAnimationNode->ScalingKeys.Length - 1].Time);
-        ins_computeWorldByTime(pConvOutScale->raw, fTime, &pConvAnimationNode->ScalingKeys);
-    }
 
-    if(!pConvAnimationNode->RotationKeys.Length){
-        auto vValue = matRef.GetQ();
-        CopyArrayData(pConvOutRotation->raw, vValue.mData);
-    }
-    else{
-        auto fTime = std::min(time, pConvAnimationNode->RotationKeys.Values[pConvAnimationNode->RotationKeys.Length - 1].Time);
-        ins_computeWorldByTime(pConvOutRotation->raw, fTime, &pConvAnimationNode->RotationKeys);
+    const auto* pConvAnimationNode = reinterpret_cast<const FBXAnimationNode*>(pAnimationNode);
+    if(!pConvAnimationNode->HasWorldKeys){
+        SHRPushErrorMessage(FBX_TEXT("world keys are not filled. FBXBuildAnimationWorldKeys must be called on the animation first"), __name_of_this_func);
+        return;
     }
 
-    if(!pConvAnimationNode->TranslationKeys.Length){
-        auto vValue = matRef.GetT();
-        CopyArrayData(pConvOutTranslation->raw, vValue.mData);
-    }
-    else{
-        auto fTime = std::min(time, pConvAnimationNode->TranslationKeys.Values[pConvAnimationNode->TranslationKeys.Length - 1].Time);
-        ins_computeWorldByTime(pConvOutTranslation->raw, fTime, &pConvAnimationNode->TranslationKeys);
-    }
+    Float3* pConvOutScale = reinterpret_cast<decltype(pConvOutScale)>(pOutScale);
+    Float4* pConvOutRotation = reinterpret_cast<decltype(pConvOutRotation)>(pOutRotation);
+    Float3* pConvOutTranslation = reinterpret_cast<decltype(pConvOutTranslation)>(pOutTranslation);
+
+    auto* pConvCursor = reinterpret_cast<FBXAnimationCursor*>(pCursor);
+
+    ComputeWorldTransformByTime(pConvOutScale, pConvOutRotation, pConvOutTranslation, pConvAnimationNode, pConvCursor, time);
 }
 
 __FBXM_MAKE_FUNC(void, FBXComputeAnimationLocalScale, void* pOutScale, const void* pAnimationNode, float time){
@@ -223,26 +119,23 @@ __FBXM_MAKE_FUNC(void, FBXComputeAnimationLocalScale, void* pOutScale, const voi
             pConvAnimationNode->ScalingKeys.Values[0].Time,
             pConvAnimationNode->ScalingKeys.Values[pConvAnimationNode->ScalingKeys.Length - 1].Time
         );
-        ins_computeLocalByTime(pConvOutScale->raw, fTime, &pConvAnimationNode->ScalingKeys);
+        ComputeLocalKeyByTime(pConvOutScale->raw, fTime, &pConvAnimationNode->ScalingKeys, &pConvAnimationNode->ScalingTangents);
     }
 }
 __FBXM_MAKE_FUNC(void, FBXComputeAnimationWorldScale, void* pOutScale, const void* pAnimationNode, float time){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXComputeAnimationWorldScale(void*, const void*, float)");
+
+
     const auto* pConvAnimationNode = reinterpret_cast<const FBXAnimationNode*>(pAnimationNode);
+    if(!pConvAnimationNode->HasWorldKeys){
+        SHRPushErrorMessage(FBX_TEXT("world keys are not filled. FBXBuildAnimationWorldKeys must be called on the animation first"), __name_of_this_func);
+        return;
+    }
 
     Float3* pConvOutScale = reinterpret_cast<decltype(pConvOutScale)>(pOutScale);
 
     if(!pConvAnimationNode->ScalingKeys.Length){
-        FbxAMatrix matRef;
-        {
-            auto xmm4_ret = DirectX::XMLoadFloat4x4((const DirectX::XMFLOAT4X4*)pConvAnimationNode->BindNode->TransformMatrix.Values);
-            for(auto* pNode = pConvAnimationNode->BindNode->Parent; pNode; pNode = pNode->Parent){
-                auto xmm4_tmp = DirectX::XMLoadFloat4x4((const DirectX::XMFLOAT4X4*)pNode->TransformMatrix.Values);
-                xmm4_ret = DirectX::XMMatrixMultiply(xmm4_ret, xmm4_tmp);
-            }
-            DirectX::XMFLOAT4X4A matFlt;
-            DirectX::XMStoreFloat4x4A(&matFlt, xmm4_ret);
-            CopyArrayData<pConvAnimationNode->BindNode->TransformMatrix.Length>((double*)matRef, (float*)&matFlt);
-        }
+        const auto matRef = GetBindWorldTransform(pConvAnimationNode->BindNode);
 
         auto vValue = matRef.GetS();
         CopyArrayData(pConvOutScale->raw, vValue.mData);
@@ -253,7 +146,7 @@ __FBXM_MAKE_FUNC(void, FBXComputeAnimationWorldScale, void* pOutScale, const voi
             pConvAnimationNode->ScalingKeys.Values[0].Time,
             pConvAnimationNode->ScalingKeys.Values[pConvAnimationNode->ScalingKeys.Length - 1].Time
         );
-        ins_computeWorldByTime(pConvOutScale->raw, fTime, &pConvAnimationNode->ScalingKeys);
+        ComputeWorldKeyByTime(pConvOutScale->raw, fTime, &pConvAnimationNode->ScalingKeys, &pConvAnimationNode->ScalingTangents);
     }
 }
 
@@ -275,26 +168,23 @@ __FBXM_MAKE_FUNC(void, FBXComputeAnimationLocalRotation, void* pOutRotation, con
             pConvAnimationNode->RotationKeys.Values[0].Time,
             pConvAnimationNode->RotationKeys.Values[pConvAnimationNode->RotationKeys.Length - 1].Time
         );
-        ins_computeLocalByTime(pConvOutRotation->raw, fTime, &pConvAnimationNode->RotationKeys);
+        ComputeLocalKeyByTime(pConvOutRotation->raw, fTime, &pConvAnimationNode->RotationKeys, &pConvAnimationNode->RotationTangents);
     }
 }
 __FBXM_MAKE_FUNC(void, FBXComputeAnimationWorldRotation, void* pOutRotation, const void* pAnimationNode, float time){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXComputeAnimationWorldRotation(void*, const void*, float)");
+
+
     const auto* pConvAnimationNode = reinterpret_cast<const FBXAnimationNode*>(pAnimationNode);
+    if(!pConvAnimationNode->HasWorldKeys){
+        SHRPushErrorMessage(FBX_TEXT("world keys are not filled. FBXBuildAnimationWorldKeys must be called on the animation first"), __name_of_this_func);
+        return;
+    }
 
     Float4* pConvOutRotation = reinterpret_cast<decltype(pConvOutRotation)>(pOutRotation);
 
     if(!pConvAnimationNode->RotationKeys.Length){
-        FbxAMatrix matRef;
-        {
-            auto xmm4_ret = DirectX::XMLoadFloat4x4((const DirectX::XMFLOAT4X4*)pConvAnimationNode->BindNode->TransformMatrix.Values);
-            for(auto* pNode = pConvAnimationNode->BindNode->Parent; pNode; pNode = pNode->Parent){
-                auto xmm4_tmp = DirectX::XMLoadFloat4x4((const DirectX::XMFLOAT4X4*)pNode->TransformMatrix.Values);
-                xmm4_ret = DirectX::XMMatrixMultiply(xmm4_ret, xmm4_tmp);
-            }
-            DirectX::XMFLOAT4X4A matFlt;
-            DirectX::XMStoreFloat4x4A(&matFlt, xmm4_ret);
-            CopyArrayData<pConvAnimationNode->BindNode->TransformMatrix.Length>((double*)matRef, (float*)&matFlt);
-        }
+        const auto matRef = GetBindWorldTransform(pConvAnimationNode->BindNode);
 
         auto vValue = matRef.GetQ();
         CopyArrayData(pConvOutRotation->raw, vValue.mData);
@@ -305,7 +195,7 @@ __FBXM_MAKE_FUNC(void, FBXComputeAnimationWorldRotation, void* pOutRotation, con
             pConvAnimationNode->RotationKeys.Values[0].Time,
             pConvAnimationNode->RotationKeys.Values[pConvAnimationNode->RotationKeys.Length - 1].Time
         );
-        ins_computeWorldByTime(pConvOutRotation->raw, fTime, &pConvAnimationNode->RotationKeys);
+        ComputeWorldKeyByTime(pConvOutRotation->raw, fTime, &pConvAnimationNode->RotationKeys, &pConvAnimationNode->RotationTangents);
     }
 }
 
@@ -327,26 +217,23 @@ __FBXM_MAKE_FUNC(void, FBXComputeAnimationLocalTranslation, void* pOutTranslatio
             pConvAnimationNode->TranslationKeys.Values[0].Time,
             pConvAnimationNode->TranslationKeys.Values[pConvAnimationNode->TranslationKeys.Length - 1].Time
         );
-        ins_computeLocalByTime(pConvOutTranslation->raw, fTime, &pConvAnimationNode->TranslationKeys);
+        ComputeLocalKeyByTime(pConvOutTranslation->raw, fTime, &pConvAnimationNode->TranslationKeys, &pConvAnimationNode->TranslationTangents);
     }
 }
 __FBXM_MAKE_FUNC(void, FBXComputeAnimationWorldTranslation, void* pOutTranslation, const void* pAnimationNode, float time){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXComputeAnimationWorldTranslation(void*, const void*, float)");
+
+
     const auto* pConvAnimationNode = reinterpret_cast<const FBXAnimationNode*>(pAnimationNode);
+    if(!pConvAnimationNode->HasWorldKeys){
+        SHRPushErrorMessage(FBX_TEXT("world keys are not filled. FBXBuildAnimationWorldKeys must be called on the animation first"), __name_of_this_func);
+        return;
+    }
 
     Float3* pConvOutTranslation = reinterpret_cast<decltype(pConvOutTranslation)>(pOutTranslation);
 
     if(!pConvAnimationNode->TranslationKeys.Length){
-        FbxAMatrix matRef;
-        {
-            auto xmm4_ret = DirectX::XMLoadFloat4x4((const DirectX::XMFLOAT4X4*)pConvAnimationNode->BindNode->TransformMatrix.Values);
-            for(auto* pNode = pConvAnimationNode->BindNode->Parent; pNode; pNode = pNode->Parent){
-                auto xmm4_tmp = DirectX::XMLoadFloat4x4((const DirectX::XMFLOAT4X4*)pNode->TransformMatrix.Values);
-                xmm4_ret = DirectX::XMMatrixMultiply(xmm4_ret, xmm4_tmp);
-            }
-            DirectX::XMFLOAT4X4A matFlt;
-            DirectX::XMStoreFloat4x4A(&matFlt, xmm4_ret);
-            CopyArrayData<pConvAnimationNode->BindNode->TransformMatrix.Length>((double*)matRef, (float*)&matFlt);
-        }
+        const auto matRef = GetBindWorldTransform(pConvAnimationNode->BindNode);
 
         auto vValue = matRef.GetT();
         CopyArrayData(pConvOutTranslation->raw, vValue.mData);
@@ -357,6 +244,537 @@ __FBXM_MAKE_FUNC(void, FBXComputeAnimationWorldTranslation, void* pOutTranslatio
             pConvAnimationNode->TranslationKeys.Values[0].Time,
             pConvAnimationNode->TranslationKeys.Values[pConvAnimationNode->TranslationKeys.Length - 1].Time
             );
-        ins_computeWorldByTime(pConvOutTranslation->raw, fTime, &pConvAnimationNode->TranslationKeys);
+        ComputeWorldKeyByTime(pConvOutTranslation->raw, fTime, &pConvAnimationNode->TranslationKeys, &pConvAnimationNode->TranslationTangents);
+    }
+}
+
+
+static inline bool ins_isValidPose(const FBXAnimationPose* pPose){
+    if(!pPose)
+        return false;
+
+    for(const auto* pPlane : pPose->Scaling){
+        if(!pPlane)
+            return false;
+    }
+    for(const auto* pPlane : pPose->Rotation){
+        if(!pPlane)
+            return false;
+    }
+    for(const auto* pPlane : pPose->Translation){
+        if(!pPlane)
+            return false;
+    }
+    return true;
+}
+
+__FBXM_MAKE_FUNC(bool, FBXComputeAnimationLocalPose, const void* pOutPose, void* pCursors, const void* pAnimation, float time){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXComputeAnimationLocalPose(const void*, void*, const void*, float)");
+
+
+    const auto* pConvAnimation = reinterpret_cast<const FBXAnimation*>(pAnimation);
+    if(!pConvAnimation || (pConvAnimation->getID() != FBXType::FBXType_Animation)){
+        SHRPushErrorMessage(FBX_TEXT("pAnimation must be FBXAnimation"), __name_of_this_func);
+        return false;
+    }
+
+    const auto* pConvOutPose = reinterpret_cast<const FBXAnimationPose*>(pOutPose);
+    if(!ins_isValidPose(pConvOutPose)){
+        SHRPushErrorMessage(FBX_TEXT("pOutPose must not be null, nor any of its planes"), __name_of_this_func);
+        return false;
+    }
+
+    auto* pConvCursors = reinterpret_cast<FBXAnimationCursor*>(pCursors);
+
+    SHRSampleAnimationPose(pConvAnimation, time, false, pConvCursors, *pConvOutPose);
+    return true;
+}
+__FBXM_MAKE_FUNC(bool, FBXComputeAnimationWorldPose, const void* pOutPose, void* pCursors, const void* pAnimation, float time){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXComputeAnimationWorldPose(const void*, void*, const void*, float)");
+
+
+    const auto* pConvAnimation = reinterpret_cast<const FBXAnimation*>(pAnimation);
+    if(!pConvAnimation || (pConvAnimation->getID() != FBXType::FBXType_Animation)){
+        SHRPushErrorMessage(FBX_TEXT("pAnimation must be FBXAnimation"), __name_of_this_func);
+        return false;
+    }
+    if(!pConvAnimation->HasWorldKeys){
+        SHRPushErrorMessage(FBX_TEXT("world keys of pAnimation are not filled. FBXBuildAnimationWorldKeys must be called first"), __name_of_this_func);
+        return false;
+    }
+
+    const auto* pConvOutPose = reinterpret_cast<const FBXAnimationPose*>(pOutPose);
+    if(!ins_isValidPose(pConvOutPose)){
+        SHRPushErrorMessage(FBX_TEXT("pOutPose must not be null, nor any of its planes"), __name_of_this_func);
+        return false;
+    }
+
+    auto* pConvCursors = reinterpret_cast<FBXAnimationCursor*>(pCursors);
+
+    SHRSampleAnimationPose(pConvAnimation, time, true, pConvCursors, *pConvOutPose);
+    return true;
+}
+
+
+__FBXM_MAKE_FUNC(bool, FBXComputeSkinning, void* pOutPositions, void* pOutNormals, const void* pSkinnedMesh, const void* pBoneMatrices, unsigned long mode){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXComputeSkinning(void*, void*, const void*, const void*, unsigned long)");
+
+
+    const auto* pConvSkinnedMesh = reinterpret_cast<const FBXSkinnedMesh*>(pSkinnedMesh);
+    if(!pConvSkinnedMesh || (pConvSkinnedMesh->getID() != FBXType::FBXType_SkinnedMesh)){
+        SHRPushErrorMessage(FBX_TEXT("pSkinnedMesh must be FBXSkinnedMesh"), __name_of_this_func);
+        return false;
+    }
+    if(!pOutPositions || (pConvSkinnedMesh->SkinDeforms.Length && !pBoneMatrices)){
+        SHRPushErrorMessage(FBX_TEXT("pOutPositions and pBoneMatrices must not be null"), __name_of_this_func);
+        return false;
+    }
+
+    const auto eMode = (FBXSkinningMode)mode;
+    switch(eMode){
+    case FBXSkinningMode::FBXSkinningMode_LinearBlend:
+    case FBXSkinningMode::FBXSkinningMode_DualQuaternion:
+        break;
+
+    default:
+        SHRPushErrorMessage(FBX_TEXT("unknown skinning mode"), __name_of_this_func);
+        return false;
+    }
+
+    return SHRComputeSkinning(
+        pConvSkinnedMesh,
+        reinterpret_cast<const FBXStaticArray<float, 16>*>(pBoneMatrices),
+        eMode,
+        reinterpret_cast<FBXStaticArray<float, 3>*>(pOutPositions),
+        reinterpret_cast<FBXStaticArray<float, 3>*>(pOutNormals)
+        );
+}
+
+__FBXM_MAKE_FUNC(bool, FBXExtractRootMotion, void* pOutRootMotion, void* pAnimation, const void* pRootNode, unsigned long flags){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXExtractRootMotion(void*, void*, const void*, unsigned long)");
+
+
+    auto* pConvAnimation = reinterpret_cast<FBXAnimation*>(pAnimation);
+    if(!pConvAnimation || (pConvAnimation->getID() != FBXType::FBXType_Animation)){
+        SHRPushErrorMessage(FBX_TEXT("pAnimation must be FBXAnimation"), __name_of_this_func);
+        return false;
+    }
+    if(!pOutRootMotion || !pRootNode){
+        SHRPushErrorMessage(FBX_TEXT("pOutRootMotion and pRootNode must not be null"), __name_of_this_func);
+        return false;
     }
+
+    const auto translationFlags = flags & (unsigned long)FBXRootMotionFlag::FBXRootMotionFlag_Translation_Mask;
+    const auto yawFlags = flags & (unsigned long)FBXRootMotionFlag::FBXRootMotionFlag_Yaw_Mask;
+    if(!translationFlags && !yawFlags){
+        SHRPushErrorMessage(FBX_TEXT("flags must contain at least one component to extract"), __name_of_this_func);
+        return false;
+    }
+    if(yawFlags & (yawFlags - 1)){
+        SHRPushErrorMessage(FBX_TEXT("only one yaw axis can be set"), __name_of_this_func);
+        return false;
+    }
+
+    return SHRExtractRootMotion(
+        pConvAnimation,
+        reinterpret_cast<const FBXNode*>(pRootNode),
+        (FBXRootMotionFlag)flags,
+        reinterpret_cast<FBXAnimationNode*>(pOutRootMotion)
+        );
+}
+
+__FBXM_MAKE_FUNC(bool, FBXMakeAdditiveAnimation, void* pOutAnimation, const void* pAnimation, const void* pReferenceAnimation, float referenceTime){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXMakeAdditiveAnimation(void*, const void*, const void*, float)");
+
+
+    auto* pConvOutAnimation = reinterpret_cast<FBXAnimation*>(pOutAnimation);
+    const auto* pConvAnimation = reinterpret_cast<const FBXAnimation*>(pAnimation);
+    const auto* pConvReferenceAnimation = reinterpret_cast<const FBXAnimation*>(pReferenceAnimation);
+    if(!pConvOutAnimation || !pConvAnimation){
+        SHRPushErrorMessage(FBX_TEXT("pOutAnimation and pAnimation must not be null"), __name_of_this_func);
+        return false;
+    }
+    if((pConvAnimation->getID() != FBXType::FBXType_Animation) || (pConvReferenceAnimation && (pConvReferenceAnimation->getID() != FBXType::FBXType_Animation))){
+        SHRPushErrorMessage(FBX_TEXT("pAnimation and pReferenceAnimation must be FBXAnimation"), __name_of_this_func);
+        return false;
+    }
+    if(pConvAnimation->HasWorldKeys && pConvReferenceAnimation && !pConvReferenceAnimation->HasWorldKeys){
+        SHRPushErrorMessage(FBX_TEXT("world keys of pReferenceAnimation are not filled while those of pAnimation are. FBXBuildAnimationWorldKeys must be called first"), __name_of_this_func);
+        return false;
+    }
+
+    SHRMakeAdditiveAnimation(pConvOutAnimation, pConvAnimation, pConvReferenceAnimation, referenceTime);
+    return true;
+}
+
+__FBXM_MAKE_FUNC(bool, FBXReduceAnimationKeys, void* pAnimation, float scalingTolerance, float rotationTolerance, float translationTolerance){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXReduceAnimationKeys(void*, float, float, float)");
+
+
+    auto* pConvAnimation = reinterpret_cast<FBXAnimation*>(pAnimation);
+    if(!pConvAnimation || (pConvAnimation->getID() != FBXType::FBXType_Animation)){
+        SHRPushErrorMessage(FBX_TEXT("pAnimation must be FBXAnimation"), __name_of_this_func);
+        return false;
+    }
+    if((scalingTolerance < 0.f) || (rotationTolerance < 0.f) || (translationTolerance < 0.f)){
+        SHRPushErrorMessage(FBX_TEXT("tolerances must not be negative"), __name_of_this_func);
+        return false;
+    }
+
+    SHRReduceAnimationKeys(pConvAnimation, scalingTolerance, rotationTolerance, translationTolerance);
+    return true;
+}
+
+__FBXM_MAKE_FUNC(bool, FBXCompressAnimation, void* pOutCompressedAnimation, const void* pAnimation, float scalingTolerance, float rotationTolerance, float translationTolerance, bool bWorld){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXCompressAnimation(void*, const void*, float, float, float, bool)");
+
+
+    auto* pConvOutCompressedAnimation = reinterpret_cast<FBXCompressedAnimation*>(pOutCompressedAnimation);
+    if(!pConvOutCompressedAnimation || (pConvOutCompressedAnimation->getID() != FBXType::FBXType_CompressedAnimation)){
+        SHRPushErrorMessage(FBX_TEXT("pOutCompressedAnimation must be FBXCompressedAnimation"), __name_of_this_func);
+        return false;
+    }
+
+    const auto* pConvAnimation = reinterpret_cast<const FBXAnimation*>(pAnimation);
+    if(!pConvAnimation || (pConvAnimation->getID() != FBXType::FBXType_Animation)){
+        SHRPushErrorMessage(FBX_TEXT("pAnimation must be FBXAnimation"), __name_of_this_func);
+        return false;
+    }
+    if((scalingTolerance < 0.f) || (rotationTolerance < 0.f) || (translationTolerance < 0.f)){
+        SHRPushErrorMessage(FBX_TEXT("tolerances must not be negative"), __name_of_this_func);
+        return false;
+    }
+
+    if(bWorld && !pConvAnimation->HasWorldKeys){
+        SHRPushErrorMessage(FBX_TEXT("world keys of pAnimation are not filled. FBXBuildAnimationWorldKeys must be called first"), __name_of_this_func);
+        return false;
+    }
+
+    SHRCompressAnimation(pConvAnimation, scalingTolerance, rotationTolerance, translationTolerance, bWorld, pConvOutCompressedAnimation);
+    return true;
+}
+
+__FBXM_MAKE_FUNC(bool, FBXDecompressAnimationPose, const void* pOutPose, void* pCursors, const void* pCompressedAnimation, float time){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXDecompressAnimationPose(const void*, void*, const void*, float)");
+
+
+    const auto* pConvCompressedAnimation = reinterpret_cast<const FBXCompressedAnimation*>(pCompressedAnimation);
+    if(!pConvCompressedAnimation || (pConvCompressedAnimation->getID() != FBXType::FBXType_CompressedAnimation)){
+        SHRPushErrorMessage(FBX_TEXT("pCompressedAnimation must be FBXCompressedAnimation"), __name_of_this_func);
+        return false;
+    }
+    if(!pConvCompressedAnimation->Data.Values){
+        SHRPushErrorMessage(FBX_TEXT("pCompressedAnimation must be made by FBXCompressAnimation"), __name_of_this_func);
+        return false;
+    }
+
+    const auto* pConvOutPose = reinterpret_cast<const FBXAnimationPose*>(pOutPose);
+    if(!ins_isValidPose(pConvOutPose)){
+        SHRPushErrorMessage(FBX_TEXT("pOutPose must not be null, nor any of its planes"), __name_of_this_func);
+        return false;
+    }
+
+    auto* pConvCursors = reinterpret_cast<FBXAnimationCursor*>(pCursors);
+
+    SHRDecompressAnimationPose(pConvCompressedAnimation, time, pConvCursors, *pConvOutPose);
+    return true;
+}
+
+__FBXM_MAKE_FUNC(bool, FBXResampleAnimation, void* pAnimation, float sampleRate){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXResampleAnimation(void*, float)");
+
+
+    auto* pConvAnimation = reinterpret_cast<FBXAnimation*>(pAnimation);
+    if(!pConvAnimation || (pConvAnimation->getID() != FBXType::FBXType_Animation)){
+        SHRPushErrorMessage(FBX_TEXT("pAnimation must be FBXAnimation"), __name_of_this_func);
+        return false;
+    }
+    if(sampleRate < 0.f){
+        SHRPushErrorMessage(FBX_TEXT("sampleRate must not be negative"), __name_of_this_func);
+        return false;
+    }
+
+    SHRResampleAnimation(pConvAnimation, sampleRate);
+    return true;
+}
+
+__FBXM_MAKE_FUNC(bool, FBXBuildAnimationWorldKeys, void* pAnimation){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXBuildAnimationWorldKeys(void*)");
+
+
+    auto* pConvAnimation = reinterpret_cast<FBXAnimation*>(pAnimation);
+    if(!pConvAnimation || (pConvAnimation->getID() != FBXType::FBXType_Animation)){
+        SHRPushErrorMessage(FBX_TEXT("pAnimation must be FBXAnimation"), __name_of_this_func);
+        return false;
+    }
+
+    SHRBuildAnimationWorldKeys(pConvAnimation);
+    return true;
+}
+
+__FBXM_MAKE_FUNC(bool, FBXNormalizeAnimationRotations, void* pAnimation, float duplicateTolerance){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXNormalizeAnimationRotations(void*, float)");
+
+
+    auto* pConvAnimation = reinterpret_cast<FBXAnimation*>(pAnimation);
+    if(!pConvAnimation || (pConvAnimation->getID() != FBXType::FBXType_Animation)){
+        SHRPushErrorMessage(FBX_TEXT("pAnimation must be FBXAnimation"), __name_of_this_func);
+        return false;
+    }
+    if(duplicateTolerance < 0.f){
+        SHRPushErrorMessage(FBX_TEXT("duplicateTolerance must not be negative"), __name_of_this_func);
+        return false;
+    }
+
+    SHRNormalizeAnimationRotations(pConvAnimation, duplicateTolerance);
+    return true;
+}
+
+__FBXM_MAKE_FUNC(bool, FBXCompressStreamingAnimation, void* pOutStreamingAnimation, const void* pAnimation, float blockDuration, float scalingTolerance, float rotationTolerance, float translationTolerance, bool bWorld){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXCompressStreamingAnimation(void*, const void*, float, float, float, float, bool)");
+
+
+    auto* pConvOutStreamingAnimation = reinterpret_cast<FBXStreamingAnimation*>(pOutStreamingAnimation);
+    if(!pConvOutStreamingAnimation || (pConvOutStreamingAnimation->getID() != FBXType::FBXType_StreamingAnimation)){
+        SHRPushErrorMessage(FBX_TEXT("pOutStreamingAnimation must be FBXStreamingAnimation"), __name_of_this_func);
+        return false;
+    }
+
+    const auto* pConvAnimation = reinterpret_cast<const FBXAnimation*>(pAnimation);
+    if(!pConvAnimation || (pConvAnimation->getID() != FBXType::FBXType_Animation)){
+        SHRPushErrorMessage(FBX_TEXT("pAnimation must be FBXAnimation"), __name_of_this_func);
+        return false;
+    }
+    if(!(blockDuration > 0.f)){
+        SHRPushErrorMessage(FBX_TEXT("blockDuration must be positive"), __name_of_this_func);
+        return false;
+    }
+    if((scalingTolerance < 0.f) || (rotationTolerance < 0.f) || (translationTolerance < 0.f)){
+        SHRPushErrorMessage(FBX_TEXT("tolerances must not be negative"), __name_of_this_func);
+        return false;
+    }
+
+    if(bWorld && !pConvAnimation->HasWorldKeys){
+        SHRPushErrorMessage(FBX_TEXT("world keys of pAnimation are not filled. FBXBuildAnimationWorldKeys must be called first"), __name_of_this_func);
+        return false;
+    }
+
+    SHRCompressStreamingAnimation(pConvAnimation, blockDuration, scalingTolerance, rotationTolerance, translationTolerance, bWorld, pConvOutStreamingAnimation);
+    return true;
+}
+
+__FBXM_MAKE_FUNC(bool, FBXDecompressAnimationBlockPose, const void* pOutPose, void* pCursors, const void* pBlock, float time){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXDecompressAnimationBlockPose(const void*, void*, const void*, float)");
+
+
+    if(!pBlock || (reinterpret_cast<FBX_PTRDIFFU>(pBlock) & 7u)){
+        SHRPushErrorMessage(FBX_TEXT("pBlock must not be null, and must be 8 bytes aligned"), __name_of_this_func);
+        return false;
+    }
+
+    const auto* pConvOutPose = reinterpret_cast<const FBXAnimationPose*>(pOutPose);
+    if(!ins_isValidPose(pConvOutPose)){
+        SHRPushErrorMessage(FBX_TEXT("pOutPose must not be null, nor any of its planes"), __name_of_this_func);
+        return false;
+    }
+
+    auto* pConvCursors = reinterpret_cast<FBXAnimationCursor*>(pCursors);
+
+    SHRDecompressAnimationBlockPose(pBlock, time, pConvCursors, *pConvOutPose);
+    return true;
+}
+
+__FBXM_MAKE_FUNC(bool, FBXRetargetAnimations, void* pOutAnimations, const void* pAnimations, unsigned long animationCount, const void* pSourceRoot, const void* pTargetRoot, const FBX_CHAR** szSourceNames, const FBX_CHAR** szTargetNames, unsigned long mappingCount){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXRetargetAnimations(void*, const void*, unsigned long, const void*, const void*, const FBX_CHAR**, const FBX_CHAR**, unsigned long)");
+
+
+    auto* pConvOutAnimations = reinterpret_cast<FBXAnimation*>(pOutAnimations);
+    const auto* pConvAnimations = reinterpret_cast<const FBXAnimation*>(pAnimations);
+    if(!pConvOutAnimations || !pConvAnimations){
+        SHRPushErrorMessage(FBX_TEXT("pOutAnimations and pAnimations must not be null"), __name_of_this_func);
+        return false;
+    }
+    for(unsigned long idxAnimation = 0; idxAnimation < animationCount; ++idxAnimation){
+        if((pConvOutAnimations[idxAnimation].getID() != FBXType::FBXType_Animation) || (pConvAnimations[idxAnimation].getID() != FBXType::FBXType_Animation)){
+            SHRPushErrorMessage(FBX_TEXT("pOutAnimations and pAnimations must be arrays of FBXAnimation"), __name_of_this_func);
+            return false;
+        }
+    }
+
+    const auto* pConvSourceRoot = reinterpret_cast<const FBXRoot*>(pSourceRoot);
+    const auto* pConvTargetRoot = reinterpret_cast<const FBXRoot*>(pTargetRoot);
+    if(!pConvSourceRoot || (pConvSourceRoot->getID() != FBXType::FBXType_Root) || !pConvTargetRoot || (pConvTargetRoot->getID() != FBXType::FBXType_Root)){
+        SHRPushErrorMessage(FBX_TEXT("pSourceRoot and pTargetRoot must be FBXRoot"), __name_of_this_func);
+        return false;
+    }
+    if(!pConvSourceRoot->Nodes || !pConvTargetRoot->Nodes){
+        SHRPushErrorMessage(FBX_TEXT("pSourceRoot and pTargetRoot must have nodes"), __name_of_this_func);
+        return false;
+    }
+    if(mappingCount && (!szSourceNames || !szTargetNames)){
+        SHRPushErrorMessage(FBX_TEXT("szSourceNames and szTargetNames must not be null if mappingCount is not 0"), __name_of_this_func);
+        return false;
+    }
+
+    return SHRRetargetAnimations(pConvOutAnimations, pConvAnimations, animationCount, pConvSourceRoot->Nodes, pConvTargetRoot->Nodes, szSourceNames, szTargetNames, mappingCount);
+}
+
+__FBXM_MAKE_FUNC(bool, FBXSplitAnimation, void* pOutAnimations, const void* pAnimation, const float* pTimeRanges, unsigned long rangeCount){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXSplitAnimation(void*, const void*, const float*, unsigned long)");
+
+
+    auto* pConvOutAnimations = reinterpret_cast<FBXAnimation*>(pOutAnimations);
+    const auto* pConvAnimation = reinterpret_cast<const FBXAnimation*>(pAnimation);
+    if(!pConvOutAnimations || !pConvAnimation || (pConvAnimation->getID() != FBXType::FBXType_Animation)){
+        SHRPushErrorMessage(FBX_TEXT("pOutAnimations must not be null, and pAnimation must be FBXAnimation"), __name_of_this_func);
+        return false;
+    }
+    if(rangeCount && !pTimeRanges){
+        SHRPushErrorMessage(FBX_TEXT("pTimeRanges must not be null"), __name_of_this_func);
+        return false;
+    }
+    for(unsigned long idxRange = 0; idxRange < rangeCount; ++idxRange){
+        if(pConvOutAnimations[idxRange].getID() != FBXType::FBXType_Animation){
+            SHRPushErrorMessage(FBX_TEXT("pOutAnimations must be an array of FBXAnimation"), __name_of_this_func);
+            return false;
+        }
+        if(&pConvOutAnimations[idxRange] == pConvAnimation){
+            SHRPushErrorMessage(FBX_TEXT("pOutAnimations must not contain pAnimation"), __name_of_this_func);
+            return false;
+        }
+        if(!(pTimeRanges[idxRange << 1] <= pTimeRanges[(idxRange << 1) + 1])){
+            SHRPushErrorMessage(FBX_TEXT("start time of a range must not be greater than its end time"), __name_of_this_func);
+            return false;
+        }
+    }
+
+    SHRSplitAnimation(pConvOutAnimations, pConvAnimation, pTimeRanges, rangeCount);
+    return true;
+}
+
+__FBXM_MAKE_FUNC(bool, FBXBlendAnimationPoses, const void* pOutPose, const void* pPoses, const float* pWeights, const float* const* pMasks, unsigned long poseCount, unsigned long nodeCount){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXBlendAnimationPoses(const void*, const void*, const float*, const float* const*, unsigned long, unsigned long)");
+
+
+    const auto* pConvOutPose = reinterpret_cast<const FBXAnimationPose*>(pOutPose);
+    if(!ins_isValidPose(pConvOutPose)){
+        SHRPushErrorMessage(FBX_TEXT("pOutPose must not be null, nor any of its planes"), __name_of_this_func);
+        return false;
+    }
+
+    const auto* pConvPoses = reinterpret_cast<const FBXAnimationPose*>(pPoses);
+    if(poseCount && (!pConvPoses || !pWeights)){
+        SHRPushErrorMessage(FBX_TEXT("pPoses and pWeights must not be null if poseCount is not 0"), __name_of_this_func);
+        return false;
+    }
+    for(unsigned long idxPose = 0; idxPose < poseCount; ++idxPose){
+        if(!ins_isValidPose(&pConvPoses[idxPose])){
+            SHRPushErrorMessage(FBX_TEXT("planes of pPoses must not be null"), __name_of_this_func);
+            return false;
+        }
+    }
+
+    SHRBlendPoses(*pConvOutPose, pConvPoses, pWeights, pMasks, poseCount, nodeCount);
+    return true;
+}
+__FBXM_MAKE_FUNC(bool, FBXApplyAdditiveAnimationPose, const void* pOutPose, const void* pBasePose, const void* pAdditivePose, float weight, const float* pMask, unsigned long nodeCount){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXApplyAdditiveAnimationPose(const void*, const void*, const void*, float, const float*, unsigned long)");
+
+
+    const auto* pConvOutPose = reinterpret_cast<const FBXAnimationPose*>(pOutPose);
+    const auto* pConvBasePose = reinterpret_cast<const FBXAnimationPose*>(pBasePose);
+    const auto* pConvAdditivePose = reinterpret_cast<const FBXAnimationPose*>(pAdditivePose);
+    if(!ins_isValidPose(pConvOutPose) || !ins_isValidPose(pConvBasePose) || !ins_isValidPose(pConvAdditivePose)){
+        SHRPushErrorMessage(FBX_TEXT("pOutPose, pBasePose and pAdditivePose must not be null, nor any of their planes"), __name_of_this_func);
+        return false;
+    }
+
+    SHRApplyAdditivePose(*pConvOutPose, *pConvBasePose, *pConvAdditivePose, weight, pMask, nodeCount);
+    return true;
+}
+
+__FBXM_MAKE_FUNC(bool, FBXBuildAnimationPoseLinks, void* pOutLinks, const void* pAnimation){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXBuildAnimationPoseLinks(void*, const void*)");
+
+
+    auto* pConvOutLinks = reinterpret_cast<FBXAnimationPoseLink*>(pOutLinks);
+    const auto* pConvAnimation = reinterpret_cast<const FBXAnimation*>(pAnimation);
+    if(!pConvOutLinks || !pConvAnimation || (pConvAnimation->getID() != FBXType::FBXType_Animation)){
+        SHRPushErrorMessage(FBX_TEXT("pOutLinks must not be null, and pAnimation must be FBXAnimation"), __name_of_this_func);
+        return false;
+    }
+
+    SHRBuildAnimationPoseLinks(pConvAnimation, pConvOutLinks);
+    return true;
+}
+__FBXM_MAKE_FUNC(bool, FBXConvertAnimationPoseToWorld, const void* pOutPose, const void* pLocalPose, const void* pLinks, unsigned long nodeCount){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXConvertAnimationPoseToWorld(const void*, const void*, const void*, unsigned long)");
+
+
+    const auto* pConvOutPose = reinterpret_cast<const FBXAnimationPose*>(pOutPose);
+    const auto* pConvLocalPose = reinterpret_cast<const FBXAnimationPose*>(pLocalPose);
+    if(!ins_isValidPose(pConvOutPose) || !ins_isValidPose(pConvLocalPose)){
+        SHRPushErrorMessage(FBX_TEXT("pOutPose and pLocalPose must not be null, nor any of their planes"), __name_of_this_func);
+        return false;
+    }
+
+    const auto* pConvLinks = reinterpret_cast<const FBXAnimationPoseLink*>(pLinks);
+    if(nodeCount && !pConvLinks){
+        SHRPushErrorMessage(FBX_TEXT("pLinks must not be null if nodeCount is not 0"), __name_of_this_func);
+        return false;
+    }
+    for(unsigned long idxLink = 0; idxLink < nodeCount; ++idxLink){
+        const auto& kLink = pConvLinks[idxLink];
+        if((kLink.Node >= nodeCount) || (kLink.Parent > nodeCount)){
+            SHRPushErrorMessage(FBX_TEXT("pLinks must be made by FBXBuildAnimationPoseLinks of same nodeCount"), __name_of_this_func);
+            return false;
+        }
+    }
+
+    SHRConvertPoseToWorld(*pConvOutPose, *pConvLocalPose, pConvLinks, nodeCount);
+    return true;
+}
+
+__FBXM_MAKE_FUNC(bool, FBXCollectNodes, const void** pOutNodes, unsigned long* pNodeCount, const void* pRoot){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXCollectNodes(const void**, unsigned long*, const void*)");
+
+
+    const auto* pConvRoot = reinterpret_cast<const FBXRoot*>(pRoot);
+    if(!pNodeCount || !pConvRoot || (pConvRoot->getID() != FBXType::FBXType_Root)){
+        SHRPushErrorMessage(FBX_TEXT("pNodeCount must not be null, and pRoot must be FBXRoot"), __name_of_this_func);
+        return false;
+    }
+
+    (*pNodeCount) = SHRCollectNodes(pConvRoot->Nodes, reinterpret_cast<const FBXNode**>(pOutNodes));
+    return true;
+}
+
+template<typename T>
+static inline bool ins_bakeWorldMatrices(T* pOutMatrices, const void* pRoot, const void* pAnimation, float time, const FBX_CHAR* szFuncName){
+    const auto* pConvRoot = reinterpret_cast<const FBXRoot*>(pRoot);
+    if(!pOutMatrices || !pConvRoot || (pConvRoot->getID() != FBXType::FBXType_Root)){
+        SHRPushErrorMessage(FBX_TEXT("pOutMatrices must not be null, and pRoot must be FBXRoot"), szFuncName);
+        return false;
+    }
+
+    const auto* pConvAnimation = reinterpret_cast<const FBXAnimation*>(pAnimation);
+    if(pConvAnimation && (pConvAnimation->getID() != FBXType::FBXType_Animation)){
+        SHRPushErrorMessage(FBX_TEXT("pAnimation must be FBXAnimation"), szFuncName);
+        return false;
+    }
+
+    SHRBakeWorldMatrices(pOutMatrices, pConvRoot->Nodes, pConvAnimation, time);
+    return true;
+}
+__FBXM_MAKE_FUNC(bool, FBXBakeWorldMatrices, float* pOutMatrices, const void* pRoot, const void* pAnimation, float time){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXBakeWorldMatrices(float*, const void*, const void*, float)");
+
+
+    return ins_bakeWorldMatrices(pOutMatrices, pRoot, pAnimation, time, __name_of_this_func);
+}
+__FBXM_MAKE_FUNC(bool, FBXBakeWorldMatricesDouble, double* pOutMatrices, const void* pRoot, const void* pAnimation, float time){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("FBXBakeWorldMatricesDouble(double*, const void*, const void*, float)");
+
+
+    return ins_bakeWorldMatrices(pOutMatrices, pRoot, pAnimation, time, __name_of_this_func);
 }
@@ -119,6 +119,19 @@ struct MeshAttributeElement{
 using MeshAttribute = fbx_vector<MeshAttributeElement>;
 using BoneCombination = fbx_vector<fbxsdk::FbxCluster*>;
 
+struct BoneCombinationReport{
+    unsigned long GreedyCount; // attribute count the polygon order partitioning would make
+    unsigned long Count; // attribute count actually made
+};
+
+struct BoneBudgetData{
+    unsigned long maxBoneCount;
+
+    MeshAttribute bufMeshAttribute; // polygon range points bufPolygonOrder
+    UintContainer bufPolygonOrder; // the index points polygons of the main partition
+    fbx_vector<BoneCombination> bufBoneCombination;
+};
+
 // FBXShared_Node ////////////////////////////////////////////////////////////////////////////////////
 
 struct NodeData{
@@ -130,9 +143,11 @@ struct NodeData{
 
     MeshAttribute bufMeshAttribute;
     fbx_vector<BoneCombination> bufBoneCombination;
+    fbx_vector<BoneBudgetData> bufBoneBudgets;
 
     Vector3Container bufPositions;
     Uint3Container bufIndices;
+    UintContainer bufVertexOrder; // final vertex index to optimized vertex index. filled by SHRGenerateMeshAttribute
 
     fbx_vector<LayerElement> bufLayers;
 
@@ -172,6 +187,12 @@ public:
     FBXAnimationInterpolationType type;
     T local;
     T world;
+
+public:
+    T localInTangent;
+    T localOutTangent;
+    T worldInTangent;
+    T worldOutTangent;
 };
 template<typename T>
 using AnimationKeyFrames = fbx_vector<AnimationKeyFrame<T>>;
@@ -194,6 +215,24 @@ using NodeNameList = fbx_unordered_set<fbx_string, StringHasher<fbx_basic_string
 
 // FBXShared_Optimizer ///////////////////////////////////////////////////////////////////////////////
 
+// FBXShared_Instance ////////////////////////////////////////////////////////////////////////////////
+
+// FBXShared_Tangent /////////////////////////////////////////////////////////////////////////////////
+
+// FBXShared_Pose ////////////////////////////////////////////////////////////////////////////////////
+
+// FBXShared_Clip ////////////////////////////////////////////////////////////////////////////////////
+
+// tolerances of each animation node, after world space translation tolerance is brought down the hierarchy
+struct AnimationTolerance{
+    float scaling; // relative
+    float rotation; // radian
+    float localTranslation;
+    float worldTranslation;
+};
+
+// FBXShared_Compress ////////////////////////////////////////////////////////////////////////////////
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
@@ -234,6 +273,8 @@ extern MaterialTable shr_materialTable;
 
 // FBXShared_BoneCombination /////////////////////////////////////////////////////////////////////////
 
+extern BoneCombinationReport shr_boneCombinationReport;
+
 // FBXShared_Node ////////////////////////////////////////////////////////////////////////////////////
 
 extern FbxNodeToExportNode shr_fbxNodeToExportNode;
@@ -246,6 +287,16 @@ extern NodeNameList shr_tmpNodeNameList;
 
 // FBXShared_Optimizer ///////////////////////////////////////////////////////////////////////////////
 
+// FBXShared_Instance ////////////////////////////////////////////////////////////////////////////////
+
+// FBXShared_Tangent /////////////////////////////////////////////////////////////////////////////////
+
+// FBXShared_Pose ////////////////////////////////////////////////////////////////////////////////////
+
+// FBXShared_Clip ////////////////////////////////////////////////////////////////////////////////////
+
+// FBXShared_Compress ////////////////////////////////////////////////////////////////////////////////
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
@@ -270,6 +321,7 @@ extern void SHRPushWarningMessage(fbx_string&& strMessage, const FBX_CHAR* strCa
 extern void SHRRebindRoot(FBXRoot* dest, const FBXRoot* src);
 extern void SHRRebindNode(FBXNode* dest, const FBXNode* src);
 extern void SHRRebindAnimation(FBXAnimation& dest, const FBXAnimation& src);
+extern void SHRRebindMeshInstance(FBXMeshInstance& dest, const FBXMeshInstance& src);
 
 // FBXShared_FbxSdk //////////////////////////////////////////////////////////////////////////////////
 
@@ -306,9 +358,12 @@ extern bool SHRLoadSkinFromNode(const ControlPointRemap& controlPointRemap, fbxs
 
 extern bool SHRInitSkinData(fbxsdk::FbxManager* kSDKManager, PoseNodeList& poseNodeList, const ImportNodeToFbxNode& nodeBinder, const ControlPointMergeMap& ctrlPointMergeMap, const FBXSkinnedMesh* pNode, fbxsdk::FbxNode* kNode);
 
+extern bool SHRComputeSkinning(const FBXSkinnedMesh* pMesh, const FBXStaticArray<float, 16>* pBoneMatrices, FBXSkinningMode mode, FBXStaticArray<float, 3>* pOutPositions, FBXStaticArray<float, 3>* pOutNormals);
+
 // FBXShared_BoneCombination /////////////////////////////////////////////////////////////////////////
 
-extern void SHRGenerateMeshAttribute(NodeData* pNodeData);
+extern void SHRGenerateMeshAttribute(NodeData* pNodeData, size_t* pGreedyCount = nullptr);
+extern void SHRStoreBoneBudgets(const NodeData* pNodeData, FBXSkinnedMesh* pMesh);
 
 // FBXShared_Node ////////////////////////////////////////////////////////////////////////////////////
 
@@ -332,5 +387,46 @@ extern bool SHRStoreAnimations(fbxsdk::FbxManager* kSDKManager, fbxsdk::FbxScene
 // FBXShared_Optimizer ///////////////////////////////////////////////////////////////////////////////
 
 extern void SHROptimizeMesh(NodeData* pNodeData);
+extern size_t SHRGetOptimizedVertexCount();
+extern void SHRStoreOptimizedMesh(const NodeData* pNodeData, FBXMesh* pMesh);
+
+// FBXShared_Instance ////////////////////////////////////////////////////////////////////////////////
+
+extern void SHRGenerateMeshInstances(FBXNode* pRootNode, FBXDynamicArray<FBXMeshInstance>* pInstances);
+
+// FBXShared_Tangent /////////////////////////////////////////////////////////////////////////////////
+
+extern void SHRGenerateTangentSpace(FBXMesh* pMesh);
+
+// FBXShared_Pose ////////////////////////////////////////////////////////////////////////////////////
+
+extern void SHRSampleAnimationPose(const FBXAnimation* pAnimation, float time, bool bWorld, FBXAnimationCursor* pCursors, const FBXAnimationPose& pose);
+extern void SHRBlendPoses(const FBXAnimationPose& pose, const FBXAnimationPose* pPoses, const float* pWeights, const float* const* pMasks, unsigned long poseCount, unsigned long nodeCount);
+extern void SHRApplyAdditivePose(const FBXAnimationPose& pose, const FBXAnimationPose& basePose, const FBXAnimationPose& additivePose, float weight, const float* pMask, unsigned long nodeCount);
+extern void SHRBuildAnimationPoseLinks(const FBXAnimation* pAnimation, FBXAnimationPoseLink* pOutLinks);
+extern void SHRConvertPoseToWorld(const FBXAnimationPose& pose, const FBXAnimationPose& localPose, const FBXAnimationPoseLink* pLinks, unsigned long nodeCount);
+
+extern unsigned long SHRCollectNodes(const FBXNode* pRootNode, const FBXNode** pOutNodes);
+extern void SHRBakeWorldMatrices(float* pOutMatrices, const FBXNode* pRootNode, const FBXAnimation* pAnimation, float time);
+extern void SHRBakeWorldMatrices(double* pOutMatrices, const FBXNode* pRootNode, const FBXAnimation* pAnimation, float time);
+
+// FBXShared_Clip ////////////////////////////////////////////////////////////////////////////////////
+
+extern bool SHRExtractRootMotion(FBXAnimation* pAnimation, const FBXNode* pRootNode, FBXRootMotionFlag flags, FBXAnimationNode* pOutRootMotion);
+extern void SHRMakeAdditiveAnimation(FBXAnimation* pOutAnimation, const FBXAnimation* pAnimation, const FBXAnimation* pReference, float referenceTime);
+extern void SHRComputeAnimationTolerances(const FBXAnimation* pAnimation, float scalingTolerance, float rotationTolerance, float translationTolerance, AnimationTolerance* pOutTolerances);
+extern void SHRReduceAnimationKeys(FBXAnimation* pAnimation, float scalingTolerance, float rotationTolerance, float translationTolerance);
+extern void SHRResampleAnimation(FBXAnimation* pAnimation, float sampleRate);
+extern void SHRBuildAnimationWorldKeys(FBXAnimation* pAnimation);
+extern void SHRNormalizeAnimationRotations(FBXAnimation* pAnimation, float duplicateTolerance);
+extern bool SHRRetargetAnimations(FBXAnimation* pOutAnimations, const FBXAnimation* pAnimations, unsigned long animationCount, const FBXNode* pSourceNodes, const FBXNode* pTargetNodes, const FBX_CHAR* const* szSourceNames, const FBX_CHAR* const* szTargetNames, unsigned long mappingCount);
+extern void SHRSplitAnimation(FBXAnimation* pOutAnimations, const FBXAnimation* pAnimation, const float* pTimeRanges, unsigned long rangeCount);
+
+// FBXShared_Compress ////////////////////////////////////////////////////////////////////////////////
+
+extern void SHRCompressAnimation(const FBXAnimation* pAnimation, float scalingTolerance, float rotationTolerance, float translationTolerance, bool bWorld, FBXCompressedAnimation* pOutCompressed);
+extern void SHRDecompressAnimationPose(const FBXCompressedAnimation* pCompressed, float time, FBXAnimationCursor* pCursors, const FBXAnimationPose& pose);
+extern void SHRCompressStreamingAnimation(const FBXAnimation* pAnimation, float blockDuration, float scalingTolerance, float rotationTolerance, float translationTolerance, bool bWorld, FBXStreamingAnimation* pOutStreaming);
+extern void SHRDecompressAnimationBlockPose(const void* pBlock, float time, FBXAnimationCursor* pCursors, const FBXAnimationPose& pose);
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////
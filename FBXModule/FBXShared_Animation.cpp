@@ -7,6 +7,8 @@
 
 #include "stdafx.h"
 
+#include <cmath>
+
 #include <FBXAssign.hpp>
 
 #include "FBXUtilites.h"
@@ -22,6 +24,7 @@ static fbx_unordered_set<FbxNode*> ins_tmpNodeList;
 static fbx_vector<AnimationStack> ins_animationStacks;
 
 static fbx_set<FbxTime> ins_animationKeyFrames[3];
+static fbx_map<FbxTime, FBXAnimationInterpolationType> ins_animationKeyTypes[3];
 static fbx_unordered_set<double> ins_unrollKeyFrame;
 
 
@@ -44,7 +47,7 @@ static inline void ins_keyTypeOptimze(KEY_TABLE& keyTable, const VALUE& kVal){
     if(keycount > 1){
         auto& iPrevKey = keyTable[keycount - 2];
 
-        if(iPrevKey.local == kVal.first)
+        if((iPrevKey.type == FBXAnimationInterpolationType::FBXAnimationInterpolationType_Linear) && (iPrevKey.local == kVal.first))
             iPrevKey.type = FBXAnimationInterpolationType::FBXAnimationInterpolationType_Stepped;
     }
 }
@@ -58,6 +61,14 @@ static inline bool ins_keyCompare(const KEY& lhs, const KEY& rhs, DIFF valDiff){
     return true;
 }
 template<typename KEY, typename DIFF, size_t KEY_COUNT = _countof(KEY::mData)>
+static inline bool ins_keyFlat(const KEY& slope, DIFF valDiff){
+    for(size_t i = 0; i < KEY_COUNT; ++i){
+        if(std::abs((DIFF)slope.mData[i]) > valDiff)
+            return false;
+    }
+    return true;
+}
+template<typename KEY, typename DIFF, size_t KEY_COUNT = _countof(KEY::mData)>
 static inline void ins_keyReduce(AnimationKeyFrames<KEY>& keyTable, DIFF valDiff){
     if(keyTable.size() > 2){
         size_t idxPivot = 1;
@@ -69,7 +80,11 @@ static inline void ins_keyReduce(AnimationKeyFrames<KEY>& keyTable, DIFF valDiff
             if(
                 ins_keyCompare(iCur.local, iLhs.local, valDiff) &&
                 ins_keyCompare(iCur.local, iRhs.local, valDiff) &&
-                ins_keyCompare(iLhs.local, iRhs.local, valDiff)
+                ins_keyCompare(iLhs.local, iRhs.local, valDiff) &&
+                ins_keyFlat(iLhs.localOutTangent, valDiff) &&
+                ins_keyFlat(iCur.localInTangent, valDiff) &&
+                ins_keyFlat(iCur.localOutTangent, valDiff) &&
+                ins_keyFlat(iRhs.localInTangent, valDiff)
                 )
             {
                 auto itr = keyTable.begin();
@@ -87,11 +102,22 @@ static inline void ins_keyReduce(AnimationKeyFrames<KEY>& keyTable, DIFF valDiff
         const auto& iLhs = keyTable[0];
         const auto& iRhs = keyTable[1];
 
-        if(ins_keyCompare(iLhs.local, iRhs.local, valDiff))
+        if(ins_keyCompare(iLhs.local, iRhs.local, valDiff) && ins_keyFlat(iLhs.localOutTangent, valDiff) && ins_keyFlat(iRhs.localInTangent, valDiff))
             keyTable.pop_back();
     }
 }
 
+static inline FBXAnimationInterpolationType ins_convInterpolationType(FbxAnimCurveDef::EInterpolationType type){
+    switch(type){
+    case FbxAnimCurveDef::eInterpolationConstant:
+        return FBXAnimationInterpolationType::FBXAnimationInterpolationType_Stepped;
+    case FbxAnimCurveDef::eInterpolationCubic:
+        return FBXAnimationInterpolationType::FBXAnimationInterpolationType_Cubic;
+    }
+
+    return FBXAnimationInterpolationType::FBXAnimationInterpolationType_Linear;
+}
+
 static inline void ins_updateTimestamp(const FbxTime& kEndTime, FbxAnimCurve* kAnimCurve, size_t idx){
     if(!kAnimCurve)
         return;
@@ -99,8 +125,67 @@ static inline void ins_updateTimestamp(const FbxTime& kEndTime, FbxAnimCurve* kA
     for(auto e = kAnimCurve->KeyGetCount(), i = 0; i < e; ++i){
         //const auto& kCurveKey = kAnimCurve->KeyGet(i);
         auto kCurTime = kAnimCurve->KeyGetTime(i);
-        if(kCurTime <= kEndTime)
+        if(kCurTime <= kEndTime){
             ins_animationKeyFrames[idx].emplace(kCurTime);
+
+            // a key takes the richest interpolation among the component curves keyed at the same time
+            const auto curType = ins_convInterpolationType(kAnimCurve->KeyGetInterpolation(i));
+            auto res = ins_animationKeyTypes[idx].emplace(kCurTime, curType);
+            if((!res.second) && (res.first->second < curType))
+                res.first->second = curType;
+        }
+    }
+}
+
+// keys inserted between source keys(ex: by ins_unrollQuaternions) belong to the segment of the preceding source key
+static inline FBXAnimationInterpolationType ins_findKeyType(size_t idx, const FbxTime& kTime){
+    const auto& keyTypes = ins_animationKeyTypes[idx];
+
+    auto f = keyTypes.upper_bound(kTime);
+    if(f == keyTypes.cbegin())
+        return FBXAnimationInterpolationType::FBXAnimationInterpolationType_Linear;
+
+    return (--f)->second;
+}
+
+// one sided second order difference. negative "step" gives the slope from the left
+template<typename KEY, size_t KEY_COUNT = _countof(KEY::mData)>
+static inline KEY ins_keySlope(const KEY& v0, const KEY& v1, const KEY& v2, double step){
+    KEY ret;
+    for(size_t i = 0; i < KEY_COUNT; ++i)
+        ret.mData[i] = (-3. * v0.mData[i] + 4. * v1.mData[i] - v2.mData[i]) / (2. * step);
+    return ret;
+}
+// cubic segments are sampled from the evaluator at both ends, so tangents hold the motion of the composed transform rather than of each source curve
+template<typename KEY, typename SAMPLER>
+static inline void ins_computeTangents(AnimationKeyFrames<KEY>& keyTable, SAMPLER sampler){
+    for(size_t idxKey = 0; (idxKey + 1) < keyTable.size(); ++idxKey){
+        auto& iLhs = keyTable[idxKey];
+        auto& iRhs = keyTable[idxKey + 1];
+        if(iLhs.type != FBXAnimationInterpolationType::FBXAnimationInterpolationType_Cubic)
+            continue;
+
+        const auto fLhsTime = iLhs.time.GetSecondDouble();
+        const auto fRhsTime = iRhs.time.GetSecondDouble();
+        const auto fStep = (fRhsTime - fLhsTime) / 64.;
+
+        FbxTime kTime;
+
+        kTime.SetSecondDouble(fLhsTime + fStep);
+        const auto kLhs1 = sampler(kTime, iLhs.local, iLhs.world);
+        kTime.SetSecondDouble(fLhsTime + fStep * 2.);
+        const auto kLhs2 = sampler(kTime, iLhs.local, iLhs.world);
+
+        iLhs.localOutTangent = ins_keySlope(iLhs.local, kLhs1.first, kLhs2.first, fStep);
+        iLhs.worldOutTangent = ins_keySlope(iLhs.world, kLhs1.second, kLhs2.second, fStep);
+
+        kTime.SetSecondDouble(fRhsTime - fStep);
+        const auto kRhs1 = sampler(kTime, iRhs.local, iRhs.world);
+        kTime.SetSecondDouble(fRhsTime - fStep * 2.);
+        const auto kRhs2 = sampler(kTime, iRhs.local, iRhs.world);
+
+        iRhs.localInTangent = ins_keySlope(iRhs.local, kRhs1.first, kRhs2.first, -fStep);
+        iRhs.worldInTangent = ins_keySlope(iRhs.world, kRhs1.second, kRhs2.second, -fStep);
     }
 }
 
@@ -177,17 +262,86 @@ static inline void ins_convAnimationKey(EXPORT_TYPE& expKey, FBX_TYPE& fbxKey){
     CopyArrayData(expKey.World.Values, fbxKey.world.mData);
 }
 
+// tangents are kept only for a track having a cubic key
+template<typename EXPORT_TYPE, typename FBX_TYPE>
+static inline void ins_convAnimationTangents(EXPORT_TYPE& expTangents, FBX_TYPE& fbxKeys){
+    bool bCubic = false;
+    for(const auto& iKey : fbxKeys){
+        if(iKey.type == FBXAnimationInterpolationType::FBXAnimationInterpolationType_Cubic){
+            bCubic = true;
+            break;
+        }
+    }
+    if(!bCubic){
+        expTangents.Clear();
+        return;
+    }
+
+    expTangents.Assign(fbxKeys.size());
+    for(size_t idxKey = 0; idxKey < expTangents.Length; ++idxKey){
+        auto& iKey = fbxKeys[idxKey];
+        auto* pTangent = &expTangents.Values[idxKey];
+
+        CopyArrayData(pTangent->Local.In.Values, iKey.localInTangent.mData);
+        CopyArrayData(pTangent->Local.Out.Values, iKey.localOutTangent.mData);
+        CopyArrayData(pTangent->World.In.Values, iKey.worldInTangent.mData);
+        CopyArrayData(pTangent->World.Out.Values, iKey.worldOutTangent.mData);
+    }
+}
+
 static inline FbxAnimCurveDef::EInterpolationType ins_convInterpolationType(FBXAnimationInterpolationType type){
     switch(type){
     case FBXAnimationInterpolationType::FBXAnimationInterpolationType_Stepped:
         return FbxAnimCurveDef::eInterpolationConstant;
     case FBXAnimationInterpolationType::FBXAnimationInterpolationType_Linear:
         return FbxAnimCurveDef::eInterpolationLinear;
+    case FBXAnimationInterpolationType::FBXAnimationInterpolationType_Cubic:
+        return FbxAnimCurveDef::eInterpolationCubic;
     }
 
     return FbxAnimCurveDef::eInterpolationConstant;
 }
 
+// user tangents are set on keys touching a cubic segment. the other keys keep the default tangent mode
+static inline void ins_setCurveTangent(FbxAnimCurve* kCurve, int curIndex, bool bCubicIn, bool bCubicOut, float fIn, float fOut){
+    if(!(bCubicIn || bCubicOut))
+        return;
+
+    kCurve->KeySetTangentMode(curIndex, FbxAnimCurveDef::eTangentBreak);
+    if(bCubicIn)
+        kCurve->KeySetLeftDerivative(curIndex, fIn);
+    if(bCubicOut)
+        kCurve->KeySetRightDerivative(curIndex, fOut);
+}
+
+static inline FbxVector4 ins_quaternionToEuler(const FbxQuaternion& kQuat){
+    FbxAMatrix kMat;
+    kMat.SetQ(kQuat);
+    return kMat.GetR();
+}
+// euler(degree) slopes of a quaternion slope, by central difference around the key
+static inline FbxVector4 ins_eulerSlope(const FBXStaticArray<float, 4>& quat, const FBXStaticArray<float, 4>& slope){
+    static const double fStep = 0.001;
+
+    FbxQuaternion kPrev, kNext;
+    for(int i = 0; i < 4; ++i){
+        kPrev.mData[i] = (double)quat.Values[i] - (double)slope.Values[i] * fStep;
+        kNext.mData[i] = (double)quat.Values[i] + (double)slope.Values[i] * fStep;
+    }
+    kPrev.Normalize();
+    kNext.Normalize();
+
+    const auto kEulerPrev = ins_quaternionToEuler(kPrev);
+    const auto kEulerNext = ins_quaternionToEuler(kNext);
+
+    FbxVector4 kRet;
+    for(int i = 0; i < 3; ++i){
+        auto fDiff = std::remainder(kEulerNext.mData[i] - kEulerPrev.mData[i], 360.);
+        kRet.mData[i] = fDiff / (2. * fStep);
+    }
+    return kRet;
+}
+
 
 bool SHRReduceAnimation(FbxManager* kSDKManager, FbxScene* kScene, const NodeNameList& excludeNameList, TransformMask eMask, double fPrecision){
     static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("SHRReduceAnimation(FbxManager*, FbxScene*, const NodeNameList&, TransformMask, double)");
@@ -348,6 +502,8 @@ bool SHRLoadAnimation(FbxManager* kSDKManager, FbxScene* kScene, const Animation
 
             for(auto& keyTable : ins_animationKeyFrames)
                 keyTable.clear();
+            for(auto& keyTypes : ins_animationKeyTypes)
+                keyTypes.clear();
 
             for(auto edxAnimLayer = kAnimStack->GetMemberCount<FbxAnimLayer>(), idxAnimLayer = 0; idxAnimLayer < edxAnimLayer; ++idxAnimLayer){
                 auto* kAnimLayer = kAnimStack->GetMember<FbxAnimLayer>(idxAnimLayer);
@@ -440,7 +596,7 @@ bool SHRLoadAnimation(FbxManager* kSDKManager, FbxScene* kScene, const Animation
                         else
                             kVal.first = kDefaultTranslation;
                     }
-                    {
+                    if(!shr_ioSetting.IgnoreAnimationWorldKeys){
                         auto kMat = GetGlobalTransform(kAnimEvaluator, kNode, kTime);
                         auto kVec = kMat.GetT();
 
@@ -449,10 +605,18 @@ bool SHRLoadAnimation(FbxManager* kSDKManager, FbxScene* kScene, const Animation
                         else
                             kVal.second = kDefaultTranslation;
                     }
-                    newNodes.translationKeys.emplace_back(kTime, FBXAnimationInterpolationType::FBXAnimationInterpolationType_Linear, kVal);
+                    newNodes.translationKeys.emplace_back(kTime, ins_findKeyType(0, kTime), kVal);
                     ins_keyTypeOptimze(newNodes.translationKeys, kVal);
                 }
 
+                ins_computeTangents(newNodes.translationKeys, [&](const FbxTime& kTime, const FbxDouble3&, const FbxDouble3&){
+                    std::pair<FbxDouble3, FbxDouble3> kVal;
+                    kVal.first = GetLocalTransform(kAnimEvaluator, kNode, kTime).GetT();
+                    if(!shr_ioSetting.IgnoreAnimationWorldKeys)
+                        kVal.second = GetGlobalTransform(kAnimEvaluator, kNode, kTime).GetT();
+                    return kVal;
+                });
+
                 ins_keyReduce(newNodes.translationKeys, shr_ioSetting.AnimationKeyCompareDifference);
 
                 if(newNodes.translationKeys.empty()){
@@ -475,7 +639,7 @@ bool SHRLoadAnimation(FbxManager* kSDKManager, FbxScene* kScene, const Animation
 
                         kVal.first = kVec;
                     }
-                    {
+                    if(!shr_ioSetting.IgnoreAnimationWorldKeys){
                         auto kMat = GetGlobalTransform(kAnimEvaluator, kNode, kTime);
                         auto kVec = kMat.GetQ();
 
@@ -484,10 +648,27 @@ bool SHRLoadAnimation(FbxManager* kSDKManager, FbxScene* kScene, const Animation
 
                         kVal.second = kVec;
                     }
-                    newNodes.rotationKeys.emplace_back(kTime, FBXAnimationInterpolationType::FBXAnimationInterpolationType_Linear, kVal);
+                    newNodes.rotationKeys.emplace_back(kTime, ins_findKeyType(1, kTime), kVal);
                     ins_keyTypeOptimze(newNodes.rotationKeys, kVal);
                 }
 
+                ins_computeTangents(newNodes.rotationKeys, [&](const FbxTime& kTime, const FbxDouble4& kLocalRef, const FbxDouble4& kWorldRef){
+                    std::pair<FbxDouble4, FbxDouble4> kVal;
+                    {
+                        auto kVec = GetLocalTransform(kAnimEvaluator, kNode, kTime).GetQ();
+                        if(FbxQuaternion(kLocalRef[0], kLocalRef[1], kLocalRef[2], kLocalRef[3]).DotProduct(kVec) < 0)
+                            kVec *= -1;
+                        kVal.first = kVec;
+                    }
+                    if(!shr_ioSetting.IgnoreAnimationWorldKeys){
+                        auto kVec = GetGlobalTransform(kAnimEvaluator, kNode, kTime).GetQ();
+                        if(FbxQuaternion(kWorldRef[0], kWorldRef[1], kWorldRef[2], kWorldRef[3]).DotProduct(kVec) < 0)
+                            kVec *= -1;
+                        kVal.second = kVec;
+                    }
+                    return kVal;
+                });
+
                 ins_keyReduce(newNodes.rotationKeys, shr_ioSetting.AnimationKeyCompareDifference);
 
                 if(newNodes.rotationKeys.empty()){
@@ -507,16 +688,24 @@ bool SHRLoadAnimation(FbxManager* kSDKManager, FbxScene* kScene, const Animation
 
                         kVal.first = kVec;
                     }
-                    {
+                    if(!shr_ioSetting.IgnoreAnimationWorldKeys){
                         auto kMat = GetGlobalTransform(kAnimEvaluator, kNode, kTime);
                         auto kVec = kMat.GetS();
 
                         kVal.second = kVec;
                     }
-                    newNodes.scalingKeys.emplace_back(kTime, FBXAnimationInterpolationType::FBXAnimationInterpolationType_Linear, kVal);
+                    newNodes.scalingKeys.emplace_back(kTime, ins_findKeyType(2, kTime), kVal);
                     ins_keyTypeOptimze(newNodes.scalingKeys, kVal);
                 }
 
+                ins_computeTangents(newNodes.scalingKeys, [&](const FbxTime& kTime, const FbxDouble3&, const FbxDouble3&){
+                    std::pair<FbxDouble3, FbxDouble3> kVal;
+                    kVal.first = GetLocalTransform(kAnimEvaluator, kNode, kTime).GetS();
+                    if(!shr_ioSetting.IgnoreAnimationWorldKeys)
+                        kVal.second = GetGlobalTransform(kAnimEvaluator, kNode, kTime).GetS();
+                    return kVal;
+                });
+
                 ins_keyReduce(newNodes.scalingKeys, shr_ioSetting.AnimationKeyCompareDifference);
 
                 if(newNodes.scalingKeys.empty()){
@@ -562,11 +751,13 @@ bool SHRLoadAnimations(FbxManager* kSDKManager, FbxScene* kScene, const FbxNodeT
         CopyString(pAnimation->Name, strStackName);
 
         pAnimation->EndTime = decltype(pAnimation->EndTime)(iAnimation.endTime.GetSecondDouble());
+        pAnimation->HasWorldKeys = !shr_ioSetting.IgnoreAnimationWorldKeys;
 
         pAnimation->AnimationNodes.Assign(iAnimation.nodes.size());
         for(size_t idxNode = 0; idxNode < pAnimation->AnimationNodes.Length; ++idxNode){
             auto& iNode = iAnimation.nodes[idxNode];
             auto* pNode = &pAnimation->AnimationNodes.Values[idxNode];
+            pNode->HasWorldKeys = pAnimation->HasWorldKeys;
 
             const fbx_string strNodeName = ConvertString<FBX_CHAR>(iNode.bindNode->GetName());
 
@@ -584,6 +775,8 @@ bool SHRLoadAnimations(FbxManager* kSDKManager, FbxScene* kScene, const FbxNodeT
                 pNode->BindNode = f->second;
             }
 
+            ins_convAnimationTangents(pNode->ScalingTangents, iNode.scalingKeys);
+
             pNode->ScalingKeys.Assign(iNode.scalingKeys.size());
             for(size_t idxKey = 0; idxKey < pNode->ScalingKeys.Length; ++idxKey){
                 auto& iKey = iNode.scalingKeys[idxKey];
@@ -592,6 +785,8 @@ bool SHRLoadAnimations(FbxManager* kSDKManager, FbxScene* kScene, const FbxNodeT
                 ins_convAnimationKey(*pKey, iKey);
             }
 
+            ins_convAnimationTangents(pNode->RotationTangents, iNode.rotationKeys);
+
             pNode->RotationKeys.Assign(iNode.rotationKeys.size());
             for(size_t idxKey = 0; idxKey < pNode->RotationKeys.Length; ++idxKey){
                 auto& iKey = iNode.rotationKeys[idxKey];
@@ -604,13 +799,15 @@ bool SHRLoadAnimations(FbxManager* kSDKManager, FbxScene* kScene, const FbxNodeT
                     xmm_q = DirectX::XMQuaternionNormalize(xmm_q);
                     DirectX::XMStoreFloat4((DirectX::XMFLOAT4*)&(*pKey).Local.Values, xmm_q);
                 }
-                {
+                if(!shr_ioSetting.IgnoreAnimationWorldKeys){
                     auto xmm_q = DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)&(*pKey).World.Values);
                     xmm_q = DirectX::XMQuaternionNormalize(xmm_q);
                     DirectX::XMStoreFloat4((DirectX::XMFLOAT4*)&(*pKey).World.Values, xmm_q);
                 }
             }
 
+            ins_convAnimationTangents(pNode->TranslationTangents, iNode.translationKeys);
+
             pNode->TranslationKeys.Assign(iNode.translationKeys.size());
             for(size_t idxKey = 0; idxKey < pNode->TranslationKeys.Length; ++idxKey){
                 auto& iKey = iNode.translationKeys[idxKey];
@@ -619,6 +816,9 @@ bool SHRLoadAnimations(FbxManager* kSDKManager, FbxScene* kScene, const FbxNodeT
                 ins_convAnimationKey(*pKey, iKey);
             }
         }
+
+        if(shr_ioSetting.AnimationSampleRate > 0.)
+            SHRResampleAnimation(pAnimation, (float)shr_ioSetting.AnimationSampleRate);
     }
 
     return true;
@@ -740,19 +940,26 @@ bool SHRStoreAnimation(FbxManager* kSDKManager, FbxScene* kScene, const ImportNo
                         FbxTime curTime;
                         int curIndex;
 
+                        const bool bCubicIn = (pKey != pKeyList->Values) && ((pKey - 1)->InterpolationType == FBXAnimationInterpolationType::FBXAnimationInterpolationType_Cubic);
+                        const bool bCubicOut = (pKey->InterpolationType == FBXAnimationInterpolationType::FBXAnimationInterpolationType_Cubic);
+                        const auto& kTangent = GetKeyTangent(pAnimNode->TranslationTangents, FBX_PTRDIFFU(pKey - pKeyList->Values)).Local;
+
                         curTime.SetSecondDouble(pKey->Time);
 
                         curIndex = kCurveX->KeyAdd(curTime);
                         kCurveX->KeySetValue(curIndex, pKey->Local.Values[0]);
                         kCurveX->KeySetInterpolation(curIndex, curType);
+                        ins_setCurveTangent(kCurveX, curIndex, bCubicIn, bCubicOut, kTangent.In.Values[0], kTangent.Out.Values[0]);
 
                         curIndex = kCurveY->KeyAdd(curTime);
                         kCurveY->KeySetValue(curIndex, pKey->Local.Values[1]);
                         kCurveY->KeySetInterpolation(curIndex, curType);
+                        ins_setCurveTangent(kCurveY, curIndex, bCubicIn, bCubicOut, kTangent.In.Values[1], kTangent.Out.Values[1]);
 
                         curIndex = kCurveZ->KeyAdd(curTime);
                         kCurveZ->KeySetValue(curIndex, pKey->Local.Values[2]);
                         kCurveZ->KeySetInterpolation(curIndex, curType);
+                        ins_setCurveTangent(kCurveZ, curIndex, bCubicIn, bCubicOut, kTangent.In.Values[2], kTangent.Out.Values[2]);
                     }
 
                     {
@@ -811,23 +1018,34 @@ bool SHRStoreAnimation(FbxManager* kSDKManager, FbxScene* kScene, const ImportNo
                         FbxTime curTime;
                         int curIndex;
 
-                        FbxAMatrix kMat;
-                        kMat.SetQ(FbxQuaternion(pKey->Local.Values[0], pKey->Local.Values[1], pKey->Local.Values[2], pKey->Local.Values[3]));
-                        auto kVal = kMat.GetR();
+                        auto kVal = ins_quaternionToEuler(FbxQuaternion(pKey->Local.Values[0], pKey->Local.Values[1], pKey->Local.Values[2], pKey->Local.Values[3]));
+
+                        const bool bCubicIn = (pKey != pKeyList->Values) && ((pKey - 1)->InterpolationType == FBXAnimationInterpolationType::FBXAnimationInterpolationType_Cubic);
+                        const bool bCubicOut = (pKey->InterpolationType == FBXAnimationInterpolationType::FBXAnimationInterpolationType_Cubic);
+                        const auto& kTangent = GetKeyTangent(pAnimNode->RotationTangents, FBX_PTRDIFFU(pKey - pKeyList->Values)).Local;
+
+                        FbxVector4 kInSlope, kOutSlope;
+                        if(bCubicIn)
+                            kInSlope = ins_eulerSlope(pKey->Local, kTangent.In);
+                        if(bCubicOut)
+                            kOutSlope = ins_eulerSlope(pKey->Local, kTangent.Out);
 
                         curTime.SetSecondDouble(pKey->Time);
 
                         curIndex = kCurveX->KeyAdd(curTime);
                         kCurveX->KeySetValue(curIndex, (float)kVal[0]);
                         kCurveX->KeySetInterpolation(curIndex, curType);
+                        ins_setCurveTangent(kCurveX, curIndex, bCubicIn, bCubicOut, (float)kInSlope[0], (float)kOutSlope[0]);
 
                         curIndex = kCurveY->KeyAdd(curTime);
                         kCurveY->KeySetValue(curIndex, (float)kVal[1]);
                         kCurveY->KeySetInterpolation(curIndex, curType);
+                        ins_setCurveTangent(kCurveY, curIndex, bCubicIn, bCubicOut, (float)kInSlope[1], (float)kOutSlope[1]);
 
                         curIndex = kCurveZ->KeyAdd(curTime);
                         kCurveZ->KeySetValue(curIndex, (float)kVal[2]);
                         kCurveZ->KeySetInterpolation(curIndex, curType);
+                        ins_setCurveTangent(kCurveZ, curIndex, bCubicIn, bCubicOut, (float)kInSlope[2], (float)kOutSlope[2]);
                     }
 
                     {
@@ -900,19 +1118,26 @@ bool SHRStoreAnimation(FbxManager* kSDKManager, FbxScene* kScene, const ImportNo
                         FbxTime curTime;
                         int curIndex;
 
+                        const bool bCubicIn = (pKey != pKeyList->Values) && ((pKey - 1)->InterpolationType == FBXAnimationInterpolationType::FBXAnimationInterpolationType_Cubic);
+                        const bool bCubicOut = (pKey->InterpolationType == FBXAnimationInterpolationType::FBXAnimationInterpolationType_Cubic);
+                        const auto& kTangent = GetKeyTangent(pAnimNode->ScalingTangents, FBX_PTRDIFFU(pKey - pKeyList->Values)).Local;
+
                         curTime.SetSecondDouble(pKey->Time);
 
                         curIndex = kCurveX->KeyAdd(curTime);
                         kCurveX->KeySetValue(curIndex, pKey->Local.Values[0]);
                         kCurveX->KeySetInterpolation(curIndex, curType);
+                        ins_setCurveTangent(kCurveX, curIndex, bCubicIn, bCubicOut, kTangent.In.Values[0], kTangent.Out.Values[0]);
 
                         curIndex = kCurveY->KeyAdd(curTime);
                         kCurveY->KeySetValue(curIndex, pKey->Local.Values[1]);
                         kCurveY->KeySetInterpolation(curIndex, curType);
+                        ins_setCurveTangent(kCurveY, curIndex, bCubicIn, bCubicOut, kTangent.In.Values[1], kTangent.Out.Values[1]);
 
                         curIndex = kCurveZ->KeyAdd(curTime);
                         kCurveZ->KeySetValue(curIndex, pKey->Local.Values[2]);
                         kCurveZ->KeySetInterpolation(curIndex, curType);
+                        ins_setCurveTangent(kCurveZ, curIndex, bCubicIn, bCubicOut, kTangent.In.Values[2], kTangent.Out.Values[2]);
                     }
 
                     {
@@ -7,10 +7,16 @@
 
 #include "stdafx.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include "FBXShared.h"
 
 
-using _ClusterCountChecker = fbx_unordered_set<FbxCluster*, PointerHasher<FbxCluster*>>;
+// material keys and bones are interned to dense ids per mesh. palettes keep their bones as a bitset over the bone ids,
+// so putting a polygon into a palette costs only as much as the polygon's own bones
+
+using _BoneBitset = fbx_vector<unsigned long long>;
 
 class _OrderedKey{
 public:
@@ -22,6 +28,11 @@ public:
 public:
     UintContainer layers;
 };
+static inline bool operator==(const _OrderedKey& lhs, const _OrderedKey& rhs){
+    return lhs.layers == rhs.layers;
+}
+// shorter keys first, then lexicographic over layer materials. keys of more than one layer may be ordered differently from before,
+// since the former comparison wasn't a strict weak ordering for them
 static inline bool operator<(const _OrderedKey& lhs, const _OrderedKey& rhs){
     const auto cntLhs = lhs.layers.size();
     const auto cntRhs = rhs.layers.size();
@@ -32,43 +43,53 @@ static inline bool operator<(const _OrderedKey& lhs, const _OrderedKey& rhs){
         return false;
 
     for(size_t idx = 0; idx < cntLhs; ++idx){
-        if(lhs.layers[idx] < rhs.layers[idx])
-            return true;
+        if(lhs.layers[idx] != rhs.layers[idx])
+            return lhs.layers[idx] < rhs.layers[idx];
     }
 
     return false;
 }
-class _OrderdKeyWithIndex : public _OrderedKey{
+
+class _BoneSetKey{
 public:
     inline operator size_t()const{
-        size_t key[] = { (size_t)(*static_cast<const _OrderedKey*>(this)), (size_t)index, attribute };
-        return MakeHash(key);
+        return MakeHash(bones.data(), bones.size());
     }
 
 
 public:
-    unsigned int index;
-    size_t attribute;
+    UintContainer bones; // sorted bone ids
 };
+static inline bool operator==(const _BoneSetKey& lhs, const _BoneSetKey& rhs){
+    return lhs.bones == rhs.bones;
+}
 
 struct _MeshPolyValue{
-    _ClusterCountChecker participatedClusters;
+    _BoneBitset participatedBones;
+    size_t boneCount;
     UintContainer polyIndices;
 };
 
-using _TempMeshPolys = fbx_map<_OrderedKey, UintContainer>;
-using _MeshPolys = fbx_multimap<_OrderedKey, _MeshPolyValue>;
+using _MeshPolys = fbx_vector<std::pair<unsigned int, _MeshPolyValue>>; // first points ins_materialKeys. grouped in material key order
 
 
-static _TempMeshPolys ins_tmpMeshPolys;
+static fbx_vector<_OrderedKey> ins_materialKeys;
+static fbx_unordered_map<_OrderedKey, unsigned int, CustomHasher<_OrderedKey>> ins_materialKeyFinder;
+static UintContainer ins_materialKeyOrder;
+
+static fbx_vector<UintContainer> ins_tmpMeshPolys; // polygons per material key
 static _MeshPolys ins_meshPolys;
 
-static _ClusterCountChecker ins_localClusterCounterChecker[2];
+static fbx_unordered_map<FbxCluster*, unsigned int, PointerHasher<FbxCluster*>> ins_boneFinder;
+static BoneCombination ins_bones; // bone id to cluster
+static UintContainer ins_vertBoneOffsets; // bones of vertex n are ins_vertBones[ins_vertBoneOffsets[n], ins_vertBoneOffsets[n + 1])
+static UintContainer ins_vertBones;
+static UintContainer ins_polyBones;
 
-static fbx_unordered_map<_OrderdKeyWithIndex, unsigned int, CustomHasher<_OrderdKeyWithIndex>> ins_vertOldToNew;
+static UintContainer ins_vertAttrStamp;
+static UintContainer ins_vertOldToNew;
 static fbx_vector<unsigned int> ins_vertNewToOld;
 
-static Vector3Container ins_bufPositions;
 static Uint3Container ins_bufIndices;
 
 static fbx_vector<LayerElement> ins_bufLayers;
@@ -76,95 +97,439 @@ static fbx_vector<LayerElement> ins_bufLayers;
 static SkinInfoContainer ins_bufSkinData;
 
 
+BoneCombinationReport shr_boneCombinationReport = { 0, 0 };
+
+
+static inline bool ins_testBone(const _BoneBitset& bits, unsigned int idxBone){
+    return ((bits[idxBone >> 6] >> (idxBone & 63)) & 1ull) != 0ull;
+}
+static inline void ins_setBone(_BoneBitset& bits, unsigned int idxBone){
+    bits[idxBone >> 6] |= (1ull << (idxBone & 63));
+}
+// bones are listed in bone id order, which is the order clusters first appear in the skin data of the mesh.
+// this differs from the former order, which followed iteration of a pointer keyed hash set and wasn't stable between runs
+static inline void ins_storeBoneCombination(BoneCombination& boneCombination, const _MeshPolyValue& polyVal){
+    boneCombination.clear();
+    boneCombination.reserve(polyVal.boneCount);
+
+    for(size_t idxWord = 0u; idxWord < polyVal.participatedBones.size(); ++idxWord){
+        auto word = polyVal.participatedBones[idxWord];
+        for(auto idxBone = (unsigned int)(idxWord << 6); word; ++idxBone, word >>= 1){
+            if(word & 1ull)
+                boneCombination.emplace_back(ins_bones[idxBone]);
+        }
+    }
+}
+
 static void ins_genTempMeshAttribute(const NodeData* pNodeData){
+    ins_materialKeys.clear();
+    ins_materialKeyFinder.clear();
     ins_tmpMeshPolys.clear();
 
+    const auto edxPoly = (unsigned int)pNodeData->bufIndices.size();
     const auto edxLayer = pNodeData->bufLayers.size();
     if(!edxLayer){
-        _OrderedKey newKey;
+        ins_materialKeys.emplace_back();
+        ins_tmpMeshPolys.emplace_back();
 
-        UintContainer polyIndices;
-        polyIndices.reserve(pNodeData->bufIndices.size());
-        for(auto edxPoly = (unsigned int)pNodeData->bufIndices.size(), idxPoly = 0u; idxPoly < edxPoly; ++idxPoly)
+        auto& polyIndices = ins_tmpMeshPolys.back();
+        polyIndices.reserve(edxPoly);
+        for(auto idxPoly = 0u; idxPoly < edxPoly; ++idxPoly)
             polyIndices.emplace_back(idxPoly);
-
-        ins_tmpMeshPolys.emplace(std::move(newKey), std::move(polyIndices));
     }
     else{
-        for(auto edxPoly = (unsigned int)pNodeData->bufIndices.size(), idxPoly = 0u; idxPoly < edxPoly; ++idxPoly){
-            _OrderedKey newKey;
-            newKey.layers.resize(edxLayer);
+        _OrderedKey newKey;
+        newKey.layers.resize(edxLayer);
 
+        for(auto idxPoly = 0u; idxPoly < edxPoly; ++idxPoly){
             for(size_t idxLayer = 0; idxLayer < edxLayer; ++idxLayer){
                 const auto& iLayer = pNodeData->bufLayers[idxLayer];
 
-                if(!iLayer.materials.empty())
-                    newKey.layers[idxLayer] = iLayer.materials[idxPoly];
+                newKey.layers[idxLayer] = iLayer.materials.empty() ? 0u : iLayer.materials[idxPoly];
             }
 
-            auto f = ins_tmpMeshPolys.find(newKey);
-            if(f == ins_tmpMeshPolys.end()){
-                UintContainer polyIndices;
-                polyIndices.reserve(edxPoly);
-                polyIndices.emplace_back((unsigned int)idxPoly);
-                ins_tmpMeshPolys.emplace(std::move(newKey), std::move(polyIndices));
+            auto res = ins_materialKeyFinder.emplace(newKey, (unsigned int)ins_materialKeys.size());
+            if(res.second){
+                ins_materialKeys.emplace_back(newKey);
+                ins_tmpMeshPolys.emplace_back();
             }
-            else
-                f->second.emplace_back((unsigned int)idxPoly);
+
+            ins_tmpMeshPolys[res.first->second].emplace_back(idxPoly);
+        }
+    }
+
+    ins_materialKeyOrder.resize(ins_materialKeys.size());
+    for(auto edxKey = (unsigned int)ins_materialKeys.size(), idxKey = 0u; idxKey < edxKey; ++idxKey)
+        ins_materialKeyOrder[idxKey] = idxKey;
+    std::sort(ins_materialKeyOrder.begin(), ins_materialKeyOrder.end(), [](unsigned int lhs, unsigned int rhs){
+        return ins_materialKeys[lhs] < ins_materialKeys[rhs];
+    });
+}
+
+static void ins_internBones(const NodeData* pNodeData){
+    ins_boneFinder.clear();
+    ins_bones.clear();
+
+    ins_vertBoneOffsets.clear();
+    ins_vertBoneOffsets.reserve(pNodeData->bufSkinData.size() + 1u);
+    ins_vertBones.clear();
+    ins_vertBones.reserve(pNodeData->bufSkinData.size() * shr_ioSetting.MaxParticipateClusterPerVertex);
+
+    for(const auto& iSkin : pNodeData->bufSkinData){
+        ins_vertBoneOffsets.emplace_back((unsigned int)ins_vertBones.size());
+
+        for(const auto& iWeight : iSkin){
+            auto res = ins_boneFinder.emplace(iWeight.cluster, (unsigned int)ins_bones.size());
+            if(res.second)
+                ins_bones.emplace_back(iWeight.cluster);
+
+            ins_vertBones.emplace_back(res.first->second);
         }
     }
+    ins_vertBoneOffsets.emplace_back((unsigned int)ins_vertBones.size());
+}
+static inline void ins_gatherPolyBones(const NodeData* pNodeData, unsigned int idxPoly){
+    ins_polyBones.clear();
+
+    for(const auto& idxVert : pNodeData->bufIndices[idxPoly].raw){
+        for(auto idxBone = ins_vertBoneOffsets[idxVert], edxBone = ins_vertBoneOffsets[idxVert + 1]; idxBone < edxBone; ++idxBone)
+            ins_polyBones.emplace_back(ins_vertBones[idxBone]);
+    }
+
+    std::sort(ins_polyBones.begin(), ins_polyBones.end());
+    ins_polyBones.erase(std::unique(ins_polyBones.begin(), ins_polyBones.end()), ins_polyBones.end());
 }
 
 static void ins_genMeshAttribute(NodeData* pNodeData){
     ins_meshPolys.clear();
-    for(const auto& iAttr : ins_tmpMeshPolys){
+    ins_meshPolys.reserve(ins_materialKeyOrder.size());
+    for(const auto& idxKey : ins_materialKeyOrder){
         _MeshPolyValue newPolyVal;
-        newPolyVal.polyIndices = std::move(iAttr.second);
+        newPolyVal.boneCount = 0u;
+        newPolyVal.polyIndices = std::move(ins_tmpMeshPolys[idxKey]);
 
-        ins_meshPolys.emplace(std::move(iAttr.first), std::move(newPolyVal));
+        ins_meshPolys.emplace_back(idxKey, std::move(newPolyVal));
     }
 }
-static void ins_genSkinnedMeshAttribute(NodeData* pNodeData){
+static void ins_genSkinnedMeshAttribute(NodeData* pNodeData, size_t maxBoneCount){
+    const auto wordCount = (ins_bones.size() + 63) >> 6;
+
     ins_meshPolys.clear();
-    for(const auto& iAttr : ins_tmpMeshPolys){
-        _MeshPolys::iterator itrCurPoly;
+    for(const auto& idxKey : ins_materialKeyOrder){
+        const auto& iAttr = ins_tmpMeshPolys[idxKey];
+
+        auto idxCurPoly = ins_meshPolys.size();
         {
             _MeshPolyValue reservePolyVal;
-            reservePolyVal.polyIndices.reserve(iAttr.second.size());
-            reservePolyVal.participatedClusters.rehash(pNodeData->mapBoneDeformMatrices.size() << 1);
+            reservePolyVal.participatedBones.assign(wordCount, 0ull);
+            reservePolyVal.boneCount = 0u;
 
-            itrCurPoly = ins_meshPolys.emplace(iAttr.first, std::move(reservePolyVal));
+            ins_meshPolys.emplace_back(idxKey, std::move(reservePolyVal));
         }
 
-        for(const auto& idxPoly : iAttr.second){
-            const auto& iPoly = pNodeData->bufIndices[idxPoly];
+        for(const auto& idxPoly : iAttr){
+            ins_gatherPolyBones(pNodeData, idxPoly);
 
-            ins_localClusterCounterChecker[0] = itrCurPoly->second.participatedClusters;
-            ins_localClusterCounterChecker[1].clear();
+            auto* pCurPoly = &ins_meshPolys[idxCurPoly].second;
 
-            for(const auto& idxVert : iPoly.raw){
-                const auto& iSkin = pNodeData->bufSkinData[idxVert];
-                for(const auto& iWeight : iSkin){
-                    itrCurPoly->second.participatedClusters.emplace(iWeight.cluster);
-                    ins_localClusterCounterChecker[1].emplace(iWeight.cluster);
-                }
+            size_t newBoneCount = 0u;
+            for(const auto& idxBone : ins_polyBones){
+                if(!ins_testBone(pCurPoly->participatedBones, idxBone))
+                    ++newBoneCount;
             }
 
-            if(itrCurPoly->second.participatedClusters.size() <= shr_ioSetting.MaxBoneCountPerMesh)
-                itrCurPoly->second.polyIndices.emplace_back(idxPoly);
-            else{
-                std::swap(itrCurPoly->second.participatedClusters, ins_localClusterCounterChecker[0]);
-
+            if(((pCurPoly->boneCount + newBoneCount) > maxBoneCount) && (!pCurPoly->polyIndices.empty())){
                 _MeshPolyValue newPolyVal;
-                newPolyVal.polyIndices.reserve(iAttr.second.size());
-                newPolyVal.participatedClusters.rehash(pNodeData->mapBoneDeformMatrices.size() << 1);
-                newPolyVal.polyIndices.emplace_back(idxPoly);
+                newPolyVal.participatedBones.assign(wordCount, 0ull);
+                newPolyVal.boneCount = 0u;
+
+                idxCurPoly = ins_meshPolys.size();
+                ins_meshPolys.emplace_back(idxKey, std::move(newPolyVal));
+
+                pCurPoly = &ins_meshPolys[idxCurPoly].second;
+                newBoneCount = ins_polyBones.size();
+            }
+
+            for(const auto& idxBone : ins_polyBones)
+                ins_setBone(pCurPoly->participatedBones, idxBone);
+            pCurPoly->boneCount += newBoneCount;
+
+            pCurPoly->polyIndices.emplace_back(idxPoly);
+        }
+    }
+}
+
+// palettes are grown by repeatedly merging the pair with the highest bone set overlap(jaccard index) that still fits in the budget.
+// triangles sharing the exact same bone set start in one palette, and whatever is left is finally packed first-fit.
+// every palette keeps only its best candidate in the queue, and candidates are searched among a bounded number of palettes per bone,
+// so the queue stays as large as the palette count
+class _BonePalette{
+public:
+    UintContainer bones; // sorted bone ids
+    UintContainer polyIndices;
+    unsigned int version;
+    bool alive;
+};
+class _BonePaletteMerge{
+public:
+    float score;
+    unsigned int shared;
+    unsigned int owner;
+    unsigned int other;
+    unsigned int ownerVersion;
+    unsigned int otherVersion;
+};
+static inline bool operator<(const _BonePaletteMerge& lhs, const _BonePaletteMerge& rhs){
+    if(lhs.score != rhs.score)
+        return lhs.score < rhs.score;
+    if(lhs.shared != rhs.shared)
+        return lhs.shared < rhs.shared;
+    if(lhs.owner != rhs.owner)
+        return lhs.owner > rhs.owner;
+    return lhs.other > rhs.other;
+}
+
+static const size_t ins_paletteCandidatePerBone = 8;
+static const size_t ins_paletteCandidatePerSearch = 64;
+
+static fbx_vector<_BonePalette> ins_palettes;
+static fbx_unordered_map<_BoneSetKey, unsigned int, CustomHasher<_BoneSetKey>> ins_paletteFinder;
+static fbx_vector<UintContainer> ins_paletteBoneUsers; // bone id to palettes
+static UintContainer ins_paletteBoneDeadUsers; // dead palettes left in ins_paletteBoneUsers
+static std::priority_queue<_BonePaletteMerge, fbx_vector<_BonePaletteMerge>> ins_paletteMerges;
+static UintContainer ins_paletteVisitStamp;
+static _BoneBitset ins_paletteSearchBones;
+static UintContainer ins_tmpBones;
+
+static inline size_t ins_countSharedBones(const UintContainer& lhs, const UintContainer& rhs){
+    size_t shared = 0u;
+    for(auto itL = lhs.cbegin(), itR = rhs.cbegin(); (itL != lhs.cend()) && (itR != rhs.cend());){
+        if(*itL < *itR)
+            ++itL;
+        else if(*itR < *itL)
+            ++itR;
+        else{
+            ++shared;
+            ++itL;
+            ++itR;
+        }
+    }
+    return shared;
+}
+
+static void ins_pushPaletteMerge(unsigned int idxPalette, unsigned int stamp, size_t maxBoneCount){
+    const auto& iPalette = ins_palettes[idxPalette];
+
+    _BonePaletteMerge bestMerge;
+    bool bFound = false;
+
+    for(const auto idxBone : iPalette.bones)
+        ins_setBone(ins_paletteSearchBones, idxBone);
+
+    size_t searchCount = 0u;
+    for(const auto idxBone : iPalette.bones){
+        const auto& iUsers = ins_paletteBoneUsers[idxBone];
+
+        // recently merged palettes are at the back
+        size_t candidateCount = 0u;
+        for(auto itUser = iUsers.crbegin(); (itUser != iUsers.crend()) && (candidateCount < ins_paletteCandidatePerBone) && (searchCount < ins_paletteCandidatePerSearch); ++itUser){
+            const auto idxOther = *itUser;
+            if(idxOther == idxPalette)
+                continue;
+            if(ins_paletteVisitStamp[idxOther] == stamp)
+                continue;
+            ins_paletteVisitStamp[idxOther] = stamp;
+
+            const auto& iOther = ins_palettes[idxOther];
+            if(!iOther.alive)
+                continue;
+            ++candidateCount;
+            ++searchCount;
+
+            size_t shared = 0u;
+            for(const auto idxOtherBone : iOther.bones){
+                if(ins_testBone(ins_paletteSearchBones, idxOtherBone))
+                    ++shared;
+            }
+            const auto united = iPalette.bones.size() + iOther.bones.size() - shared;
+            if(united > maxBoneCount)
+                continue;
+
+            _BonePaletteMerge newMerge;
+            newMerge.score = float(shared) / float(united);
+            newMerge.shared = (unsigned int)shared;
+            newMerge.owner = idxPalette;
+            newMerge.other = idxOther;
+            newMerge.ownerVersion = iPalette.version;
+            newMerge.otherVersion = iOther.version;
+
+            if((!bFound) || (bestMerge < newMerge)){
+                bestMerge = newMerge;
+                bFound = true;
+            }
+        }
+    }
+
+    for(const auto idxBone : iPalette.bones)
+        ins_paletteSearchBones[idxBone >> 6] = 0ull;
+
+    if(bFound)
+        ins_paletteMerges.emplace(std::move(bestMerge));
+}
+
+static inline void ins_mergePalette(unsigned int idxDest, unsigned int idxSrc){
+    auto& iDest = ins_palettes[idxDest];
+    auto& iSrc = ins_palettes[idxSrc];
+
+    // only bones new to the destination need to learn about it
+    ins_tmpBones.clear();
+    std::set_difference(iSrc.bones.cbegin(), iSrc.bones.cend(), iDest.bones.cbegin(), iDest.bones.cend(), std::back_inserter(ins_tmpBones));
+    for(const auto idxBone : ins_tmpBones)
+        ins_paletteBoneUsers[idxBone].emplace_back(idxDest);
+
+    ins_tmpBones.clear();
+    std::set_union(iDest.bones.cbegin(), iDest.bones.cend(), iSrc.bones.cbegin(), iSrc.bones.cend(), std::back_inserter(ins_tmpBones));
+    std::swap(iDest.bones, ins_tmpBones);
+
+    if(iDest.polyIndices.size() < iSrc.polyIndices.size())
+        std::swap(iDest.polyIndices, iSrc.polyIndices);
+    iDest.polyIndices.insert(iDest.polyIndices.end(), iSrc.polyIndices.cbegin(), iSrc.polyIndices.cend());
+    ++iDest.version;
+
+    // lists are compacted once dead palettes take half of them, so searching candidates doesn't walk over the dead ones
+    for(const auto idxBone : iSrc.bones){
+        auto& iUsers = ins_paletteBoneUsers[idxBone];
+        auto& iDeadUsers = ins_paletteBoneDeadUsers[idxBone];
+
+        if(((++iDeadUsers) << 1) > iUsers.size()){
+            iUsers.erase(std::remove_if(iUsers.begin(), iUsers.end(), [idxSrc](unsigned int idxUser){
+                return (idxUser == idxSrc) || (!ins_palettes[idxUser].alive);
+            }), iUsers.end());
+            iDeadUsers = 0u;
+        }
+    }
+
+    iSrc.alive = false;
+    iSrc.bones.clear();
+    iSrc.polyIndices.clear();
+}
+
+static void ins_genPartitionedSkinnedMeshAttribute(NodeData* pNodeData, size_t maxBoneCount){
+    const auto wordCount = (ins_bones.size() + 63) >> 6;
+
+    ins_meshPolys.clear();
+    for(const auto& idxKey : ins_materialKeyOrder){
+        const auto& iAttr = ins_tmpMeshPolys[idxKey];
+
+        ins_palettes.clear();
+        ins_paletteFinder.clear();
+        ins_paletteBoneUsers.resize(ins_bones.size());
+        for(auto& iUsers : ins_paletteBoneUsers)
+            iUsers.clear();
+        ins_paletteBoneDeadUsers.assign(ins_bones.size(), 0u);
+        ins_paletteSearchBones.assign(wordCount, 0ull);
+        ins_paletteMerges = decltype(ins_paletteMerges)();
+
+        _BoneSetKey newKey;
+        for(const auto& idxPoly : iAttr){
+            ins_gatherPolyBones(pNodeData, idxPoly);
+            newKey.bones.assign(ins_polyBones.cbegin(), ins_polyBones.cend());
+
+            auto res = ins_paletteFinder.emplace(newKey, (unsigned int)ins_palettes.size());
+            if(res.second){
+                _BonePalette newPalette;
+                newPalette.bones = ins_polyBones;
+                newPalette.version = 0u;
+                newPalette.alive = true;
+                ins_palettes.emplace_back(std::move(newPalette));
+
+                for(const auto idxBone : ins_polyBones)
+                    ins_paletteBoneUsers[idxBone].emplace_back(res.first->second);
+            }
+
+            ins_palettes[res.first->second].polyIndices.emplace_back(idxPoly);
+        }
+
+        ins_paletteVisitStamp.assign(ins_palettes.size(), 0u);
+        unsigned int stamp = 0u;
 
-                itrCurPoly = ins_meshPolys.emplace(iAttr.first, std::move(newPolyVal));
+        for(auto edxPalette = (unsigned int)ins_palettes.size(), idxPalette = 0u; idxPalette < edxPalette; ++idxPalette)
+            ins_pushPaletteMerge(idxPalette, ++stamp, maxBoneCount);
 
-                std::swap(itrCurPoly->second.participatedClusters, ins_localClusterCounterChecker[1]);
+        while(!ins_paletteMerges.empty()){
+            const auto iMerge = ins_paletteMerges.top();
+            ins_paletteMerges.pop();
+
+            // a changed owner has already queued a fresh candidate. a changed partner makes the owner search again
+            const auto& iOwner = ins_palettes[iMerge.owner];
+            if((!iOwner.alive) || (iOwner.version != iMerge.ownerVersion))
+                continue;
+
+            const auto& iOther = ins_palettes[iMerge.other];
+            if((!iOther.alive) || (iOther.version != iMerge.otherVersion)){
+                ins_pushPaletteMerge(iMerge.owner, ++stamp, maxBoneCount);
+                continue;
+            }
+
+            ins_mergePalette(iMerge.owner, iMerge.other);
+            ins_pushPaletteMerge(iMerge.owner, ++stamp, maxBoneCount);
+        }
+
+        { // palettes without any shared bone are packed by first-fit decreasing
+            UintContainer order;
+            for(auto edxPalette = (unsigned int)ins_palettes.size(), idxPalette = 0u; idxPalette < edxPalette; ++idxPalette){
+                if(ins_palettes[idxPalette].alive)
+                    order.emplace_back(idxPalette);
+            }
+            std::stable_sort(order.begin(), order.end(), [](unsigned int lhs, unsigned int rhs){
+                return ins_palettes[lhs].bones.size() > ins_palettes[rhs].bones.size();
+            });
+
+            UintContainer bins;
+            for(const auto idxPalette : order){
+                bool bMerged = false;
+                for(const auto idxBin : bins){
+                    const auto& iBin = ins_palettes[idxBin];
+                    const auto& iPalette = ins_palettes[idxPalette];
+
+                    const auto united = iBin.bones.size() + iPalette.bones.size() - ins_countSharedBones(iBin.bones, iPalette.bones);
+                    if(united <= maxBoneCount){
+                        ins_mergePalette(idxBin, idxPalette);
+                        bMerged = true;
+                        break;
+                    }
+                }
+                if(!bMerged)
+                    bins.emplace_back(idxPalette);
             }
         }
+
+        // keeps the original polygon order inside of each palette, and orders palettes by their first polygon
+        UintContainer order;
+        for(auto edxPalette = (unsigned int)ins_palettes.size(), idxPalette = 0u; idxPalette < edxPalette; ++idxPalette){
+            auto& iPalette = ins_palettes[idxPalette];
+            if(!iPalette.alive)
+                continue;
+
+            std::sort(iPalette.polyIndices.begin(), iPalette.polyIndices.end());
+            order.emplace_back(idxPalette);
+        }
+        std::sort(order.begin(), order.end(), [](unsigned int lhs, unsigned int rhs){
+            return ins_palettes[lhs].polyIndices.front() < ins_palettes[rhs].polyIndices.front();
+        });
+
+        for(const auto idxPalette : order){
+            auto& iPalette = ins_palettes[idxPalette];
+
+            _MeshPolyValue newPolyVal;
+            newPolyVal.participatedBones.assign(wordCount, 0ull);
+            for(const auto idxBone : iPalette.bones)
+                ins_setBone(newPolyVal.participatedBones, idxBone);
+            newPolyVal.boneCount = iPalette.bones.size();
+            newPolyVal.polyIndices = std::move(iPalette.polyIndices);
+
+            ins_meshPolys.emplace_back(idxKey, std::move(newPolyVal));
+        }
     }
 }
 
@@ -175,43 +540,38 @@ static void ins_rearrangeMesh(NodeData* pNodeData){
     pNodeData->bufBoneCombination.clear();
     pNodeData->bufBoneCombination.reserve(ins_meshPolys.size());
 
-    size_t idxAttr = 0u;
-    for(auto itAttr = ins_meshPolys.begin(), etAttr = ins_meshPolys.end(); itAttr != etAttr; ++itAttr, ++idxAttr){
-        const auto& iAttr = *itAttr;
+    for(auto edxAttr = (unsigned int)ins_meshPolys.size(), idxAttr = 0u; idxAttr < edxAttr; ++idxAttr){
+        const auto& iAttr = ins_meshPolys[idxAttr];
+        const auto& iKey = ins_materialKeys[iAttr.first];
+
         MeshAttributeElement meshAttribute;
         meshAttribute.PolygonFirst = decltype(meshAttribute.PolygonFirst)(ins_bufIndices.size());
         meshAttribute.VertexFirst = decltype(meshAttribute.VertexFirst)(ins_vertNewToOld.size());
 
-        _OrderdKeyWithIndex newOrderKey;
-        newOrderKey.layers = iAttr.first.layers;
-        newOrderKey.attribute = idxAttr;
-
         for(const auto& idxOldPoly : iAttr.second.polyIndices){
             const auto& iOldPoly = pNodeData->bufIndices[idxOldPoly];
             Uint3 iNewPoly;
 
+            // each attribute owns its own copy of the vertices it references
             for(size_t idxVert = 0u; idxVert < 3u; ++idxVert){
                 const auto& idxOldVert = iOldPoly.raw[idxVert];
                 auto& idxNewVert = iNewPoly.raw[idxVert];
 
-                newOrderKey.index = idxOldVert;
-                auto f = ins_vertOldToNew.find(newOrderKey);
-                if(f == ins_vertOldToNew.end()){
-                    idxNewVert = (unsigned int)ins_vertNewToOld.size();
+                if(ins_vertAttrStamp[idxOldVert] != idxAttr){
+                    ins_vertAttrStamp[idxOldVert] = idxAttr;
+                    ins_vertOldToNew[idxOldVert] = (unsigned int)ins_vertNewToOld.size();
                     ins_vertNewToOld.emplace_back(idxOldVert);
-                    ins_vertOldToNew.emplace(newOrderKey, idxNewVert);
                 }
-                else
-                    idxNewVert = f->second;
+                idxNewVert = ins_vertOldToNew[idxOldVert];
             }
 
             ins_bufIndices.emplace_back(std::move(iNewPoly));
 
-            if(!iAttr.first.layers.empty()){
+            if(!iKey.layers.empty()){
                 for(auto edxLayer = (unsigned int)pNodeData->bufLayers.size(), idxLayer = 0u; idxLayer < edxLayer; ++idxLayer){
                     const auto& iOldMaterial = pNodeData->bufLayers[idxLayer].materials;
                     if(!iOldMaterial.empty()){
-                        const auto& idxOldMaterial = iAttr.first.layers[idxLayer];
+                        const auto& idxOldMaterial = iKey.layers[idxLayer];
                         auto& iNewMaterial = ins_bufLayers[idxLayer].materials;
 
                         iNewMaterial.emplace_back(idxOldMaterial);
@@ -226,41 +586,13 @@ static void ins_rearrangeMesh(NodeData* pNodeData){
         pNodeData->bufMeshAttribute.emplace_back(std::move(meshAttribute));
     }
 
-    for(const auto& idxOldVert : ins_vertNewToOld)
-        ins_bufPositions.emplace_back(pNodeData->bufPositions[idxOldVert]);
-
-    for(auto edxLayer = (unsigned int)pNodeData->bufLayers.size(), idxLayer = 0u; idxLayer < edxLayer; ++idxLayer){
-        const auto& iOldLayer = pNodeData->bufLayers[idxLayer];
-        auto& iNewLayer = ins_bufLayers[idxLayer];
-
-        if(!iOldLayer.colors.empty()){
-            for(const auto& idxOldVert : ins_vertNewToOld)
-                iNewLayer.colors.emplace_back(iOldLayer.colors[idxOldVert]);
-        }
-        if(!iOldLayer.normals.empty()){
-            for(const auto& idxOldVert : ins_vertNewToOld)
-                iNewLayer.normals.emplace_back(iOldLayer.normals[idxOldVert]);
-        }
-        if(!iOldLayer.binormals.empty()){
-            for(const auto& idxOldVert : ins_vertNewToOld)
-                iNewLayer.binormals.emplace_back(iOldLayer.binormals[idxOldVert]);
-        }
-        if(!iOldLayer.tangents.empty()){
-            for(const auto& idxOldVert : ins_vertNewToOld)
-                iNewLayer.tangents.emplace_back(iOldLayer.tangents[idxOldVert]);
-        }
-        if(!iOldLayer.texcoords.table.empty()){
-            for(const auto& idxOldVert : ins_vertNewToOld)
-                iNewLayer.texcoords.table.emplace_back(iOldLayer.texcoords.table[idxOldVert]);
-        }
-    }
+    // vertex data itself is gathered from the optimizer records by SHRStoreOptimizedMesh using this order
+    pNodeData->bufVertexOrder.assign(ins_vertNewToOld.cbegin(), ins_vertNewToOld.cend());
 
     if(!pNodeData->bufSkinData.empty()){
         for(const auto& iAttr : ins_meshPolys){
             BoneCombination boneCombination;
-            boneCombination.reserve(iAttr.second.participatedClusters.size());
-            for(auto* iCluster : iAttr.second.participatedClusters)
-                boneCombination.emplace_back(iCluster);
+            ins_storeBoneCombination(boneCombination, iAttr.second);
 
             pNodeData->bufBoneCombination.emplace_back(std::move(boneCombination));
         }
@@ -271,27 +603,96 @@ static void ins_rearrangeMesh(NodeData* pNodeData){
 }
 
 
-void SHRGenerateMeshAttribute(NodeData* pNodeData){
-    ins_genTempMeshAttribute(pNodeData);
+// returns the attribute count the polygon order partitioning made
+static size_t ins_genSkinnedPartition(NodeData* pNodeData, size_t maxBoneCount){
+    ins_genSkinnedMeshAttribute(pNodeData, maxBoneCount);
+
+    const auto greedyCount = ins_meshPolys.size();
+    if(shr_ioSetting.MinimizeBoneCombination){
+        // the greedy result is kept whenever partitioning can't beat it
+        auto greedyPolys = std::move(ins_meshPolys);
+        ins_genPartitionedSkinnedMeshAttribute(pNodeData, maxBoneCount);
+        if(ins_meshPolys.size() >= greedyCount)
+            ins_meshPolys = std::move(greedyPolys);
+    }
 
+    return greedyCount;
+}
+
+// extra budgets are partitioned over the already rearranged polygons, so they can share vertices with the main partition
+static void ins_genBoneBudgets(NodeData* pNodeData){
+    pNodeData->bufBoneBudgets.clear();
     if(pNodeData->bufSkinData.empty())
+        return;
+
+    bool bInterned = false;
+    for(unsigned long idxBudget = 0; idxBudget < shr_ioSetting.ExtraBoneBudgetCount; ++idxBudget){
+        const auto maxBoneCount = shr_ioSetting.ExtraBoneCountPerMesh[idxBudget];
+
+        if(!bInterned){
+            ins_genTempMeshAttribute(pNodeData);
+            ins_internBones(pNodeData);
+            bInterned = true;
+        }
+
+        ins_genSkinnedPartition(pNodeData, maxBoneCount);
+
+        BoneBudgetData newBudget;
+        newBudget.maxBoneCount = maxBoneCount;
+        newBudget.bufMeshAttribute.reserve(ins_meshPolys.size());
+        newBudget.bufPolygonOrder.reserve(pNodeData->bufIndices.size());
+        newBudget.bufBoneCombination.reserve(ins_meshPolys.size());
+
+        for(const auto& iAttr : ins_meshPolys){
+            MeshAttributeElement meshAttribute;
+            meshAttribute.PolygonFirst = decltype(meshAttribute.PolygonFirst)(newBudget.bufPolygonOrder.size());
+            newBudget.bufPolygonOrder.insert(newBudget.bufPolygonOrder.end(), iAttr.second.polyIndices.cbegin(), iAttr.second.polyIndices.cend());
+            meshAttribute.PolygonLast = decltype(meshAttribute.PolygonLast)(newBudget.bufPolygonOrder.size() - 1u);
+
+            // vertex ranges are decided by SHRStoreBoneBudgets, since vertices can still be split after this
+            meshAttribute.VertexFirst = 0;
+            meshAttribute.VertexLast = 0;
+
+            newBudget.bufMeshAttribute.emplace_back(std::move(meshAttribute));
+
+            BoneCombination boneCombination;
+            ins_storeBoneCombination(boneCombination, iAttr.second);
+
+            newBudget.bufBoneCombination.emplace_back(std::move(boneCombination));
+        }
+
+        pNodeData->bufBoneBudgets.emplace_back(std::move(newBudget));
+    }
+}
+
+
+void SHRGenerateMeshAttribute(NodeData* pNodeData, size_t* pGreedyCount){
+    ins_genTempMeshAttribute(pNodeData);
+
+    size_t greedyCount;
+    if(pNodeData->bufSkinData.empty()){
         ins_genMeshAttribute(pNodeData);
-    else
-        ins_genSkinnedMeshAttribute(pNodeData);
+        greedyCount = ins_meshPolys.size();
+    }
+    else{
+        ins_internBones(pNodeData);
+        greedyCount = ins_genSkinnedPartition(pNodeData, shr_ioSetting.MaxBoneCountPerMesh);
+    }
+
+    if(pGreedyCount)
+        (*pGreedyCount) = greedyCount;
 
     {
-        const auto vertReserveSize = pNodeData->bufPositions.size() << 1;
+        const auto vertCount = SHRGetOptimizedVertexCount();
+        const auto vertReserveSize = vertCount << 1;
         const auto indReserveSize = pNodeData->bufIndices.size();
 
-        ins_vertOldToNew.clear();
-        ins_vertOldToNew.rehash(vertReserveSize << 1);
+        ins_vertAttrStamp.assign(vertCount, (unsigned int)-1);
+        ins_vertOldToNew.resize(vertCount);
 
         ins_vertNewToOld.clear();
         ins_vertNewToOld.reserve(vertReserveSize);
 
-        ins_bufPositions.clear();
-        ins_bufPositions.reserve(vertReserveSize);
-
         ins_bufIndices.clear();
         ins_bufIndices.reserve(indReserveSize);
 
@@ -304,21 +705,7 @@ void SHRGenerateMeshAttribute(NodeData* pNodeData){
             lhsLayer.materials.clear();
             lhsLayer.materials.reserve(indReserveSize);
 
-            lhsLayer.colors.clear();
-            lhsLayer.colors.reserve(vertReserveSize);
-
-            lhsLayer.normals.clear();
-            lhsLayer.normals.reserve(vertReserveSize);
-
-            lhsLayer.binormals.clear();
-            lhsLayer.binormals.reserve(vertReserveSize);
-
-            lhsLayer.tangents.clear();
-            lhsLayer.tangents.reserve(vertReserveSize);
-
             lhsLayer.texcoords.name = std::move(rhsLayer.texcoords.name);
-            lhsLayer.texcoords.table.clear();
-            lhsLayer.texcoords.table.reserve(vertReserveSize);
         }
 
         ins_bufSkinData.clear();
@@ -328,9 +715,70 @@ void SHRGenerateMeshAttribute(NodeData* pNodeData){
     ins_rearrangeMesh(pNodeData);
 
     {
-        std::swap(pNodeData->bufPositions, ins_bufPositions);
         std::swap(pNodeData->bufIndices, ins_bufIndices);
         std::swap(pNodeData->bufLayers, ins_bufLayers);
         std::swap(pNodeData->bufSkinData, ins_bufSkinData);
     }
+
+    ins_genBoneBudgets(pNodeData);
+}
+
+// must be called after the vertices of pMesh are finalized. indices are picked up from pMesh->Indices polygon by polygon,
+// so vertex splitting done on pMesh after SHRStoreOptimizedMesh is also reflected. bone combinations are only allocated
+void SHRStoreBoneBudgets(const NodeData* pNodeData, FBXSkinnedMesh* pMesh){
+    pMesh->BoneBudgets.Assign(pNodeData->bufBoneBudgets.size());
+    for(size_t idxBudget = 0u; idxBudget < pMesh->BoneBudgets.Length; ++idxBudget){
+        auto& iBudget = pMesh->BoneBudgets.Values[idxBudget];
+        const auto& nodeBudget = pNodeData->bufBoneBudgets[idxBudget];
+
+        iBudget.MaxBoneCount = nodeBudget.maxBoneCount;
+
+        iBudget.Indices.Assign(nodeBudget.bufPolygonOrder.size());
+        for(size_t idxInd = 0u; idxInd < iBudget.Indices.Length; ++idxInd)
+            iBudget.Indices.Values[idxInd] = pMesh->Indices.Values[nodeBudget.bufPolygonOrder[idxInd]];
+
+        iBudget.Attributes.Assign(nodeBudget.bufMeshAttribute.size());
+        for(size_t idxAttr = 0u; idxAttr < iBudget.Attributes.Length; ++idxAttr){
+            const auto& iOldAttr = nodeBudget.bufMeshAttribute[idxAttr];
+            auto& iNewAttr = iBudget.Attributes.Values[idxAttr];
+
+            iNewAttr.IndexStart = iOldAttr.PolygonFirst;
+            iNewAttr.IndexCount = 1 + iOldAttr.PolygonLast - iOldAttr.PolygonFirst;
+
+            // vertices of an attribute aren't contiguous here, so the range covers every vertex the attribute references
+            auto vertFirst = (unsigned long)-1;
+            auto vertLast = 0ul;
+            for(const auto* iInd = iBudget.Indices.Values + iNewAttr.IndexStart; FBX_PTRDIFFU(iInd - iBudget.Indices.Values) <= iOldAttr.PolygonLast; ++iInd){
+                for(const auto& idxVert : iInd->Values){
+                    if(idxVert < vertFirst)
+                        vertFirst = idxVert;
+                    if(idxVert > vertLast)
+                        vertLast = idxVert;
+                }
+            }
+
+            iNewAttr.VertexStart = vertFirst;
+            iNewAttr.VertexCount = 1 + vertLast - vertFirst;
+        }
+
+        iBudget.Materials.Assign(pNodeData->bufLayers.size());
+        for(size_t idxLayer = 0u; idxLayer < iBudget.Materials.Length; ++idxLayer){
+            auto& iObject = iBudget.Materials.Values[idxLayer];
+            const auto& nodeObject = pNodeData->bufLayers[idxLayer].materials;
+
+            if(nodeObject.empty())
+                iObject.Assign(0u);
+            else{
+                iObject.Assign(iBudget.Attributes.Length);
+                for(size_t idxMat = 0u; idxMat < iObject.Length; ++idxMat){
+                    const auto idxOldMat = nodeBudget.bufPolygonOrder[iBudget.Attributes.Values[idxMat].IndexStart];
+                    iObject.Values[idxMat] = nodeObject[idxOldMat];
+                }
+            }
+        }
+
+        iBudget.BoneCombinations.Assign(nodeBudget.bufBoneCombination.size());
+        for(size_t idxAttr = 0u; idxAttr < iBudget.BoneCombinations.Length; ++idxAttr)
+            iBudget.BoneCombinations.Values[idxAttr].Assign(nodeBudget.bufBoneCombination[idxAttr].size());
+    }
 }
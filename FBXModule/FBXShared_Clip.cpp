@@ -0,0 +1,1862 @@
+﻿/**
+ * @file FBXShared_Clip.cpp
+ * @date 2026/10/19
+ * @author Lim Taewoo (limztudio@gmail.com)
+ */
+
+
+#include "stdafx.h"
+
+#include <algorithm>
+#include <execution>
+
+#include "FBXUtilites.h"
+#include "FBXMath.h"
+#include "FBXShared.h"
+
+
+// tangents of rewritten cubic segments are measured again over this fraction of the segment
+static const float ins_tangentSampleStep = 1.f / 64.f;
+
+
+static inline DirectX::XMVECTOR ins_loadKeyValue(const FBXStaticArray<float, 3>& value){
+    return DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)value.Values);
+}
+static inline DirectX::XMVECTOR ins_loadKeyValue(const FBXStaticArray<float, 4>& value){
+    return DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)value.Values);
+}
+static inline void ins_storeKeyValue(FBXStaticArray<float, 3>& value, DirectX::FXMVECTOR xmm_value){
+    DirectX::XMStoreFloat3((DirectX::XMFLOAT3*)value.Values, xmm_value);
+}
+static inline void ins_storeKeyValue(FBXStaticArray<float, 4>& value, DirectX::FXMVECTOR xmm_value){
+    DirectX::XMStoreFloat4((DirectX::XMFLOAT4*)value.Values, xmm_value);
+}
+
+template<unsigned long N>
+static inline DirectX::XMVECTOR ins_alignKeyValue(DirectX::FXMVECTOR xmm_value, DirectX::FXMVECTOR xmm_reference){
+    if constexpr(N == 4){
+        if(DirectX::XMVectorGetX(DirectX::XMVector4Dot(xmm_value, xmm_reference)) < 0.f)
+            return DirectX::XMVectorNegate(xmm_value);
+    }
+    return xmm_value;
+}
+
+
+template<unsigned long N>
+static inline bool ins_hasCubicKey(const FBXDynamicArray<FBXAnimationKeyFrame<FBXStaticArray<float, N>>>& keys){
+    for(const auto* pKey = keys.Values; FBX_PTRDIFFU(pKey - keys.Values) < keys.Length; ++pKey){
+        if(pKey->InterpolationType == FBXAnimationInterpolationType::FBXAnimationInterpolationType_Cubic)
+            return true;
+    }
+    return false;
+}
+
+// overwrites Local or World of every key with fnSample(time), and its tangents if the track has a cubic key. Time and InterpolationType of keys must be set already.
+// fnSample may read the keys being rewritten, since nothing is stored until every key is evaluated
+template<unsigned long N, typename FUNC>
+static void ins_rewriteTrack(FBXDynamicArray<FBXAnimationKeyFrame<FBXStaticArray<float, N>>>& keys, FBXDynamicArray<FBXAnimationKeyTangent<FBXStaticArray<float, N>>>& tangents, bool bWorld, FUNC&& fnSample){
+    using KeyFrame = FBXAnimationKeyFrame<FBXStaticArray<float, N>>;
+    using KeyTangent = FBXAnimationKeyTangent<FBXStaticArray<float, N>>;
+
+    const auto member = bWorld ? &KeyFrame::World : &KeyFrame::Local;
+    const auto tangentMember = bWorld ? &KeyTangent::World : &KeyTangent::Local;
+
+    fbx_vector<DirectX::XMFLOAT4> values(keys.Length);
+    fbx_vector<DirectX::XMFLOAT4> inTangents(keys.Length);
+    fbx_vector<DirectX::XMFLOAT4> outTangents(keys.Length);
+
+    auto xmm_prev = DirectX::XMQuaternionIdentity();
+    for(size_t idxKey = 0u; idxKey < keys.Length; ++idxKey){
+        const auto& kKey = keys.Values[idxKey];
+
+        auto xmm_value = ins_alignKeyValue<N>(fnSample(kKey.Time), xmm_prev);
+        xmm_prev = xmm_value;
+
+        auto xmm_in = DirectX::XMVectorZero();
+        auto xmm_out = DirectX::XMVectorZero();
+
+        if(idxKey && (keys.Values[idxKey - 1].InterpolationType == FBXAnimationInterpolationType::FBXAnimationInterpolationType_Cubic)){
+            const auto fStep = (kKey.Time - keys.Values[idxKey - 1].Time) * ins_tangentSampleStep;
+            auto xmm_sample = ins_alignKeyValue<N>(fnSample(kKey.Time - fStep), xmm_value);
+            xmm_in = DirectX::XMVectorScale(DirectX::XMVectorSubtract(xmm_value, xmm_sample), 1.f / fStep);
+        }
+        if(((idxKey + 1) < keys.Length) && (kKey.InterpolationType == FBXAnimationInterpolationType::FBXAnimationInterpolationType_Cubic)){
+            const auto fStep = (keys.Values[idxKey + 1].Time - kKey.Time) * ins_tangentSampleStep;
+            auto xmm_sample = ins_alignKeyValue<N>(fnSample(kKey.Time + fStep), xmm_value);
+            xmm_out = DirectX::XMVectorScale(DirectX::XMVectorSubtract(xmm_sample, xmm_value), 1.f / fStep);
+        }
+
+        DirectX::XMStoreFloat4(&values[idxKey], xmm_value);
+        DirectX::XMStoreFloat4(&inTangents[idxKey], xmm_in);
+        DirectX::XMStoreFloat4(&outTangents[idxKey], xmm_out);
+    }
+
+    for(size_t idxKey = 0u; idxKey < keys.Length; ++idxKey)
+        ins_storeKeyValue(keys.Values[idxKey].*member, DirectX::XMLoadFloat4(&values[idxKey]));
+
+    if(!ins_hasCubicKey(keys)){
+        tangents.Clear();
+        return;
+    }
+
+    if(tangents.Length != keys.Length)
+        tangents.Assign(keys.Length);
+    for(size_t idxKey = 0u; idxKey < keys.Length; ++idxKey){
+        auto& kTangent = tangents.Values[idxKey].*tangentMember;
+
+        ins_storeKeyValue(kTangent.In, DirectX::XMLoadFloat4(&inTangents[idxKey]));
+        ins_storeKeyValue(kTangent.Out, DirectX::XMLoadFloat4(&outTangents[idxKey]));
+    }
+}
+
+template<unsigned long N>
+static inline DirectX::XMVECTOR ins_sampleTrack(const FBXDynamicArray<FBXAnimationKeyFrame<FBXStaticArray<float, N>>>& keys, const FBXDynamicArray<FBXAnimationKeyTangent<FBXStaticArray<float, N>>>& tangents, bool bWorld, unsigned long& cursor, float time){
+    time = std::clamp(time, keys.Values[0].Time, keys.Values[keys.Length - 1].Time);
+
+    // rewriting mostly asks for the key times themselves
+    cursor = FindAnimationKey(keys, time, cursor);
+    if(keys.Values[cursor].Time == time)
+        return ins_loadKeyValue(bWorld ? keys.Values[cursor].World : keys.Values[cursor].Local);
+
+    float value[N];
+    if(bWorld)
+        ComputeWorldKeyByTime(value, time, &keys, &tangents, &cursor);
+    else
+        ComputeLocalKeyByTime(value, time, &keys, &tangents, &cursor);
+
+    if constexpr(N == 4)
+        return DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)value);
+    else
+        return DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)value);
+}
+
+// keeps the keys at keptKeys and their tangents. tangents are dropped once no cubic key is left
+template<unsigned long N>
+static void ins_keepKeys(FBXDynamicArray<FBXAnimationKeyFrame<FBXStaticArray<float, N>>>& keys, FBXDynamicArray<FBXAnimationKeyTangent<FBXStaticArray<float, N>>>& tangents, const fbx_vector<unsigned long>& keptKeys){
+    FBXDynamicArray<FBXAnimationKeyFrame<FBXStaticArray<float, N>>> newKeys;
+    newKeys.Assign(keptKeys.size());
+    for(size_t idxKey = 0u; idxKey < keptKeys.size(); ++idxKey)
+        newKeys.Values[idxKey] = keys.Values[keptKeys[idxKey]];
+
+    keys = std::move(newKeys);
+
+    if(!tangents.Length)
+        return;
+    if(!ins_hasCubicKey(keys)){
+        tangents.Clear();
+        return;
+    }
+
+    FBXDynamicArray<FBXAnimationKeyTangent<FBXStaticArray<float, N>>> newTangents;
+    newTangents.Assign(keptKeys.size());
+    for(size_t idxKey = 0u; idxKey < keptKeys.size(); ++idxKey)
+        newTangents.Values[idxKey] = tangents.Values[keptKeys[idxKey]];
+
+    tangents = std::move(newTangents);
+}
+
+static inline DirectX::XMMATRIX ins_composeTransform(const Float3& scale, const Float4& rotation, const Float3& translation){
+    return DirectX::XMMatrixAffineTransformation(
+        DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)scale.raw),
+        DirectX::XMVectorZero(),
+        DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)rotation.raw),
+        DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)translation.raw)
+    );
+}
+
+
+// twist of the quaternion around the unit axis
+static inline DirectX::XMVECTOR ins_extractTwist(DirectX::FXMVECTOR xmm_rotation, DirectX::FXMVECTOR xmm_axis){
+    auto xmm_twist = DirectX::XMVectorMultiply(xmm_axis, DirectX::XMVector3Dot(xmm_rotation, xmm_axis));
+    xmm_twist = DirectX::XMVectorSelect(xmm_rotation, xmm_twist, DirectX::g_XMSelect1110);
+
+    // half turn swing. twist is undefined, so nothing is taken
+    if(DirectX::XMVectorGetX(DirectX::XMVector4LengthSq(xmm_twist)) < 1e-12f)
+        return DirectX::XMQuaternionIdentity();
+
+    return DirectX::XMQuaternionNormalize(xmm_twist);
+}
+
+
+// splits local transform of the root node into the motion and the rest, so that rest composed under motion gives the source back.
+// rotation = rest * yaw, translation = yaw(restTranslation) + motionTranslation
+class _RootMotionSplitter{
+public:
+    _RootMotionSplitter(const FBXAnimationNode& source, FBXRootMotionFlag flags)
+        :
+        source(source)
+    {
+        const auto translationMask = (unsigned long)flags & (unsigned long)FBXRootMotionFlag::FBXRootMotionFlag_Translation_Mask;
+        xmm_translationMask = DirectX::XMVectorSelectControl(
+            (translationMask & (unsigned long)FBXRootMotionFlag::FBXRootMotionFlag_TranslationX) ? 1 : 0,
+            (translationMask & (unsigned long)FBXRootMotionFlag::FBXRootMotionFlag_TranslationY) ? 1 : 0,
+            (translationMask & (unsigned long)FBXRootMotionFlag::FBXRootMotionFlag_TranslationZ) ? 1 : 0,
+            0
+        );
+
+        bYaw = true;
+        switch((FBXRootMotionFlag)((unsigned long)flags & (unsigned long)FBXRootMotionFlag::FBXRootMotionFlag_Yaw_Mask)){
+        case FBXRootMotionFlag::FBXRootMotionFlag_Yaw_XAxis:
+            xmm_yawAxis = DirectX::g_XMIdentityR0;
+            break;
+        case FBXRootMotionFlag::FBXRootMotionFlag_Yaw_YAxis:
+            xmm_yawAxis = DirectX::g_XMIdentityR1;
+            break;
+        case FBXRootMotionFlag::FBXRootMotionFlag_Yaw_ZAxis:
+            xmm_yawAxis = DirectX::g_XMIdentityR2;
+            break;
+        default:
+            xmm_yawAxis = DirectX::XMVectorZero();
+            bYaw = false;
+            break;
+        }
+    }
+
+
+public:
+    inline void sampleSource(Float3& scale, Float4& rotation, Float3& translation, FBXAnimationCursor& cursor, float time)const{
+        ComputeLocalTransformByTime(&scale, &rotation, &translation, &source, &cursor, time);
+    }
+    inline void sampleSourceWorld(Float3& scale, Float4& rotation, Float3& translation, FBXAnimationCursor& cursor, float time)const{
+        ComputeWorldTransformByTime(&scale, &rotation, &translation, &source, &cursor, time);
+    }
+
+    void split(
+        DirectX::XMVECTOR& xmm_yaw,
+        DirectX::XMVECTOR& xmm_motionTranslation,
+        DirectX::XMVECTOR& xmm_restRotation,
+        DirectX::XMVECTOR& xmm_restTranslation,
+        const Float4& rotation,
+        const Float3& translation
+    )const{
+        const auto xmm_rotation = DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)rotation.raw);
+        const auto xmm_translation = DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)translation.raw);
+
+        xmm_yaw = bYaw ? ins_extractTwist(xmm_rotation, xmm_yawAxis) : DirectX::XMQuaternionIdentity();
+        xmm_motionTranslation = DirectX::XMVectorSelect(DirectX::XMVectorZero(), xmm_translation, xmm_translationMask);
+
+        const auto xmm_yawInv = DirectX::XMQuaternionConjugate(xmm_yaw);
+        xmm_restRotation = DirectX::XMQuaternionNormalize(DirectX::XMQuaternionMultiply(xmm_rotation, xmm_yawInv));
+        xmm_restTranslation = DirectX::XMVector3Rotate(DirectX::XMVectorSubtract(xmm_translation, xmm_motionTranslation), xmm_yawInv);
+    }
+
+    // world transforms of the root node and its descendants are multiplied by this from the right.
+    // sourceWorld^-1 * restLocal * sourceLocal^-1 * sourceWorld
+    DirectX::XMMATRIX worldDelta(FBXAnimationCursor& localCursor, FBXAnimationCursor& worldCursor, float time)const{
+        Float3 localScale, localTranslation, worldScale, worldTranslation;
+        Float4 localRotation, worldRotation;
+
+        sampleSource(localScale, localRotation, localTranslation, localCursor, time);
+        sampleSourceWorld(worldScale, worldRotation, worldTranslation, worldCursor, time);
+
+        DirectX::XMVECTOR xmm_yaw, xmm_motionTranslation, xmm_restRotation, xmm_restTranslation;
+        split(xmm_yaw, xmm_motionTranslation, xmm_restRotation, xmm_restTranslation, localRotation, localTranslation);
+
+        const auto xmm4_sourceLocal = ins_composeTransform(localScale, localRotation, localTranslation);
+        const auto xmm4_sourceWorld = ins_composeTransform(worldScale, worldRotation, worldTranslation);
+        const auto xmm4_restLocal = DirectX::XMMatrixAffineTransformation(
+            DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)localScale.raw),
+            DirectX::XMVectorZero(),
+            xmm_restRotation,
+            xmm_restTranslation
+        );
+
+        auto xmm4_ret = DirectX::XMMatrixInverse(nullptr, xmm4_sourceWorld);
+        xmm4_ret = DirectX::XMMatrixMultiply(xmm4_ret, xmm4_restLocal);
+        xmm4_ret = DirectX::XMMatrixMultiply(xmm4_ret, DirectX::XMMatrixInverse(nullptr, xmm4_sourceLocal));
+        xmm4_ret = DirectX::XMMatrixMultiply(xmm4_ret, xmm4_sourceWorld);
+        return xmm4_ret;
+    }
+
+
+public:
+    const FBXAnimationNode& source;
+
+    DirectX::XMVECTOR xmm_translationMask;
+    DirectX::XMVECTOR xmm_yawAxis;
+    bool bYaw;
+};
+
+
+template<unsigned long N>
+static void ins_fillBindKey(FBXDynamicArray<FBXAnimationKeyFrame<FBXStaticArray<float, N>>>& keys, FBXDynamicArray<FBXAnimationKeyTangent<FBXStaticArray<float, N>>>& tangents, DirectX::FXMVECTOR xmm_local, DirectX::FXMVECTOR xmm_world){
+    keys.Assign(1);
+    tangents.Clear();
+
+    auto& kKey = keys.Values[0];
+    kKey.Time = 0.f;
+    kKey.InterpolationType = FBXAnimationInterpolationType::FBXAnimationInterpolationType_Linear;
+
+    ins_storeKeyValue(kKey.Local, xmm_local);
+    ins_storeKeyValue(kKey.World, xmm_world);
+}
+
+// yaw of the rest rotation changes the rest translation, so the translation keys of the root node are taken at rotation key times as well
+static void ins_mergeRotationKeyTimes(FBXAnimationNode* pAnimationNode){
+    const auto& rotationKeys = pAnimationNode->RotationKeys;
+    const auto oldKeys = pAnimationNode->TranslationKeys;
+    const auto oldTangents = pAnimationNode->TranslationTangents;
+
+    fbx_vector<float> times;
+    times.reserve(rotationKeys.Length + oldKeys.Length);
+    for(const auto* pKey = oldKeys.Values; FBX_PTRDIFFU(pKey - oldKeys.Values) < oldKeys.Length; ++pKey)
+        times.emplace_back(pKey->Time);
+    for(const auto* pKey = rotationKeys.Values; FBX_PTRDIFFU(pKey - rotationKeys.Values) < rotationKeys.Length; ++pKey)
+        times.emplace_back(pKey->Time);
+
+    std::sort(times.begin(), times.end());
+    times.erase(std::unique(times.begin(), times.end()), times.end());
+
+    if(times.size() == oldKeys.Length)
+        return;
+
+    auto& newKeys = pAnimationNode->TranslationKeys;
+    newKeys.Assign(times.size());
+
+    unsigned long cursor = 0;
+    for(size_t idxKey = 0u; idxKey < times.size(); ++idxKey){
+        auto& kKey = newKeys.Values[idxKey];
+
+        cursor = FindAnimationKey(oldKeys, times[idxKey], cursor);
+
+        kKey.Time = times[idxKey];
+        kKey.InterpolationType = oldKeys.Values[cursor].InterpolationType;
+    }
+
+    unsigned long localCursor = 0;
+    ins_rewriteTrack(newKeys, pAnimationNode->TranslationTangents, false, [&](float time){ return ins_sampleTrack(oldKeys, oldTangents, false, localCursor, time); });
+
+    unsigned long worldCursor = 0;
+    ins_rewriteTrack(newKeys, pAnimationNode->TranslationTangents, true, [&](float time){ return ins_sampleTrack(oldKeys, oldTangents, true, worldCursor, time); });
+}
+
+
+bool SHRExtractRootMotion(FBXAnimation* pAnimation, const FBXNode* pRootNode, FBXRootMotionFlag flags, FBXAnimationNode* pOutRootMotion){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("SHRExtractRootMotion(FBXAnimation*, const FBXNode*, FBXRootMotionFlag, FBXAnimationNode*)");
+
+
+    FBXAnimationNode* pRootAnimationNode = nullptr;
+    for(auto* pNode = pAnimation->AnimationNodes.Values; FBX_PTRDIFFU(pNode - pAnimation->AnimationNodes.Values) < pAnimation->AnimationNodes.Length; ++pNode){
+        if(pNode->BindNode == pRootNode){
+            pRootAnimationNode = pNode;
+            break;
+        }
+    }
+    if(!pRootAnimationNode){
+        SHRPushErrorMessage(FBX_TEXT("root node is not animated by this animation"), __name_of_this_func);
+        return false;
+    }
+
+    // start from the source, so that the split sees bind values wherever a track is missing
+    {
+        Float3 scale, translation;
+        Float4 rotation;
+        ComputeLocalTransformByTime(&scale, &rotation, &translation, pRootAnimationNode, nullptr, 0.f);
+
+        Float3 worldScale, worldTranslation;
+        Float4 worldRotation;
+        ComputeWorldTransformByTime(&worldScale, &worldRotation, &worldTranslation, pRootAnimationNode, nullptr, 0.f);
+
+        if(!pRootAnimationNode->RotationKeys.Length){
+            ins_fillBindKey(
+                pRootAnimationNode->RotationKeys,
+                pRootAnimationNode->RotationTangents,
+                DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)rotation.raw),
+                DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)worldRotation.raw)
+            );
+        }
+        if(!pRootAnimationNode->TranslationKeys.Length){
+            ins_fillBindKey(
+                pRootAnimationNode->TranslationKeys,
+                pRootAnimationNode->TranslationTangents,
+                DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)translation.raw),
+                DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)worldTranslation.raw)
+            );
+        }
+    }
+
+    const auto source = *pRootAnimationNode;
+    _RootMotionSplitter splitter(source, flags);
+
+    if(splitter.bYaw)
+        ins_mergeRotationKeyTimes(pRootAnimationNode);
+
+    { // root motion track. it lives in the parent space of the root node, so Local and World are the same
+        // bind node of the root is kept, so tolerances, world key rebuilding and retargeting see the node the motion is taken from
+        pOutRootMotion->BindNode = pRootAnimationNode->BindNode;
+        pOutRootMotion->HasWorldKeys = true;
+
+        ins_fillBindKey(pOutRootMotion->ScalingKeys, pOutRootMotion->ScalingTangents, DirectX::g_XMOne3, DirectX::g_XMOne3);
+
+        if(splitter.bYaw){
+            pOutRootMotion->RotationKeys = source.RotationKeys;
+            pOutRootMotion->RotationTangents = source.RotationTangents;
+
+            FBXAnimationCursor cursor;
+            ins_rewriteTrack(pOutRootMotion->RotationKeys, pOutRootMotion->RotationTangents, false, [&](float time){
+                Float3 scale, translation;
+                Float4 rotation;
+                splitter.sampleSource(scale, rotation, translation, cursor, time);
+
+                DirectX::XMVECTOR xmm_yaw, xmm_motionTranslation, xmm_restRotation, xmm_restTranslation;
+                splitter.split(xmm_yaw, xmm_motionTranslation, xmm_restRotation, xmm_restTranslation, rotation, translation);
+                return xmm_yaw;
+            });
+        }
+        else
+            ins_fillBindKey(pOutRootMotion->RotationKeys, pOutRootMotion->RotationTangents, DirectX::XMQuaternionIdentity(), DirectX::XMQuaternionIdentity());
+
+        pOutRootMotion->TranslationKeys = pRootAnimationNode->TranslationKeys;
+        pOutRootMotion->TranslationTangents = pRootAnimationNode->TranslationTangents;
+        {
+            FBXAnimationCursor cursor;
+            ins_rewriteTrack(pOutRootMotion->TranslationKeys, pOutRootMotion->TranslationTangents, false, [&](float time){
+                Float3 scale, translation;
+                Float4 rotation;
+                splitter.sampleSource(scale, rotation, translation, cursor, time);
+
+                DirectX::XMVECTOR xmm_yaw, xmm_motionTranslation, xmm_restRotation, xmm_restTranslation;
+                splitter.split(xmm_yaw, xmm_motionTranslation, xmm_restRotation, xmm_restTranslation, rotation, translation);
+                return xmm_motionTranslation;
+            });
+        }
+
+        for(auto* pKey = pOutRootMotion->RotationKeys.Values; FBX_PTRDIFFU(pKey - pOutRootMotion->RotationKeys.Values) < pOutRootMotion->RotationKeys.Length; ++pKey)
+            pKey->World = pKey->Local;
+        for(auto* pTangent = pOutRootMotion->RotationTangents.Values; FBX_PTRDIFFU(pTangent - pOutRootMotion->RotationTangents.Values) < pOutRootMotion->RotationTangents.Length; ++pTangent)
+            pTangent->World = pTangent->Local;
+        for(auto* pKey = pOutRootMotion->TranslationKeys.Values; FBX_PTRDIFFU(pKey - pOutRootMotion->TranslationKeys.Values) < pOutRootMotion->TranslationKeys.Length; ++pKey)
+            pKey->World = pKey->Local;
+        for(auto* pTangent = pOutRootMotion->TranslationTangents.Values; FBX_PTRDIFFU(pTangent - pOutRootMotion->TranslationTangents.Values) < pOutRootMotion->TranslationTangents.Length; ++pTangent)
+            pTangent->World = pTangent->Local;
+    }
+
+    if(pAnimation->HasWorldKeys){ // world keys of the root node and its descendants. left as they are if not filled
+        fbx_vector<FBXAnimationNode*> subtree;
+        for(auto* pNode = pAnimation->AnimationNodes.Values; FBX_PTRDIFFU(pNode - pAnimation->AnimationNodes.Values) < pAnimation->AnimationNodes.Length; ++pNode){
+            for(const auto* pParent = pNode->BindNode; pParent; pParent = pParent->Parent){
+                if(pParent == pRootNode){
+                    subtree.emplace_back(pNode);
+                    break;
+                }
+            }
+        }
+
+        // descendants are usually keyed on the same frames, so the delta is solved once per key time
+        fbx_vector<float> times;
+        for(const auto* pNode : subtree){
+            for(const auto* pKey = pNode->RotationKeys.Values; FBX_PTRDIFFU(pKey - pNode->RotationKeys.Values) < pNode->RotationKeys.Length; ++pKey)
+                times.emplace_back(pKey->Time);
+            for(const auto* pKey = pNode->TranslationKeys.Values; FBX_PTRDIFFU(pKey - pNode->TranslationKeys.Values) < pNode->TranslationKeys.Length; ++pKey)
+                times.emplace_back(pKey->Time);
+        }
+        std::sort(times.begin(), times.end());
+        times.erase(std::unique(times.begin(), times.end()), times.end());
+
+        fbx_vector<DirectX::XMFLOAT4X4> deltaMatrices(times.size());
+        fbx_vector<DirectX::XMFLOAT4> deltaRotations(times.size());
+        std::for_each(std::execution::par, times.cbegin(), times.cend(), [&](const float& time){
+            const auto idxTime = FBX_PTRDIFFU(&time - times.data());
+
+            FBXAnimationCursor localCursor, worldCursor;
+            const auto xmm4_delta = splitter.worldDelta(localCursor, worldCursor, time);
+
+            DirectX::XMVECTOR xmm_scale, xmm_rotation, xmm_translation;
+            DirectX::XMMatrixDecompose(&xmm_scale, &xmm_rotation, &xmm_translation, xmm4_delta);
+
+            DirectX::XMStoreFloat4x4(&deltaMatrices[idxTime], xmm4_delta);
+            DirectX::XMStoreFloat4(&deltaRotations[idxTime], xmm_rotation);
+        });
+
+        // tangent samples fall between the key times, so they are solved on the spot
+        auto findDelta = [&](DirectX::XMMATRIX& xmm4_delta, DirectX::XMVECTOR& xmm_rotation, FBXAnimationCursor& localCursor, FBXAnimationCursor& worldCursor, float time){
+            const auto itrTime = std::lower_bound(times.cbegin(), times.cend(), time);
+            if((itrTime != times.cend()) && ((*itrTime) == time)){
+                const auto idxTime = itrTime - times.cbegin();
+                xmm4_delta = DirectX::XMLoadFloat4x4(&deltaMatrices[idxTime]);
+                xmm_rotation = DirectX::XMLoadFloat4(&deltaRotations[idxTime]);
+                return;
+            }
+
+            xmm4_delta = splitter.worldDelta(localCursor, worldCursor, time);
+
+            DirectX::XMVECTOR xmm_scale, xmm_translation;
+            DirectX::XMMatrixDecompose(&xmm_scale, &xmm_rotation, &xmm_translation, xmm4_delta);
+        };
+
+        std::for_each(std::execution::par, subtree.begin(), subtree.end(), [&findDelta](FBXAnimationNode* pNode){
+            if(pNode->RotationKeys.Length){
+                FBXAnimationCursor localCursor, worldCursor;
+                unsigned long cursor = 0;
+                ins_rewriteTrack(pNode->RotationKeys, pNode->RotationTangents, true, [&](float time){
+                    DirectX::XMMATRIX xmm4_delta;
+                    DirectX::XMVECTOR xmm_rotation;
+                    findDelta(xmm4_delta, xmm_rotation, localCursor, worldCursor, time);
+
+                    auto xmm_world = ins_sampleTrack(pNode->RotationKeys, pNode->RotationTangents, true, cursor, time);
+                    return DirectX::XMQuaternionNormalize(DirectX::XMQuaternionMultiply(xmm_world, xmm_rotation));
+                });
+            }
+            if(pNode->TranslationKeys.Length){
+                FBXAnimationCursor localCursor, worldCursor;
+                unsigned long cursor = 0;
+                ins_rewriteTrack(pNode->TranslationKeys, pNode->TranslationTangents, true, [&](float time){
+                    DirectX::XMMATRIX xmm4_delta;
+                    DirectX::XMVECTOR xmm_rotation;
+                    findDelta(xmm4_delta, xmm_rotation, localCursor, worldCursor, time);
+
+                    auto xmm_world = ins_sampleTrack(pNode->TranslationKeys, pNode->TranslationTangents, true, cursor, time);
+                    return DirectX::XMVector3TransformCoord(xmm_world, xmm4_delta);
+                });
+            }
+        });
+    }
+
+    { // local keys of the root node
+        if(splitter.bYaw){
+            FBXAnimationCursor cursor;
+            ins_rewriteTrack(pRootAnimationNode->RotationKeys, pRootAnimationNode->RotationTangents, false, [&](float time){
+                Float3 scale, translation;
+                Float4 rotation;
+                splitter.sampleSource(scale, rotation, translation, cursor, time);
+
+                DirectX::XMVECTOR xmm_yaw, xmm_motionTranslation, xmm_restRotation, xmm_restTranslation;
+                splitter.split(xmm_yaw, xmm_motionTranslation, xmm_restRotation, xmm_restTranslation, rotation, translation);
+                return xmm_restRotation;
+            });
+        }
+
+        FBXAnimationCursor cursor;
+        ins_rewriteTrack(pRootAnimationNode->TranslationKeys, pRootAnimationNode->TranslationTangents, false, [&](float time){
+            Float3 scale, translation;
+            Float4 rotation;
+            splitter.sampleSource(scale, rotation, translation, cursor, time);
+
+            DirectX::XMVECTOR xmm_yaw, xmm_motionTranslation, xmm_restRotation, xmm_restTranslation;
+            splitter.split(xmm_yaw, xmm_motionTranslation, xmm_restRotation, xmm_restTranslation, rotation, translation);
+            return xmm_restTranslation;
+        });
+    }
+
+    // samples follow the rewritten keys
+    if(pAnimation->Samples.Length)
+        SHRResampleAnimation(pAnimation, pAnimation->SampleRate);
+
+    return true;
+}
+
+
+// additive deltas. scaling divides, translation subtracts, and rotation is the delta which turns the reference into the pose in parent space.
+// every map is linear in the key value except the translation offset, so tangents go through the linear part only
+class _AdditiveReference{
+public:
+    Float3 scale[2];
+    Float4 rotation[2];
+    Float3 translation[2];
+};
+
+// axes collapsed in the reference are kept as they are
+static inline DirectX::XMVECTOR ins_reciprocalScale(const Float3& scale){
+    const auto xmm_scale = DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)scale.raw);
+    const auto xmm_collapsed = DirectX::XMVectorNearEqual(xmm_scale, DirectX::XMVectorZero(), DirectX::XMVectorReplicate(FLT_EPSILON));
+    return DirectX::XMVectorSelect(DirectX::XMVectorReciprocal(xmm_scale), DirectX::g_XMOne, xmm_collapsed);
+}
+
+template<unsigned long N, typename FUNC>
+static void ins_mapKeys(FBXDynamicArray<FBXAnimationKeyFrame<FBXStaticArray<float, N>>>& keys, FBXDynamicArray<FBXAnimationKeyTangent<FBXStaticArray<float, N>>>& tangents, bool bWorld, FUNC&& fnLinear, DirectX::FXMVECTOR xmm_offset){
+    for(auto* pKey = keys.Values; FBX_PTRDIFFU(pKey - keys.Values) < keys.Length; ++pKey){
+        auto& kValue = bWorld ? pKey->World : pKey->Local;
+
+        auto xmm_value = DirectX::XMVectorAdd(fnLinear(ins_loadKeyValue(kValue)), xmm_offset);
+        if constexpr(N == 4)
+            xmm_value = DirectX::XMQuaternionNormalize(xmm_value);
+
+        ins_storeKeyValue(kValue, xmm_value);
+    }
+    for(auto* pTangent = tangents.Values; FBX_PTRDIFFU(pTangent - tangents.Values) < tangents.Length; ++pTangent){
+        auto& kTangent = bWorld ? pTangent->World : pTangent->Local;
+
+        ins_storeKeyValue(kTangent.In, fnLinear(ins_loadKeyValue(kTangent.In)));
+        ins_storeKeyValue(kTangent.Out, fnLinear(ins_loadKeyValue(kTangent.Out)));
+    }
+}
+
+
+void SHRMakeAdditiveAnimation(FBXAnimation* pOutAnimation, const FBXAnimation* pAnimation, const FBXAnimation* pReference, float referenceTime){
+    const auto nodeCount = pAnimation->AnimationNodes.Length;
+
+    // references are taken first, since the output may be the source or the reference itself
+    fbx_vector<_AdditiveReference> references(nodeCount);
+    {
+        fbx_unordered_map<const FBXNode*, const FBXAnimationNode*, PointerHasher<const FBXNode*>> referenceFinder;
+        if(pReference){
+            referenceFinder.rehash(pReference->AnimationNodes.Length << 1);
+            for(const auto* pNode = pReference->AnimationNodes.Values; FBX_PTRDIFFU(pNode - pReference->AnimationNodes.Values) < pReference->AnimationNodes.Length; ++pNode)
+                referenceFinder.emplace(pNode->BindNode, pNode);
+        }
+
+        std::for_each(std::execution::par, references.begin(), references.end(), [&](_AdditiveReference& cReference){
+            const auto idxNode = FBX_PTRDIFFU(&cReference - references.data());
+            const auto& kNode = pAnimation->AnimationNodes.Values[idxNode];
+
+            // a node without keys falls back to the bind pose in every sampler
+            FBXAnimationNode bindNode;
+            bindNode.BindNode = kNode.BindNode;
+
+            const auto* pReferenceNode = &bindNode;
+            float time = 0.f;
+            {
+                auto itrReference = referenceFinder.find(kNode.BindNode);
+                if(itrReference != referenceFinder.cend()){
+                    pReferenceNode = itrReference->second;
+                    time = referenceTime;
+                }
+            }
+
+            ComputeLocalTransformByTime(&cReference.scale[0], &cReference.rotation[0], &cReference.translation[0], pReferenceNode, nullptr, time);
+            if(pAnimation->HasWorldKeys)
+                ComputeWorldTransformByTime(&cReference.scale[1], &cReference.rotation[1], &cReference.translation[1], pReferenceNode, nullptr, time);
+        });
+    }
+
+    if(pOutAnimation != pAnimation)
+        (*pOutAnimation) = (*pAnimation);
+
+    // world keys which are not filled stay so
+    const int spaceCount = pOutAnimation->HasWorldKeys ? 2 : 1;
+
+    std::for_each(std::execution::par, references.cbegin(), references.cend(), [&](const _AdditiveReference& cReference){
+        const auto idxNode = FBX_PTRDIFFU(&cReference - references.data());
+        auto& kNode = pOutAnimation->AnimationNodes.Values[idxNode];
+
+        // channels without keys follow the bind pose, which is not an identity delta in general. they get one key holding it
+        if((!kNode.ScalingKeys.Length) || (!kNode.RotationKeys.Length) || (!kNode.TranslationKeys.Length)){
+            Float3 localScale, localTranslation, worldScale, worldTranslation;
+            Float4 localRotation, worldRotation;
+            ComputeLocalTransformByTime(&localScale, &localRotation, &localTranslation, &kNode, nullptr, 0.f);
+            ComputeWorldTransformByTime(&worldScale, &worldRotation, &worldTranslation, &kNode, nullptr, 0.f);
+
+            if(!kNode.ScalingKeys.Length)
+                ins_fillBindKey(kNode.ScalingKeys, kNode.ScalingTangents, DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)localScale.raw), DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)worldScale.raw));
+            if(!kNode.RotationKeys.Length)
+                ins_fillBindKey(kNode.RotationKeys, kNode.RotationTangents, DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)localRotation.raw), DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)worldRotation.raw));
+            if(!kNode.TranslationKeys.Length)
+                ins_fillBindKey(kNode.TranslationKeys, kNode.TranslationTangents, DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)localTranslation.raw), DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)worldTranslation.raw));
+        }
+
+        for(int idxSpace = 0; idxSpace < spaceCount; ++idxSpace){
+            const bool bWorld = (idxSpace != 0);
+
+            const auto xmm_scaleInv = ins_reciprocalScale(cReference.scale[idxSpace]);
+            ins_mapKeys(kNode.ScalingKeys, kNode.ScalingTangents, bWorld, [&xmm_scaleInv](DirectX::FXMVECTOR xmm_value){
+                return DirectX::XMVectorMultiply(xmm_value, xmm_scaleInv);
+            }, DirectX::XMVectorZero());
+
+            const auto xmm_rotationInv = DirectX::XMQuaternionConjugate(DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)cReference.rotation[idxSpace].raw));
+            ins_mapKeys(kNode.RotationKeys, kNode.RotationTangents, bWorld, [&xmm_rotationInv](DirectX::FXMVECTOR xmm_value){
+                return DirectX::XMQuaternionMultiply(xmm_rotationInv, xmm_value);
+            }, DirectX::XMVectorZero());
+
+            const auto xmm_translation = DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)cReference.translation[idxSpace].raw);
+            ins_mapKeys(kNode.TranslationKeys, kNode.TranslationTangents, bWorld, [](DirectX::FXMVECTOR xmm_value){
+                return xmm_value;
+            }, DirectX::XMVectorNegate(xmm_translation));
+        }
+    });
+
+    if(pOutAnimation->Samples.Length)
+        SHRResampleAnimation(pOutAnimation, pOutAnimation->SampleRate);
+}
+
+
+template<unsigned long N>
+static inline DirectX::XMVECTOR ins_evaluateSegment(
+    const FBXDynamicArray<FBXAnimationKeyFrame<FBXStaticArray<float, N>>>& keys,
+    const FBXDynamicArray<FBXAnimationKeyTangent<FBXStaticArray<float, N>>>& tangents,
+    unsigned long idxFrom,
+    unsigned long idxTo,
+    bool bWorld,
+    float time
+){
+    const auto& kFrom = keys.Values[idxFrom];
+    const auto& kTo = keys.Values[idxTo];
+
+    const auto& kFromValue = bWorld ? kFrom.World : kFrom.Local;
+    const auto& kToValue = bWorld ? kTo.World : kTo.Local;
+
+    float value[N];
+    switch(kFrom.InterpolationType){
+    case FBXAnimationInterpolationType::FBXAnimationInterpolationType_Linear:
+        InterpolateKeyValue<float, N>(value, &kFromValue, &kToValue, (time - kFrom.Time) / (kTo.Time - kFrom.Time));
+        break;
+
+    case FBXAnimationInterpolationType::FBXAnimationInterpolationType_Cubic:
+    {
+        const auto fDuration = kTo.Time - kFrom.Time;
+        const auto& kFromTangent = bWorld ? GetKeyTangent(tangents, idxFrom).World : GetKeyTangent(tangents, idxFrom).Local;
+        const auto& kToTangent = bWorld ? GetKeyTangent(tangents, idxTo).World : GetKeyTangent(tangents, idxTo).Local;
+        HermiteKeyValue<float, N>(value, &kFromValue, &kFromTangent.Out, &kToValue, &kToTangent.In, (time - kFrom.Time) / fDuration, fDuration);
+        break;
+    }
+
+    default:
+        return ins_loadKeyValue(kFromValue);
+    }
+
+    if constexpr(N == 4)
+        return DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)value);
+    else
+        return DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)value);
+}
+
+// keys between idxFrom and idxTo can go if the segment idxFrom->idxTo stays within tolerance at every removed key and every source segment middle
+template<KeyErrorType TYPE, unsigned long N>
+static bool ins_canBridgeKeys(
+    const FBXDynamicArray<FBXAnimationKeyFrame<FBXStaticArray<float, N>>>& keys,
+    const FBXDynamicArray<FBXAnimationKeyTangent<FBXStaticArray<float, N>>>& tangents,
+    unsigned long idxFrom,
+    unsigned long idxTo,
+    const float(&tolerance)[2]
+){
+    for(int idxSpace = 0; idxSpace < 2; ++idxSpace){
+        const bool bWorld = (idxSpace != 0);
+
+        unsigned long cursor = idxFrom;
+        for(auto idxKey = idxFrom + 1; idxKey <= idxTo; ++idxKey){
+            const auto& kKey = keys.Values[idxKey];
+
+            if(idxKey < idxTo){
+                auto xmm_source = ins_loadKeyValue(bWorld ? kKey.World : kKey.Local);
+                if(ComputeKeyError<TYPE>(xmm_source, ins_evaluateSegment(keys, tangents, idxFrom, idxTo, bWorld, kKey.Time)) > tolerance[idxSpace])
+                    return false;
+            }
+
+            const auto fMiddle = (keys.Values[idxKey - 1].Time + kKey.Time) * 0.5f;
+            auto xmm_source = ins_sampleTrack(keys, tangents, bWorld, cursor, fMiddle);
+            if(ComputeKeyError<TYPE>(xmm_source, ins_evaluateSegment(keys, tangents, idxFrom, idxTo, bWorld, fMiddle)) > tolerance[idxSpace])
+                return false;
+        }
+    }
+
+    return true;
+}
+
+template<KeyErrorType TYPE, unsigned long N>
+static void ins_reduceTrack(FBXDynamicArray<FBXAnimationKeyFrame<FBXStaticArray<float, N>>>& keys, FBXDynamicArray<FBXAnimationKeyTangent<FBXStaticArray<float, N>>>& tangents, const float(&tolerance)[2]){
+    const auto keyCount = (unsigned long)keys.Length;
+    if(keyCount < 2)
+        return;
+
+    fbx_vector<unsigned long> keptKeys;
+    keptKeys.reserve(keyCount);
+
+    { // constant track keeps its first key only
+        const auto xmm_local = ins_loadKeyValue(keys.Values[0].Local);
+        const auto xmm_world = ins_loadKeyValue(keys.Values[0].World);
+
+        bool bConstant = true;
+        for(auto* pKey = keys.Values + 1; bConstant && (FBX_PTRDIFFU(pKey - keys.Values) < keys.Length); ++pKey){
+            if(ComputeKeyError<TYPE>(ins_loadKeyValue(pKey->Local), xmm_local) > tolerance[0])
+                bConstant = false;
+            else if(ComputeKeyError<TYPE>(ins_loadKeyValue(pKey->World), xmm_world) > tolerance[1])
+                bConstant = false;
+        }
+
+        if(bConstant)
+            keptKeys.emplace_back(0);
+    }
+
+    // the segment from each kept key is stretched by doubling steps, then the failing step is binary searched
+    if(keptKeys.empty()){
+        unsigned long idxFrom = 0;
+        for(;;){
+            keptKeys.emplace_back(idxFrom);
+            if((idxFrom + 1) >= keyCount)
+                break;
+
+            auto idxGood = idxFrom + 1;
+            auto idxBad = keyCount;
+            for(unsigned long step = 1; ; step <<= 1){
+                const auto idxCandidate = std::min(idxFrom + 1 + step, keyCount - 1);
+                if(idxCandidate == idxGood)
+                    break;
+
+                if(!ins_canBridgeKeys<TYPE>(keys, tangents, idxFrom, idxCandidate, tolerance)){
+                    idxBad = idxCandidate;
+                    break;
+                }
+                idxGood = idxCandidate;
+            }
+            while((idxBad - idxGood) > 1){
+                const auto idxMiddle = (idxGood + idxBad) >> 1;
+                if(ins_canBridgeKeys<TYPE>(keys, tangents, idxFrom, idxMiddle, tolerance))
+                    idxGood = idxMiddle;
+                else
+                    idxBad = idxMiddle;
+            }
+
+            idxFrom = idxGood;
+        }
+    }
+
+    if(keptKeys.size() == keys.Length)
+        return;
+
+    ins_keepKeys(keys, tangents, keptKeys);
+}
+
+
+// bind pose measures of a node, used to bring world space tolerance down to each track
+class _NodeReach{
+public:
+    _NodeReach()
+        :
+        position(DirectX::XMFLOAT3(0.f, 0.f, 0.f)),
+        reach(0.f),
+        parentWorldScale(1.f)
+    {}
+
+
+public:
+    DirectX::XMFLOAT3 position;
+    float reach; // farthest distance to descendants
+    float parentWorldScale;
+};
+
+static inline float ins_maxScale(const FBXNode* pNode){
+    if(!pNode)
+        return 1.f;
+
+    DirectX::XMFLOAT4X4A matWorld;
+    GetBindWorldMatrix((float*)&matWorld, pNode);
+
+    const auto xmm4_ret = DirectX::XMLoadFloat4x4A(&matWorld);
+    auto xmm_scale = DirectX::XMVectorMax(
+        DirectX::XMVector3Length(xmm4_ret.r[0]),
+        DirectX::XMVectorMax(DirectX::XMVector3Length(xmm4_ret.r[1]), DirectX::XMVector3Length(xmm4_ret.r[2]))
+    );
+    return std::max(DirectX::XMVectorGetX(xmm_scale), FLT_EPSILON);
+}
+
+
+void SHRComputeAnimationTolerances(const FBXAnimation* pAnimation, float scalingTolerance, float rotationTolerance, float translationTolerance, AnimationTolerance* pOutTolerances){
+    const auto nodeCount = pAnimation->AnimationNodes.Length;
+    if(!nodeCount)
+        return;
+
+    // every hierarchy a track is bound to is walked once from its top. tracks without a bind node keep unit scale and no reach
+    fbx_unordered_map<const FBXNode*, _NodeReach, PointerHasher<const FBXNode*>> nodeReaches;
+    {
+        auto fnStoreReach = [&nodeReaches](FBXNode* pNode){
+            auto& cReach = nodeReaches[pNode];
+
+            DirectX::XMFLOAT4X4A matWorld;
+            GetBindWorldMatrix((float*)&matWorld, pNode);
+            cReach.position = DirectX::XMFLOAT3(matWorld._41, matWorld._42, matWorld._43);
+
+            cReach.parentWorldScale = ins_maxScale(pNode->Parent);
+        };
+
+        for(size_t idxNode = 0u; idxNode < nodeCount; ++idxNode){
+            FBXNode* pTopNode = pAnimation->AnimationNodes.Values[idxNode].BindNode;
+            if(!pTopNode || (nodeReaches.find(pTopNode) != nodeReaches.cend()))
+                continue;
+
+            while(pTopNode->Parent)
+                pTopNode = pTopNode->Parent;
+            if(nodeReaches.find(pTopNode) != nodeReaches.cend())
+                continue;
+
+            FBXIterateNode(pTopNode->Child, fnStoreReach);
+            fnStoreReach(pTopNode);
+        }
+
+        for(const auto& iNode : nodeReaches){
+            const auto xmm_position = DirectX::XMLoadFloat3(&iNode.second.position);
+            for(const auto* pParent = iNode.first->Parent; pParent; pParent = pParent->Parent){
+                auto itrParent = nodeReaches.find(pParent);
+                if(itrParent == nodeReaches.end())
+                    break;
+
+                auto& cParentReach = itrParent->second;
+                const auto fDistance = DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMVectorSubtract(xmm_position, DirectX::XMLoadFloat3(&cParentReach.position))));
+                cParentReach.reach = std::max(cParentReach.reach, fDistance);
+            }
+        }
+    }
+
+    for(size_t idxNode = 0u; idxNode < nodeCount; ++idxNode){
+        auto& cTolerance = pOutTolerances[idxNode];
+
+        _NodeReach cReach;
+        {
+            auto itrReach = nodeReaches.find(pAnimation->AnimationNodes.Values[idxNode].BindNode);
+            if(itrReach != nodeReaches.cend())
+                cReach = itrReach->second;
+        }
+
+        // rotation and scaling error of the node swing every descendant, up to the reach
+        cTolerance.scaling = scalingTolerance;
+        cTolerance.rotation = rotationTolerance;
+        if(cReach.reach > FLT_EPSILON){
+            cTolerance.scaling = std::min(cTolerance.scaling, translationTolerance / cReach.reach);
+            cTolerance.rotation = std::min(cTolerance.rotation, translationTolerance / cReach.reach);
+        }
+
+        // local translation is scaled by the parent on its way to world
+        cTolerance.localTranslation = translationTolerance / cReach.parentWorldScale;
+        cTolerance.worldTranslation = translationTolerance;
+    }
+}
+
+void SHRReduceAnimationKeys(FBXAnimation* pAnimation, float scalingTolerance, float rotationTolerance, float translationTolerance){
+    const auto nodeCount = pAnimation->AnimationNodes.Length;
+    if(!nodeCount)
+        return;
+
+    fbx_vector<AnimationTolerance> tolerances(nodeCount);
+    SHRComputeAnimationTolerances(pAnimation, scalingTolerance, rotationTolerance, translationTolerance, tolerances.data());
+
+    // world keys which are not filled have nothing to keep
+    const bool bWorld = pAnimation->HasWorldKeys;
+
+    std::for_each(std::execution::par, pAnimation->AnimationNodes.Values, pAnimation->AnimationNodes.Values + nodeCount, [&](FBXAnimationNode& cNode){
+        const auto& cTolerance = tolerances[FBX_PTRDIFFU(&cNode - pAnimation->AnimationNodes.Values)];
+
+        {
+            const float tolerance[2] = { cTolerance.scaling, bWorld ? cTolerance.scaling : FLT_MAX };
+            ins_reduceTrack<KeyErrorType::KeyErrorType_Scaling>(cNode.ScalingKeys, cNode.ScalingTangents, tolerance);
+        }
+        {
+            const float tolerance[2] = { cTolerance.rotation, bWorld ? cTolerance.rotation : FLT_MAX };
+            ins_reduceTrack<KeyErrorType::KeyErrorType_Rotation>(cNode.RotationKeys, cNode.RotationTangents, tolerance);
+        }
+        {
+            const float tolerance[2] = { cTolerance.localTranslation, bWorld ? cTolerance.worldTranslation : FLT_MAX };
+            ins_reduceTrack<KeyErrorType::KeyErrorType_Translation>(cNode.TranslationKeys, cNode.TranslationTangents, tolerance);
+        }
+    });
+
+    if(pAnimation->Samples.Length)
+        SHRResampleAnimation(pAnimation, pAnimation->SampleRate);
+}
+
+void SHRResampleAnimation(FBXAnimation* pAnimation, float sampleRate){
+    const auto nodeCount = pAnimation->AnimationNodes.Length;
+    if((sampleRate <= 0.f) || (!nodeCount)){
+        pAnimation->Samples.Clear();
+        pAnimation->SampleFrameCount = 0;
+        pAnimation->SampleRate = 0.f;
+        return;
+    }
+
+    // float error of a whole frame count must not add a frame right before EndTime
+    const auto endTime = std::max(pAnimation->EndTime, 0.f);
+    const auto frameCount = (unsigned long)std::max(std::ceil(endTime * sampleRate - 0.001f), 0.f) + 1;
+
+    pAnimation->Samples.Assign(frameCount * nodeCount);
+    pAnimation->SampleFrameCount = frameCount;
+    pAnimation->SampleRate = sampleRate;
+
+    std::for_each(std::execution::par, pAnimation->AnimationNodes.Values, pAnimation->AnimationNodes.Values + nodeCount, [&](const FBXAnimationNode& iNode){
+        const auto idxNode = FBX_PTRDIFFU(&iNode - pAnimation->AnimationNodes.Values);
+
+        FBXAnimationCursor localCursor, worldCursor;
+        auto* pSample = pAnimation->Samples.Values + idxNode;
+        for(unsigned long idxFrame = 0; idxFrame < frameCount; ++idxFrame, pSample += nodeCount){
+            const auto time = std::min((float)idxFrame / sampleRate, endTime);
+
+            Float3 scale, translation;
+            Float4 rotation;
+
+            ComputeLocalTransformByTime(&scale, &rotation, &translation, &iNode, &localCursor, time);
+            CopyArrayData(pSample->Local.Scaling.Values, scale.raw);
+            CopyArrayData(pSample->Local.Rotation.Values, rotation.raw);
+            CopyArrayData(pSample->Local.Translation.Values, translation.raw);
+
+            if(!pAnimation->HasWorldKeys)
+                continue;
+
+            ComputeWorldTransformByTime(&scale, &rotation, &translation, &iNode, &worldCursor, time);
+            CopyArrayData(pSample->World.Scaling.Values, scale.raw);
+            CopyArrayData(pSample->World.Rotation.Values, rotation.raw);
+            CopyArrayData(pSample->World.Translation.Values, translation.raw);
+        }
+    });
+}
+
+
+// link of an animation node to the nearest animated ancestor. world is local * offset * world of the ancestor
+class _WorldLink{
+public:
+    DirectX::XMFLOAT4X4 offset; // bind transforms of the unanimated nodes in between
+    DirectX::XMFLOAT3 bindScale;
+    DirectX::XMFLOAT4 bindRotation;
+    DirectX::XMFLOAT3 bindTranslation;
+    size_t parent; // index in AnimationNodes. node count if there is no animated ancestor
+    size_t depth; // count of animated ancestors
+};
+
+static inline DirectX::XMMATRIX ins_sampleLocalMatrix(const FBXAnimationNode& kNode, const _WorldLink& kLink, FBXAnimationCursor& cursor, float time){
+    const auto xmm_scale = kNode.ScalingKeys.Length ? ins_sampleTrack(kNode.ScalingKeys, kNode.ScalingTangents, false, cursor.ScalingKey, time) : DirectX::XMLoadFloat3(&kLink.bindScale);
+    const auto xmm_rotation = kNode.RotationKeys.Length ? ins_sampleTrack(kNode.RotationKeys, kNode.RotationTangents, false, cursor.RotationKey, time) : DirectX::XMLoadFloat4(&kLink.bindRotation);
+    const auto xmm_translation = kNode.TranslationKeys.Length ? ins_sampleTrack(kNode.TranslationKeys, kNode.TranslationTangents, false, cursor.TranslationKey, time) : DirectX::XMLoadFloat3(&kLink.bindTranslation);
+    return DirectX::XMMatrixAffineTransformation(xmm_scale, DirectX::XMVectorZero(), xmm_rotation, xmm_translation);
+}
+
+static inline void ins_storeTransform(FBXAnimationTransform& transform, DirectX::FXMMATRIX xmm4_world){
+    DirectX::XMVECTOR xmm_scale, xmm_rotation, xmm_translation;
+    DecomposeTransform(&xmm_scale, &xmm_rotation, &xmm_translation, xmm4_world);
+
+    ins_storeKeyValue(transform.Scaling, xmm_scale);
+    ins_storeKeyValue(transform.Rotation, xmm_rotation);
+    ins_storeKeyValue(transform.Translation, xmm_translation);
+}
+
+template<unsigned long N>
+static inline void ins_collectKeyTimes(fbx_vector<float>& times, const FBXDynamicArray<FBXAnimationKeyFrame<FBXStaticArray<float, N>>>& keys){
+    for(size_t idxKey = 0u; idxKey < keys.Length; ++idxKey){
+        const auto& kKey = keys.Values[idxKey];
+        times.emplace_back(kKey.Time);
+
+        // same expressions as ins_rewriteTrack, so that tangent samples hit the table as well
+        if(idxKey && (keys.Values[idxKey - 1].InterpolationType == FBXAnimationInterpolationType::FBXAnimationInterpolationType_Cubic)){
+            const auto fStep = (kKey.Time - keys.Values[idxKey - 1].Time) * ins_tangentSampleStep;
+            times.emplace_back(kKey.Time - fStep);
+        }
+        if(((idxKey + 1) < keys.Length) && (kKey.InterpolationType == FBXAnimationInterpolationType::FBXAnimationInterpolationType_Cubic)){
+            const auto fStep = (keys.Values[idxKey + 1].Time - kKey.Time) * ins_tangentSampleStep;
+            times.emplace_back(kKey.Time + fStep);
+        }
+    }
+}
+
+void SHRBuildAnimationWorldKeys(FBXAnimation* pAnimation){
+    pAnimation->HasWorldKeys = true;
+    for(auto* pNode = pAnimation->AnimationNodes.Values; FBX_PTRDIFFU(pNode - pAnimation->AnimationNodes.Values) < pAnimation->AnimationNodes.Length; ++pNode)
+        pNode->HasWorldKeys = true;
+
+    const auto nodeCount = pAnimation->AnimationNodes.Length;
+    if(!nodeCount)
+        return;
+
+    const auto* pNodes = pAnimation->AnimationNodes.Values;
+
+    fbx_vector<_WorldLink> links(nodeCount);
+    fbx_vector<size_t> order(nodeCount);
+    {
+        fbx_unordered_map<const FBXNode*, size_t, PointerHasher<const FBXNode*>> nodeIndices;
+        nodeIndices.rehash(nodeCount << 1);
+        for(size_t idxNode = 0u; idxNode < nodeCount; ++idxNode){
+            if(pNodes[idxNode].BindNode)
+                nodeIndices.emplace(pNodes[idxNode].BindNode, idxNode);
+        }
+
+        for(size_t idxNode = 0u; idxNode < nodeCount; ++idxNode){
+            auto& cLink = links[idxNode];
+            const auto* pBindNode = pNodes[idxNode].BindNode;
+
+            auto xmm4_offset = DirectX::XMMatrixIdentity();
+            cLink.parent = nodeCount;
+
+            if(pBindNode){
+                auto xmm4_bind = DirectX::XMLoadFloat4x4((const DirectX::XMFLOAT4X4*)pBindNode->TransformMatrix.Values);
+
+                DirectX::XMVECTOR xmm_scale, xmm_rotation, xmm_translation;
+                DecomposeTransform(&xmm_scale, &xmm_rotation, &xmm_translation, xmm4_bind);
+                DirectX::XMStoreFloat3(&cLink.bindScale, xmm_scale);
+                DirectX::XMStoreFloat4(&cLink.bindRotation, xmm_rotation);
+                DirectX::XMStoreFloat3(&cLink.bindTranslation, xmm_translation);
+
+                for(const auto* pParent = pBindNode->Parent; pParent; pParent = pParent->Parent){
+                    auto f = nodeIndices.find(pParent);
+                    if(f != nodeIndices.end()){
+                        cLink.parent = f->second;
+                        break;
+                    }
+
+                    auto xmm4_tmp = DirectX::XMLoadFloat4x4((const DirectX::XMFLOAT4X4*)pParent->TransformMatrix.Values);
+                    xmm4_offset = DirectX::XMMatrixMultiply(xmm4_offset, xmm4_tmp);
+                }
+            }
+            else{
+                DirectX::XMStoreFloat3(&cLink.bindScale, DirectX::g_XMOne3);
+                DirectX::XMStoreFloat4(&cLink.bindRotation, DirectX::XMQuaternionIdentity());
+                DirectX::XMStoreFloat3(&cLink.bindTranslation, DirectX::XMVectorZero());
+            }
+
+            DirectX::XMStoreFloat4x4(&cLink.offset, xmm4_offset);
+        }
+
+        for(size_t idxNode = 0u; idxNode < nodeCount; ++idxNode){
+            auto& cLink = links[idxNode];
+
+            cLink.depth = 0;
+            for(auto idxParent = cLink.parent; idxParent < nodeCount; idxParent = links[idxParent].parent)
+                ++cLink.depth;
+
+            order[idxNode] = idxNode;
+        }
+
+        // ancestors come first, so each world is one multiply away from an already solved one
+        std::stable_sort(order.begin(), order.end(), [&links](size_t lhs, size_t rhs){ return links[lhs].depth < links[rhs].depth; });
+    }
+
+    // nodes are mostly keyed on the same frames, so the whole pose is solved once per key time
+    fbx_vector<float> times;
+    for(size_t idxNode = 0u; idxNode < nodeCount; ++idxNode){
+        ins_collectKeyTimes(times, pNodes[idxNode].ScalingKeys);
+        ins_collectKeyTimes(times, pNodes[idxNode].RotationKeys);
+        ins_collectKeyTimes(times, pNodes[idxNode].TranslationKeys);
+    }
+    std::sort(times.begin(), times.end());
+    times.erase(std::unique(times.begin(), times.end()), times.end());
+
+    fbx_vector<FBXAnimationTransform> worlds(times.size() * nodeCount);
+    std::for_each(std::execution::par, times.cbegin(), times.cend(), [&](const float& time){
+        const auto idxTime = FBX_PTRDIFFU(&time - times.data());
+        auto* pWorlds = worlds.data() + idxTime * nodeCount;
+
+        fbx_vector<DirectX::XMFLOAT4X4> worldMatrices(nodeCount);
+        for(const auto idxNode : order){
+            const auto& kLink = links[idxNode];
+
+            FBXAnimationCursor cursor;
+            auto xmm4_world = DirectX::XMMatrixMultiply(ins_sampleLocalMatrix(pNodes[idxNode], kLink, cursor, time), DirectX::XMLoadFloat4x4(&kLink.offset));
+            if(kLink.parent < nodeCount)
+                xmm4_world = DirectX::XMMatrixMultiply(xmm4_world, DirectX::XMLoadFloat4x4(&worldMatrices[kLink.parent]));
+
+            DirectX::XMStoreFloat4x4(&worldMatrices[idxNode], xmm4_world);
+            ins_storeTransform(pWorlds[idxNode], xmm4_world);
+        }
+    });
+
+    // a time missing from the table is solved on the spot through the chain
+    auto findWorld = [&](size_t idxNode, float time){
+        const auto itrTime = std::lower_bound(times.cbegin(), times.cend(), time);
+        if((itrTime != times.cend()) && ((*itrTime) == time))
+            return worlds[FBX_PTRDIFFU(itrTime - times.cbegin()) * nodeCount + idxNode];
+
+        auto xmm4_world = DirectX::XMMatrixIdentity();
+        for(auto idxChain = idxNode; idxChain < nodeCount; idxChain = links[idxChain].parent){
+            const auto& kLink = links[idxChain];
+
+            FBXAnimationCursor cursor;
+            xmm4_world = DirectX::XMMatrixMultiply(xmm4_world, ins_sampleLocalMatrix(pNodes[idxChain], kLink, cursor, time));
+            xmm4_world = DirectX::XMMatrixMultiply(xmm4_world, DirectX::XMLoadFloat4x4(&kLink.offset));
+        }
+
+        FBXAnimationTransform ret;
+        ins_storeTransform(ret, xmm4_world);
+        return ret;
+    };
+
+    std::for_each(std::execution::par, pAnimation->AnimationNodes.Values, pAnimation->AnimationNodes.Values + nodeCount, [&](FBXAnimationNode& cNode){
+        const auto idxNode = FBX_PTRDIFFU(&cNode - pAnimation->AnimationNodes.Values);
+
+        if(cNode.ScalingKeys.Length){
+            ins_rewriteTrack(cNode.ScalingKeys, cNode.ScalingTangents, true, [&](float time){
+                return ins_loadKeyValue(findWorld(idxNode, time).Scaling);
+            });
+        }
+        if(cNode.RotationKeys.Length){
+            ins_rewriteTrack(cNode.RotationKeys, cNode.RotationTangents, true, [&](float time){
+                return ins_loadKeyValue(findWorld(idxNode, time).Rotation);
+            });
+        }
+        if(cNode.TranslationKeys.Length){
+            ins_rewriteTrack(cNode.TranslationKeys, cNode.TranslationTangents, true, [&](float time){
+                return ins_loadKeyValue(findWorld(idxNode, time).Translation);
+            });
+        }
+    });
+
+    if(pAnimation->Samples.Length)
+        SHRResampleAnimation(pAnimation, pAnimation->SampleRate);
+}
+
+
+// brings the key to the hemisphere of the reference and onto the unit sphere. tangents follow if given, keeping only the part along the sphere.
+// keys of zero length are left as they are, as World of keys skipped on import is
+static inline DirectX::XMVECTOR ins_conditionRotationKey(FBXStaticArray<float, 4>& value, FBXAnimationTangent<FBXStaticArray<float, 4>>* pTangent, DirectX::FXMVECTOR xmm_reference){
+    auto xmm_value = ins_loadKeyValue(value);
+
+    const auto xmm_length = DirectX::XMVector4Length(xmm_value);
+    if(DirectX::XMVectorGetX(xmm_length) < FLT_EPSILON)
+        return xmm_reference;
+
+    const auto xmm_flip = DirectX::XMVectorLess(DirectX::XMVector4Dot(xmm_value, xmm_reference), DirectX::XMVectorZero());
+    const auto xmm_scale = DirectX::XMVectorDivide(DirectX::XMVectorSelect(DirectX::g_XMOne, DirectX::g_XMNegativeOne, xmm_flip), xmm_length);
+
+    xmm_value = DirectX::XMVectorMultiply(xmm_value, xmm_scale);
+    ins_storeKeyValue(value, xmm_value);
+
+    if(pTangent){
+        auto xmm_in = DirectX::XMVectorMultiply(ins_loadKeyValue(pTangent->In), xmm_scale);
+        xmm_in = DirectX::XMVectorSubtract(xmm_in, DirectX::XMVectorMultiply(xmm_value, DirectX::XMVector4Dot(xmm_in, xmm_value)));
+
+        auto xmm_out = DirectX::XMVectorMultiply(ins_loadKeyValue(pTangent->Out), xmm_scale);
+        xmm_out = DirectX::XMVectorSubtract(xmm_out, DirectX::XMVectorMultiply(xmm_value, DirectX::XMVector4Dot(xmm_out, xmm_value)));
+
+        ins_storeKeyValue(pTangent->In, xmm_in);
+        ins_storeKeyValue(pTangent->Out, xmm_out);
+    }
+    return xmm_value;
+}
+
+static inline bool ins_flatRotationTangent(const FBXStaticArray<float, 4>& tangent, float tolerance){
+    const auto xmm_slope = DirectX::XMVectorAbs(ins_loadKeyValue(tangent));
+    return DirectX::XMVector4LessOrEqual(xmm_slope, DirectX::XMVectorReplicate(tolerance));
+}
+static inline bool ins_sameRotationKey(const FBXAnimationKeyFrame<FBXStaticArray<float, 4>>& lhs, const FBXAnimationKeyFrame<FBXStaticArray<float, 4>>& rhs, float tolerance){
+    return
+        (ComputeKeyError<KeyErrorType::KeyErrorType_Rotation>(ins_loadKeyValue(lhs.Local), ins_loadKeyValue(rhs.Local)) <= tolerance) &&
+        (ComputeKeyError<KeyErrorType::KeyErrorType_Rotation>(ins_loadKeyValue(lhs.World), ins_loadKeyValue(rhs.World)) <= tolerance)
+        ;
+}
+static inline bool ins_flatRotationSegment(
+    const FBXDynamicArray<FBXAnimationKeyFrame<FBXStaticArray<float, 4>>>& keys,
+    const FBXDynamicArray<FBXAnimationKeyTangent<FBXStaticArray<float, 4>>>& tangents,
+    unsigned long idxLhs,
+    unsigned long idxRhs,
+    float tolerance
+){
+    if(keys.Values[idxLhs].InterpolationType != FBXAnimationInterpolationType::FBXAnimationInterpolationType_Cubic)
+        return true;
+
+    const auto& kLhsTangent = GetKeyTangent(tangents, idxLhs);
+    const auto& kRhsTangent = GetKeyTangent(tangents, idxRhs);
+    return
+        ins_flatRotationTangent(kLhsTangent.Local.Out, tolerance) &&
+        ins_flatRotationTangent(kRhsTangent.Local.In, tolerance) &&
+        ins_flatRotationTangent(kLhsTangent.World.Out, tolerance) &&
+        ins_flatRotationTangent(kRhsTangent.World.In, tolerance)
+        ;
+}
+
+// same rule as the importer. a key goes if it, the last kept key and the next key are the same and both segments around it are flat
+static void ins_collapseRotationKeys(FBXDynamicArray<FBXAnimationKeyFrame<FBXStaticArray<float, 4>>>& keys, FBXDynamicArray<FBXAnimationKeyTangent<FBXStaticArray<float, 4>>>& tangents, float tolerance){
+    if(keys.Length < 2)
+        return;
+
+    fbx_vector<unsigned long> keptKeys;
+    keptKeys.reserve(keys.Length);
+    keptKeys.emplace_back(0);
+
+    for(unsigned long idxKey = 1; (idxKey + 1) < keys.Length; ++idxKey){
+        const auto idxLhs = keptKeys.back();
+        const auto& kLhs = keys.Values[idxLhs];
+        const auto& kCur = keys.Values[idxKey];
+        const auto& kRhs = keys.Values[idxKey + 1];
+
+        if(
+            ins_sameRotationKey(kCur, kLhs, tolerance) &&
+            ins_sameRotationKey(kCur, kRhs, tolerance) &&
+            ins_sameRotationKey(kLhs, kRhs, tolerance) &&
+            ins_flatRotationSegment(keys, tangents, idxLhs, idxKey, tolerance) &&
+            ins_flatRotationSegment(keys, tangents, idxKey, idxKey + 1, tolerance)
+            )
+            continue;
+
+        keptKeys.emplace_back(idxKey);
+    }
+    keptKeys.emplace_back((unsigned long)(keys.Length - 1));
+
+    // a constant track keeps one key
+    if(keptKeys.size() == 2){
+        const auto& kLhs = keys.Values[keptKeys[0]];
+        const auto& kRhs = keys.Values[keptKeys[1]];
+
+        if(ins_sameRotationKey(kLhs, kRhs, tolerance) && ins_flatRotationSegment(keys, tangents, keptKeys[0], keptKeys[1], tolerance))
+            keptKeys.pop_back();
+    }
+
+    if(keptKeys.size() == keys.Length)
+        return;
+
+    ins_keepKeys(keys, tangents, keptKeys);
+}
+
+void SHRNormalizeAnimationRotations(FBXAnimation* pAnimation, float duplicateTolerance){
+    const auto nodeCount = pAnimation->AnimationNodes.Length;
+    if(!nodeCount)
+        return;
+
+    std::for_each(std::execution::par, pAnimation->AnimationNodes.Values, pAnimation->AnimationNodes.Values + nodeCount, [duplicateTolerance](FBXAnimationNode& cNode){
+        auto& cKeys = cNode.RotationKeys;
+        if(!cKeys.Length)
+            return;
+
+        auto& cTangents = cNode.RotationTangents;
+
+        auto xmm_localReference = ins_loadKeyValue(cKeys.Values[0].Local);
+        auto xmm_worldReference = ins_loadKeyValue(cKeys.Values[0].World);
+        for(size_t idxKey = 0u; idxKey < cKeys.Length; ++idxKey){
+            auto& kKey = cKeys.Values[idxKey];
+            auto* pTangent = (idxKey < cTangents.Length) ? &cTangents.Values[idxKey] : nullptr;
+
+            xmm_localReference = ins_conditionRotationKey(kKey.Local, pTangent ? &pTangent->Local : nullptr, xmm_localReference);
+            xmm_worldReference = ins_conditionRotationKey(kKey.World, pTangent ? &pTangent->World : nullptr, xmm_worldReference);
+        }
+
+        if(duplicateTolerance > 0.f)
+            ins_collapseRotationKeys(cKeys, cTangents, duplicateTolerance);
+    });
+
+    if(pAnimation->Samples.Length)
+        SHRResampleAnimation(pAnimation, pAnimation->SampleRate);
+}
+
+
+// bone of a flattened skeleton. rotations are chained without scaling, so only the directions of the bones are carried over
+class _RetargetBone{
+public:
+    const FBXNode* node;
+    size_t parent; // index in the skeleton. bone count for a top node
+    size_t pair; // index of the mapped bone in the other skeleton. bone count if not mapped
+    DirectX::XMFLOAT3 bindScale;
+    DirectX::XMFLOAT4 bindRotation;
+    DirectX::XMFLOAT3 bindTranslation;
+    DirectX::XMFLOAT4 bindWorldRotation;
+};
+using RetargetBoneFinder = fbx_unordered_map<const FBXNode*, size_t, PointerHasher<const FBXNode*>>;
+
+// parents come before their children
+static void ins_flattenSkeleton(fbx_vector<_RetargetBone>& bones, RetargetBoneFinder& boneFinder, const FBXNode* pNodes){
+    fbx_vector<std::pair<const FBXNode*, size_t>> nodeStack;
+    for(const auto* pNode = pNodes; pNode; pNode = pNode->Sibling)
+        nodeStack.emplace_back(pNode, ~size_t(0));
+
+    while(!nodeStack.empty()){
+        const auto [pNode, idxParent] = nodeStack.back();
+        nodeStack.pop_back();
+
+        _RetargetBone newBone;
+        newBone.node = pNode;
+        newBone.parent = idxParent;
+
+        DirectX::XMVECTOR xmm_scale, xmm_rotation, xmm_translation;
+        DecomposeTransform(&xmm_scale, &xmm_rotation, &xmm_translation, DirectX::XMLoadFloat4x4((const DirectX::XMFLOAT4X4*)pNode->TransformMatrix.Values));
+        DirectX::XMStoreFloat3(&newBone.bindScale, xmm_scale);
+        DirectX::XMStoreFloat4(&newBone.bindRotation, xmm_rotation);
+        DirectX::XMStoreFloat3(&newBone.bindTranslation, xmm_translation);
+
+        auto xmm_worldRotation = xmm_rotation;
+        if(idxParent < bones.size())
+            xmm_worldRotation = DirectX::XMQuaternionMultiply(xmm_worldRotation, DirectX::XMLoadFloat4(&bones[idxParent].bindWorldRotation));
+        DirectX::XMStoreFloat4(&newBone.bindWorldRotation, xmm_worldRotation);
+
+        const auto idxBone = bones.size();
+        boneFinder.emplace(pNode, idxBone);
+        bones.emplace_back(std::move(newBone));
+
+        for(const auto* pChild = pNode->Child; pChild; pChild = pChild->Sibling)
+            nodeStack.emplace_back(pChild, idxBone);
+    }
+
+    for(auto& iBone : bones){
+        if(iBone.parent >= bones.size())
+            iBone.parent = bones.size();
+        iBone.pair = ~size_t(0);
+    }
+}
+
+static inline fbx_string ins_nodeName(const FBXNode* pNode){
+    return (pNode->Name.Length && pNode->Name.Values) ? fbx_string(pNode->Name.Values) : fbx_string();
+}
+
+// animation node of the clip retargeted onto a target bone
+class _RetargetTrack{
+public:
+    size_t sourceBone;
+    size_t targetBone;
+    float lengthRatio; // length of the target bone over that of the source bone
+};
+
+class _RetargetSkeletons{
+public:
+    fbx_vector<_RetargetBone> sourceBones;
+    fbx_vector<_RetargetBone> targetBones;
+    RetargetBoneFinder sourceFinder;
+};
+
+// the delta of a bone from its bind pose is taken in world space, and put on the bind pose of the target bone.
+// so bones whose local axes differ between the skeletons still move the same way in world space
+static void ins_solveRetargetPose(
+    FBXAnimationTransform* pLocals,
+    const _RetargetSkeletons& skeletons,
+    const FBXAnimation& kSource,
+    const fbx_vector<size_t>& animationNodes,
+    const fbx_vector<_RetargetTrack>& tracks,
+    float time
+){
+    const auto& sourceBones = skeletons.sourceBones;
+    const auto& targetBones = skeletons.targetBones;
+    const auto sourceCount = sourceBones.size();
+    const auto targetCount = targetBones.size();
+
+    fbx_vector<DirectX::XMFLOAT4> sourceWorlds(sourceCount);
+    for(size_t idxBone = 0u; idxBone < sourceCount; ++idxBone){
+        const auto& kBone = sourceBones[idxBone];
+
+        auto xmm_rotation = DirectX::XMLoadFloat4(&kBone.bindRotation);
+        if(animationNodes[idxBone] < kSource.AnimationNodes.Length){
+            const auto& kNode = kSource.AnimationNodes.Values[animationNodes[idxBone]];
+            unsigned long cursor = 0;
+            if(kNode.RotationKeys.Length)
+                xmm_rotation = ins_sampleTrack(kNode.RotationKeys, kNode.RotationTangents, false, cursor, time);
+        }
+        if(kBone.parent < sourceCount)
+            xmm_rotation = DirectX::XMQuaternionMultiply(xmm_rotation, DirectX::XMLoadFloat4(&sourceWorlds[kBone.parent]));
+
+        DirectX::XMStoreFloat4(&sourceWorlds[idxBone], xmm_rotation);
+    }
+
+    fbx_vector<DirectX::XMFLOAT4> targetWorlds(targetCount);
+    for(size_t idxBone = 0u; idxBone < targetCount; ++idxBone){
+        const auto& kBone = targetBones[idxBone];
+
+        DirectX::XMVECTOR xmm_rotation;
+        if(kBone.pair < sourceCount){
+            const auto& kPair = sourceBones[kBone.pair];
+            const auto xmm_delta = DirectX::XMQuaternionMultiply(
+                DirectX::XMQuaternionConjugate(DirectX::XMLoadFloat4(&kPair.bindWorldRotation)),
+                DirectX::XMLoadFloat4(&sourceWorlds[kBone.pair])
+            );
+            xmm_rotation = DirectX::XMQuaternionMultiply(DirectX::XMLoadFloat4(&kBone.bindWorldRotation), xmm_delta);
+        }
+        else{
+            xmm_rotation = DirectX::XMLoadFloat4(&kBone.bindRotation);
+            if(kBone.parent < targetCount)
+                xmm_rotation = DirectX::XMQuaternionMultiply(xmm_rotation, DirectX::XMLoadFloat4(&targetWorlds[kBone.parent]));
+        }
+
+        DirectX::XMStoreFloat4(&targetWorlds[idxBone], DirectX::XMQuaternionNormalize(xmm_rotation));
+    }
+
+    for(size_t idxTrack = 0u; idxTrack < tracks.size(); ++idxTrack){
+        const auto& kTrack = tracks[idxTrack];
+        const auto& kSourceBone = sourceBones[kTrack.sourceBone];
+        const auto& kTargetBone = targetBones[kTrack.targetBone];
+        const auto& kNode = kSource.AnimationNodes.Values[animationNodes[kTrack.sourceBone]];
+        auto& cLocal = pLocals[idxTrack];
+
+        const auto xmm_sourceParent = (kSourceBone.parent < sourceCount) ? DirectX::XMLoadFloat4(&sourceWorlds[kSourceBone.parent]) : DirectX::XMQuaternionIdentity();
+        const auto xmm_targetParentInv = (kTargetBone.parent < targetCount) ? DirectX::XMQuaternionConjugate(DirectX::XMLoadFloat4(&targetWorlds[kTargetBone.parent])) : DirectX::XMQuaternionIdentity();
+
+        ins_storeKeyValue(cLocal.Rotation, DirectX::XMQuaternionNormalize(DirectX::XMQuaternionMultiply(DirectX::XMLoadFloat4(&targetWorlds[kTrack.targetBone]), xmm_targetParentInv)));
+
+        // scaling is relative to the bind scale
+        {
+            const auto xmm_sourceBind = DirectX::XMLoadFloat3(&kSourceBone.bindScale);
+            auto xmm_scale = xmm_sourceBind;
+            unsigned long cursor = 0;
+            if(kNode.ScalingKeys.Length)
+                xmm_scale = ins_sampleTrack(kNode.ScalingKeys, kNode.ScalingTangents, false, cursor, time);
+
+            const auto xmm_collapsed = DirectX::XMVectorNearEqual(xmm_sourceBind, DirectX::XMVectorZero(), DirectX::XMVectorReplicate(FLT_EPSILON));
+            xmm_scale = DirectX::XMVectorSelect(DirectX::XMVectorDivide(xmm_scale, xmm_sourceBind), DirectX::g_XMOne, xmm_collapsed);
+            ins_storeKeyValue(cLocal.Scaling, DirectX::XMVectorMultiply(DirectX::XMLoadFloat3(&kTargetBone.bindScale), xmm_scale));
+        }
+
+        // the offset of translation from the bind goes from the parent space of the source to that of the target, scaled by the limb length
+        {
+            const auto xmm_sourceBind = DirectX::XMLoadFloat3(&kSourceBone.bindTranslation);
+            auto xmm_translation = xmm_sourceBind;
+            unsigned long cursor = 0;
+            if(kNode.TranslationKeys.Length)
+                xmm_translation = ins_sampleTrack(kNode.TranslationKeys, kNode.TranslationTangents, false, cursor, time);
+
+            auto xmm_offset = DirectX::XMVector3Rotate(DirectX::XMVectorSubtract(xmm_translation, xmm_sourceBind), DirectX::XMQuaternionMultiply(xmm_sourceParent, xmm_targetParentInv));
+            xmm_offset = DirectX::XMVectorScale(xmm_offset, kTrack.lengthRatio);
+            ins_storeKeyValue(cLocal.Translation, DirectX::XMVectorAdd(DirectX::XMLoadFloat3(&kTargetBone.bindTranslation), xmm_offset));
+        }
+    }
+}
+
+static void ins_retargetAnimation(FBXAnimation& cOut, const FBXAnimation& kSource, const _RetargetSkeletons& skeletons){
+    const auto& sourceBones = skeletons.sourceBones;
+    const auto& targetBones = skeletons.targetBones;
+
+    fbx_vector<size_t> animationNodes(sourceBones.size(), kSource.AnimationNodes.Length);
+    fbx_vector<_RetargetTrack> tracks;
+    for(size_t idxNode = 0u; idxNode < kSource.AnimationNodes.Length; ++idxNode){
+        auto itrBone = skeletons.sourceFinder.find(kSource.AnimationNodes.Values[idxNode].BindNode);
+        if(itrBone == skeletons.sourceFinder.end())
+            continue;
+
+        const auto idxBone = itrBone->second;
+        animationNodes[idxBone] = idxNode;
+
+        const auto& kBone = sourceBones[idxBone];
+        if(kBone.pair >= targetBones.size())
+            continue;
+
+        _RetargetTrack newTrack;
+        newTrack.sourceBone = idxBone;
+        newTrack.targetBone = kBone.pair;
+
+        const auto fSourceLength = DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMLoadFloat3(&kBone.bindTranslation)));
+        const auto fTargetLength = DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMLoadFloat3(&targetBones[kBone.pair].bindTranslation)));
+        newTrack.lengthRatio = ((fSourceLength > FLT_EPSILON) && (fTargetLength > FLT_EPSILON)) ? (fTargetLength / fSourceLength) : 1.f;
+
+        tracks.emplace_back(std::move(newTrack));
+    }
+
+    FBXAnimation newAnimation;
+    newAnimation.Name = kSource.Name;
+    newAnimation.EndTime = kSource.EndTime;
+    newAnimation.AnimationNodes.Assign(tracks.size());
+
+    // target tracks are keyed on the times of the source tracks
+    fbx_vector<float> times;
+    for(size_t idxTrack = 0u; idxTrack < tracks.size(); ++idxTrack){
+        const auto& kNode = kSource.AnimationNodes.Values[animationNodes[tracks[idxTrack].sourceBone]];
+        auto& cNode = newAnimation.AnimationNodes.Values[idxTrack];
+
+        cNode.BindNode = const_cast<FBXNode*>(targetBones[tracks[idxTrack].targetBone].node);
+        cNode.ScalingKeys = kNode.ScalingKeys;
+        cNode.RotationKeys = kNode.RotationKeys;
+        cNode.TranslationKeys = kNode.TranslationKeys;
+
+        ins_collectKeyTimes(times, kNode.ScalingKeys);
+        ins_collectKeyTimes(times, kNode.RotationKeys);
+        ins_collectKeyTimes(times, kNode.TranslationKeys);
+    }
+    std::sort(times.begin(), times.end());
+    times.erase(std::unique(times.begin(), times.end()), times.end());
+
+    fbx_vector<FBXAnimationTransform> locals(times.size() * tracks.size());
+    std::for_each(std::execution::par, times.cbegin(), times.cend(), [&](const float& time){
+        const auto idxTime = FBX_PTRDIFFU(&time - times.data());
+        ins_solveRetargetPose(locals.data() + idxTime * tracks.size(), skeletons, kSource, animationNodes, tracks, time);
+    });
+
+    auto findLocal = [&](size_t idxTrack, float time){
+        const auto itrTime = std::lower_bound(times.cbegin(), times.cend(), time);
+        if((itrTime != times.cend()) && ((*itrTime) == time))
+            return locals[FBX_PTRDIFFU(itrTime - times.cbegin()) * tracks.size() + idxTrack];
+
+        fbx_vector<FBXAnimationTransform> pose(tracks.size());
+        ins_solveRetargetPose(pose.data(), skeletons, kSource, animationNodes, tracks, time);
+        return pose[idxTrack];
+    };
+
+    std::for_each(std::execution::par, newAnimation.AnimationNodes.Values, newAnimation.AnimationNodes.Values + tracks.size(), [&](FBXAnimationNode& cNode){
+        const auto idxTrack = FBX_PTRDIFFU(&cNode - newAnimation.AnimationNodes.Values);
+
+        if(cNode.ScalingKeys.Length){
+            ins_rewriteTrack(cNode.ScalingKeys, cNode.ScalingTangents, false, [&](float time){
+                return ins_loadKeyValue(findLocal(idxTrack, time).Scaling);
+            });
+        }
+        if(cNode.RotationKeys.Length){
+            ins_rewriteTrack(cNode.RotationKeys, cNode.RotationTangents, false, [&](float time){
+                return ins_loadKeyValue(findLocal(idxTrack, time).Rotation);
+            });
+        }
+        if(cNode.TranslationKeys.Length){
+            ins_rewriteTrack(cNode.TranslationKeys, cNode.TranslationTangents, false, [&](float time){
+                return ins_loadKeyValue(findLocal(idxTrack, time).Translation);
+            });
+        }
+    });
+
+    SHRBuildAnimationWorldKeys(&newAnimation);
+    if(kSource.Samples.Length)
+        SHRResampleAnimation(&newAnimation, kSource.SampleRate);
+
+    cOut = std::move(newAnimation);
+}
+
+
+bool SHRRetargetAnimations(
+    FBXAnimation* pOutAnimations,
+    const FBXAnimation* pAnimations,
+    unsigned long animationCount,
+    const FBXNode* pSourceNodes,
+    const FBXNode* pTargetNodes,
+    const FBX_CHAR* const* szSourceNames,
+    const FBX_CHAR* const* szTargetNames,
+    unsigned long mappingCount
+){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("SHRRetargetAnimations(FBXAnimation*, const FBXAnimation*, unsigned long, const FBXNode*, const FBXNode*, const FBX_CHAR* const*, const FBX_CHAR* const*, unsigned long)");
+
+
+    _RetargetSkeletons skeletons;
+    {
+        RetargetBoneFinder targetFinder;
+        ins_flattenSkeleton(skeletons.sourceBones, skeletons.sourceFinder, pSourceNodes);
+        ins_flattenSkeleton(skeletons.targetBones, targetFinder, pTargetNodes);
+    }
+
+    auto& sourceBones = skeletons.sourceBones;
+    auto& targetBones = skeletons.targetBones;
+
+    {
+        using BoneNameFinder = fbx_unordered_map<fbx_string, size_t, StringHasher<fbx_basic_string, FBX_CHAR>>;
+
+        auto buildNameFinder = [](BoneNameFinder& nameFinder, const fbx_vector<_RetargetBone>& bones){
+            nameFinder.rehash(bones.size() << 1);
+            for(size_t idxBone = 0u; idxBone < bones.size(); ++idxBone)
+                nameFinder.emplace(ins_nodeName(bones[idxBone].node), idxBone);
+        };
+        auto pairBones = [&](size_t idxSource, size_t idxTarget){
+            sourceBones[idxSource].pair = idxTarget;
+            targetBones[idxTarget].pair = idxSource;
+        };
+
+        BoneNameFinder sourceNames;
+        buildNameFinder(sourceNames, sourceBones);
+
+        if(mappingCount){
+            BoneNameFinder targetNames;
+            buildNameFinder(targetNames, targetBones);
+
+            for(unsigned long idxMapping = 0; idxMapping < mappingCount; ++idxMapping){
+                auto itrSource = sourceNames.find(fbx_string(szSourceNames[idxMapping]));
+                if(itrSource == sourceNames.end()){
+                    fbx_string msg = FBX_TEXT("source bone not found: ");
+                    msg += szSourceNames[idxMapping];
+                    SHRPushErrorMessage(std::move(msg), __name_of_this_func);
+                    return false;
+                }
+
+                auto itrTarget = targetNames.find(fbx_string(szTargetNames[idxMapping]));
+                if(itrTarget == targetNames.end()){
+                    fbx_string msg = FBX_TEXT("target bone not found: ");
+                    msg += szTargetNames[idxMapping];
+                    SHRPushErrorMessage(std::move(msg), __name_of_this_func);
+                    return false;
+                }
+
+                pairBones(itrSource->second, itrTarget->second);
+            }
+        }
+        else{
+            for(size_t idxTarget = 0u; idxTarget < targetBones.size(); ++idxTarget){
+                auto itrSource = sourceNames.find(ins_nodeName(targetBones[idxTarget].node));
+                if(itrSource != sourceNames.end())
+                    pairBones(itrSource->second, idxTarget);
+            }
+        }
+
+        // a bone mapped twice keeps the last pair only
+        for(size_t idxSource = 0u; idxSource < sourceBones.size(); ++idxSource){
+            auto& cBone = sourceBones[idxSource];
+            if((cBone.pair < targetBones.size()) && (targetBones[cBone.pair].pair != idxSource))
+                cBone.pair = ~size_t(0);
+        }
+        for(size_t idxTarget = 0u; idxTarget < targetBones.size(); ++idxTarget){
+            auto& cBone = targetBones[idxTarget];
+            if((cBone.pair < sourceBones.size()) && (sourceBones[cBone.pair].pair != idxTarget))
+                cBone.pair = ~size_t(0);
+        }
+    }
+
+    // clips do not share anything but the skeletons
+    std::for_each(std::execution::par, pAnimations, pAnimations + animationCount, [&](const FBXAnimation& kSource){
+        const auto idxAnimation = FBX_PTRDIFFU(&kSource - pAnimations);
+        ins_retargetAnimation(pOutAnimations[idxAnimation], kSource, skeletons);
+    });
+
+    return true;
+}
+
+
+// value and slope(per second) of a segment at the time, exactly as the samplers evaluate it
+template<unsigned long N>
+static inline void ins_splitSegment(
+    FBXStaticArray<float, N>& value,
+    FBXAnimationTangent<FBXStaticArray<float, N>>* pTangent,
+    const FBXDynamicArray<FBXAnimationKeyFrame<FBXStaticArray<float, N>>>& keys,
+    const FBXDynamicArray<FBXAnimationKeyTangent<FBXStaticArray<float, N>>>& tangents,
+    unsigned long idxFrom,
+    bool bWorld,
+    float time
+){
+    const auto& kFrom = keys.Values[idxFrom];
+    const auto& kTo = keys.Values[idxFrom + 1];
+
+    const auto& kFromValue = bWorld ? kFrom.World : kFrom.Local;
+    const auto& kToValue = bWorld ? kTo.World : kTo.Local;
+
+    const auto fDuration = kTo.Time - kFrom.Time;
+    const auto fTime = (time - kFrom.Time) / fDuration;
+
+    auto xmm_value = ins_loadKeyValue(kFromValue);
+    auto xmm_slope = DirectX::XMVectorZero();
+
+    switch(kFrom.InterpolationType){
+    case FBXAnimationInterpolationType::FBXAnimationInterpolationType_Linear:
+    {
+        float interpolated[N];
+        InterpolateKeyValue<float, N>(interpolated, &kFromValue, &kToValue, fTime);
+        if constexpr(N == 4)
+            xmm_value = DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)interpolated);
+        else
+            xmm_value = DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)interpolated);
+        break;
+    }
+    case FBXAnimationInterpolationType::FBXAnimationInterpolationType_Cubic:
+    {
+        const auto xmm_v0 = xmm_value;
+        const auto& kFromTangent = bWorld ? GetKeyTangent(tangents, idxFrom).World : GetKeyTangent(tangents, idxFrom).Local;
+        const auto& kToTangent = bWorld ? GetKeyTangent(tangents, idxFrom + 1).World : GetKeyTangent(tangents, idxFrom + 1).Local;
+
+        const auto xmm_t0 = DirectX::XMVectorScale(ins_loadKeyValue(kFromTangent.Out), fDuration);
+        auto xmm_v1 = ins_loadKeyValue(kToValue);
+        auto xmm_t1 = DirectX::XMVectorScale(ins_loadKeyValue(kToTangent.In), fDuration);
+        if constexpr(N == 4){
+            if(DirectX::XMVectorGetX(DirectX::XMVector4Dot(xmm_v0, xmm_v1)) < 0.f){
+                xmm_v1 = DirectX::XMVectorNegate(xmm_v1);
+                xmm_t1 = DirectX::XMVectorNegate(xmm_t1);
+            }
+        }
+
+        xmm_value = DirectX::XMVectorHermite(xmm_v0, xmm_t0, xmm_v1, xmm_t1, fTime);
+
+        // derivative of the hermite basis, brought back to per second
+        const auto fTime2 = fTime * fTime;
+        xmm_slope = DirectX::XMVectorScale(DirectX::XMVectorSubtract(xmm_v1, xmm_v0), 6.f * (fTime - fTime2));
+        xmm_slope = DirectX::XMVectorAdd(xmm_slope, DirectX::XMVectorScale(xmm_t0, 3.f * fTime2 - 4.f * fTime + 1.f));
+        xmm_slope = DirectX::XMVectorAdd(xmm_slope, DirectX::XMVectorScale(xmm_t1, 3.f * fTime2 - 2.f * fTime));
+        xmm_slope = DirectX::XMVectorScale(xmm_slope, 1.f / fDuration);
+        break;
+    }
+    default:
+        break;
+    }
+
+    ins_storeKeyValue(value, xmm_value);
+    if(pTangent){
+        ins_storeKeyValue(pTangent->In, xmm_slope);
+        ins_storeKeyValue(pTangent->Out, xmm_slope);
+    }
+
+    // hermite of rotations is normalized after evaluation, so the key goes onto the unit sphere with its slope
+    if constexpr(N == 4)
+        ins_conditionRotationKey(value, pTangent, xmm_value);
+}
+
+// keys over [startTime, endTime] moved to start from 0. keys inside are copied as they are, and a boundary inside a segment gets a key cut from it.
+// a boundary out of the keys needs no key, since sampling clamps to the first and the last keys
+template<unsigned long N>
+static void ins_extractTrack(
+    FBXDynamicArray<FBXAnimationKeyFrame<FBXStaticArray<float, N>>>& outKeys,
+    FBXDynamicArray<FBXAnimationKeyTangent<FBXStaticArray<float, N>>>& outTangents,
+    const FBXDynamicArray<FBXAnimationKeyFrame<FBXStaticArray<float, N>>>& keys,
+    const FBXDynamicArray<FBXAnimationKeyTangent<FBXStaticArray<float, N>>>& tangents,
+    float startTime,
+    float endTime
+){
+    using KeyFrame = FBXAnimationKeyFrame<FBXStaticArray<float, N>>;
+
+    if(!keys.Length){
+        outKeys.Clear();
+        outTangents.Clear();
+        return;
+    }
+
+    const auto* pBegin = keys.Values;
+    const auto* pEnd = keys.Values + keys.Length;
+
+    // first key after startTime, and first key after endTime
+    const auto* pFirst = std::upper_bound(pBegin, pEnd, startTime, [](float t, const KeyFrame& k){ return t < k.Time; });
+    const auto* pLast = pFirst;
+    while((pLast != pEnd) && (pLast->Time <= endTime))
+        ++pLast;
+
+    const bool bSplitStart = (pFirst != pBegin) && (pFirst != pEnd) && ((pFirst - 1)->Time != startTime);
+    const bool bCopyStart = (pFirst != pBegin) && ((pFirst - 1)->Time == startTime);
+    const bool bSplitEnd = (pLast != pBegin) && (pLast != pEnd) && ((pLast - 1)->Time != endTime) && (endTime > startTime);
+
+    // a range out of the keys gets one key holding the value there
+    const auto keyCount = std::max<size_t>(FBX_PTRDIFFU(pLast - pFirst) + (bSplitStart ? 1u : 0u) + (bCopyStart ? 1u : 0u) + (bSplitEnd ? 1u : 0u), 1u);
+
+    outKeys.Assign(keyCount);
+    auto* pOut = outKeys.Values;
+
+    // a key cut from a cubic segment takes the slope there, even if the source track has no tangents
+    const bool bTangents = ins_hasCubicKey(keys);
+    if(bTangents)
+        outTangents.Assign(keyCount);
+    else
+        outTangents.Clear();
+
+    auto copyKey = [&](KeyFrame* pDest, const KeyFrame* pSource){
+        (*pDest) = (*pSource);
+        if(bTangents)
+            outTangents.Values[pDest - outKeys.Values] = GetKeyTangent(tangents, FBX_PTRDIFFU(pSource - pBegin));
+    };
+    auto splitKey = [&](KeyFrame* pDest, const KeyFrame* pFrom, float time){
+        auto* pTangent = bTangents ? &outTangents.Values[pDest - outKeys.Values] : nullptr;
+        const auto idxFrom = (unsigned long)FBX_PTRDIFFU(pFrom - pBegin);
+        ins_splitSegment<N>(pDest->Local, pTangent ? &pTangent->Local : nullptr, keys, tangents, idxFrom, false, time);
+        ins_splitSegment<N>(pDest->World, pTangent ? &pTangent->World : nullptr, keys, tangents, idxFrom, true, time);
+        pDest->InterpolationType = pFrom->InterpolationType;
+    };
+
+    if(bCopyStart){
+        copyKey(pOut, pFirst - 1);
+        pOut->Time = 0.f;
+        ++pOut;
+    }
+    else if(bSplitStart){
+        splitKey(pOut, pFirst - 1, startTime);
+        pOut->Time = 0.f;
+        ++pOut;
+    }
+
+    for(const auto* pKey = pFirst; pKey != pLast; ++pKey, ++pOut){
+        copyKey(pOut, pKey);
+        pOut->Time -= startTime;
+    }
+
+    if(bSplitEnd){
+        splitKey(pOut, pLast - 1, endTime);
+        pOut->Time = endTime - startTime;
+        ++pOut;
+    }
+
+    if(pOut == outKeys.Values){
+        copyKey(pOut, (pFirst == pBegin) ? pBegin : (pEnd - 1));
+        pOut->Time = 0.f;
+    }
+
+    if(bTangents && (!ins_hasCubicKey(outKeys)))
+        outTangents.Clear();
+}
+
+
+void SHRSplitAnimation(FBXAnimation* pOutAnimations, const FBXAnimation* pAnimation, const float* pTimeRanges, unsigned long rangeCount){
+    const auto nodeCount = pAnimation->AnimationNodes.Length;
+
+    std::for_each(std::execution::par, pOutAnimations, pOutAnimations + rangeCount, [&](FBXAnimation& cOut){
+        const auto idxRange = FBX_PTRDIFFU(&cOut - pOutAnimations);
+        const auto startTime = std::clamp(pTimeRanges[idxRange << 1], 0.f, pAnimation->EndTime);
+        const auto endTime = std::clamp(pTimeRanges[(idxRange << 1) + 1], startTime, pAnimation->EndTime);
+
+        cOut.Name = pAnimation->Name;
+        cOut.EndTime = endTime - startTime;
+        cOut.HasWorldKeys = pAnimation->HasWorldKeys;
+        cOut.Samples.Clear();
+        cOut.SampleFrameCount = 0;
+        cOut.SampleRate = 0.f;
+
+        cOut.AnimationNodes.Assign(nodeCount);
+        for(size_t idxNode = 0u; idxNode < nodeCount; ++idxNode){
+            const auto& kNode = pAnimation->AnimationNodes.Values[idxNode];
+            auto& cNode = cOut.AnimationNodes.Values[idxNode];
+
+            cNode.BindNode = kNode.BindNode;
+            cNode.HasWorldKeys = kNode.HasWorldKeys;
+            ins_extractTrack(cNode.ScalingKeys, cNode.ScalingTangents, kNode.ScalingKeys, kNode.ScalingTangents, startTime, endTime);
+            ins_extractTrack(cNode.RotationKeys, cNode.RotationTangents, kNode.RotationKeys, kNode.RotationTangents, startTime, endTime);
+            ins_extractTrack(cNode.TranslationKeys, cNode.TranslationTangents, kNode.TranslationKeys, kNode.TranslationTangents, startTime, endTime);
+        }
+
+        if(pAnimation->Samples.Length)
+            SHRResampleAnimation(&cOut, pAnimation->SampleRate);
+    });
+}
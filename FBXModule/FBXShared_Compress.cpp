@@ -0,0 +1,893 @@
+﻿/**
+ * @file FBXShared_Compress.cpp
+ * @date 2026/10/19
+ * @author Lim Taewoo (limztudio@gmail.com)
+ */
+
+
+#include "stdafx.h"
+
+#include <algorithm>
+#include <cstring>
+#include <execution>
+
+#include "FBXUtilites.h"
+#include "FBXMath.h"
+#include "FBXShared.h"
+
+
+// Data of FBXCompressedAnimation is laid out as
+// [_CompressedHeader][_CompressedTrack x NodeCount x 3][key ticks][key bits][padding]
+// tracks of a node are in scaling, rotation and translation order.
+// keys of a track are fixed width records, so any key is read by its index without decoding the others
+// a block of FBXStreamingAnimation is [_StreamingBlockHeader][same layout as above over the block], padded to ins_blockAlignment
+
+
+// key times are quantized over [0, EndTime] to this range
+static const float ins_maxTick = 65535.f;
+
+// bits of a component. rotation keys take three components and two bits of the dropped component index
+static const unsigned long ins_maxVectorBitRate = 16;
+static const unsigned long ins_maxRotationBitRate = 15;
+
+// records are read by an unaligned 8 bytes load, so the end of the bits is padded
+static const size_t ins_bitPadding = sizeof(unsigned long long);
+
+// smallest three components of a unit quaternion are always in [-1/sqrt(2), 1/sqrt(2)]
+static const float ins_smallestThreeRange = 0.70710678f;
+
+// blocks are read in place, so each of them starts where the headers can be loaded from
+static const size_t ins_blockAlignment = 8;
+
+
+enum class _CompressedTrackType : unsigned char{
+    _CompressedTrackType_Identity,
+    _CompressedTrackType_Constant,
+    _CompressedTrackType_Animated,
+};
+
+class _CompressedHeader{
+public:
+    float tickRate; // ticks per second
+    unsigned long tickOffset; // byte offset of key ticks in Data
+    unsigned long bitOffset; // byte offset of key bits in Data
+};
+class _CompressedTrack{
+public:
+    // constant track keeps the value. animated vector track keeps minimum and step of each component
+    float range[6];
+    unsigned long keyCount;
+    unsigned long firstTick; // index of key ticks
+    unsigned long firstBit; // bit position of key bits
+    _CompressedTrackType type;
+    unsigned char bitRate; // bits per component
+};
+
+class _StreamingBlockHeader{
+public:
+    float startTime;
+    float duration;
+    unsigned long nodeCount;
+    unsigned long size; // bytes of the block including this header and padding
+};
+
+class _CompressedView{
+public:
+    const unsigned short* ticks;
+    const unsigned char* bits;
+};
+
+// output of a track before the tracks are laid out
+class _EncodedTrack{
+public:
+    _CompressedTrack track;
+    fbx_vector<unsigned short> ticks;
+    fbx_vector<unsigned long long> records;
+    unsigned long recordBits;
+
+    float extent[3]; // of animated vector track
+};
+
+// key right after a stepped segment takes the tick rounded down, so sampling exactly on its time never reads the key before.
+// hold key goes one tick before that, and keeps the value of the stepped segment until there
+enum class _LinearKeyType : unsigned char{
+    _LinearKeyType_Regular,
+    _LinearKeyType_Step,
+    _LinearKeyType_Hold,
+};
+
+class _LinearKey{
+public:
+    DirectX::XMFLOAT4 value;
+    float time;
+    _LinearKeyType type;
+};
+
+
+template<unsigned long N>
+static inline DirectX::XMVECTOR ins_loadValue(const float* value){
+    if constexpr(N == 4)
+        return DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)value);
+    else
+        return DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)value);
+}
+
+template<unsigned long N>
+static inline DirectX::XMVECTOR ins_alignValue(DirectX::FXMVECTOR xmm_value, DirectX::FXMVECTOR xmm_reference){
+    if constexpr(N == 4){
+        if(DirectX::XMVectorGetX(DirectX::XMVector4Dot(xmm_value, xmm_reference)) < 0.f)
+            return DirectX::XMVectorNegate(xmm_value);
+    }
+    return xmm_value;
+}
+
+// decompression only takes lerp, and nlerp for rotations
+template<unsigned long N>
+static inline DirectX::XMVECTOR ins_interpolateValue(DirectX::FXMVECTOR xmm_from, DirectX::FXMVECTOR xmm_to, float weight){
+    if constexpr(N == 4){
+        auto xmm_ret = DirectX::XMVectorLerp(xmm_from, ins_alignValue<N>(xmm_to, xmm_from), weight);
+        return DirectX::XMQuaternionNormalize(xmm_ret);
+    }
+    else
+        return DirectX::XMVectorLerp(xmm_from, xmm_to, weight);
+}
+
+// tracks without a bind node are taken as bound to identity
+static inline void ins_loadBindTransform(DirectX::XMVECTOR& xmm_scaling, DirectX::XMVECTOR& xmm_rotation, DirectX::XMVECTOR& xmm_translation, const FBXNode* pNode, bool bWorld){
+    FbxAMatrix matBind;
+    if(!pNode)
+        matBind.SetIdentity();
+    else if(bWorld)
+        matBind = GetBindWorldTransform(pNode);
+    else
+        CopyArrayData<pNode->TransformMatrix.Length>((double*)matBind, pNode->TransformMatrix.Values);
+
+    float value[4];
+
+    CopyArrayData<3>(value, matBind.GetS().mData);
+    xmm_scaling = ins_loadValue<3>(value);
+
+    CopyArrayData<4>(value, matBind.GetQ().mData);
+    xmm_rotation = ins_loadValue<4>(value);
+
+    CopyArrayData<3>(value, matBind.GetT().mData);
+    xmm_translation = ins_loadValue<3>(value);
+}
+
+
+static inline void ins_writeBits(unsigned char* bits, unsigned long long position, unsigned long long value, unsigned long count){
+    while(count){
+        const auto shift = (unsigned long)(position & 7u);
+        const auto written = std::min(8u - shift, count);
+
+        bits[position >> 3] |= (unsigned char)((value & ((1u << written) - 1u)) << shift);
+
+        value >>= written;
+        position += written;
+        count -= written;
+    }
+}
+static inline unsigned long long ins_readBits(const unsigned char* bits, unsigned long long position){
+    unsigned long long ret;
+    std::memcpy(&ret, bits + (position >> 3), sizeof(ret));
+    return ret >> (position & 7u);
+}
+
+
+// cubic and slerp segments are split until lerp of both ends is within the tolerance.
+// minDuration keeps the split keys on different ticks
+template<KeyErrorType TYPE, unsigned long N, typename FUNC>
+static void ins_linearizeSegment(
+    fbx_vector<_LinearKey>& linearKeys,
+    FUNC&& fnSample,
+    float fromTime,
+    DirectX::FXMVECTOR xmm_from,
+    float toTime,
+    DirectX::FXMVECTOR xmm_to,
+    float minDuration,
+    float tolerance
+){
+    static const float samplePoints[] = { 0.25f, 0.5f, 0.75f };
+
+    const auto fDuration = toTime - fromTime;
+    if(fDuration <= minDuration)
+        return;
+
+    bool bFit = true;
+    for(const auto& fWeight : samplePoints){
+        if(ComputeKeyError<TYPE>(fnSample(fromTime + fDuration * fWeight), ins_interpolateValue<N>(xmm_from, xmm_to, fWeight)) > tolerance){
+            bFit = false;
+            break;
+        }
+    }
+    if(bFit)
+        return;
+
+    const auto fMiddle = fromTime + fDuration * 0.5f;
+    const auto xmm_middle = ins_alignValue<N>(fnSample(fMiddle), xmm_from);
+
+    ins_linearizeSegment<TYPE, N>(linearKeys, fnSample, fromTime, xmm_from, fMiddle, xmm_middle, minDuration, tolerance);
+    {
+        _LinearKey newKey;
+        DirectX::XMStoreFloat4(&newKey.value, xmm_middle);
+        newKey.time = fMiddle;
+        newKey.type = _LinearKeyType::_LinearKeyType_Regular;
+        linearKeys.emplace_back(std::move(newKey));
+    }
+    ins_linearizeSegment<TYPE, N>(linearKeys, fnSample, fMiddle, xmm_middle, toTime, ins_alignValue<N>(xmm_to, xmm_middle), minDuration, tolerance);
+}
+
+// stepped segments are closed by a hold key, so lerp keeps the value of the segment
+template<KeyErrorType TYPE, unsigned long N>
+static void ins_linearizeTrack(
+    fbx_vector<_LinearKey>& linearKeys,
+    const FBXDynamicArray<FBXAnimationKeyFrame<FBXStaticArray<float, N>>>& keys,
+    const FBXDynamicArray<FBXAnimationKeyTangent<FBXStaticArray<float, N>>>& tangents,
+    bool bWorld,
+    float tickDuration,
+    float tolerance
+){
+    unsigned long cursor = 0;
+    auto fnSample = [&keys, &tangents, bWorld, &cursor](float time){
+        float value[N];
+        if(bWorld)
+            ComputeWorldKeyByTime(value, time, &keys, &tangents, &cursor);
+        else
+            ComputeLocalKeyByTime(value, time, &keys, &tangents, &cursor);
+        return ins_loadValue<N>(value);
+    };
+
+    linearKeys.reserve(keys.Length);
+
+    auto xmm_prev = DirectX::XMQuaternionIdentity();
+    auto keyType = _LinearKeyType::_LinearKeyType_Regular;
+    for(size_t idxKey = 0u; idxKey < keys.Length; ++idxKey){
+        const auto& kKey = keys.Values[idxKey];
+        const auto xmm_value = ins_alignValue<N>(ins_loadValue<N>(bWorld ? kKey.World.Values : kKey.Local.Values), xmm_prev);
+        xmm_prev = xmm_value;
+
+        {
+            _LinearKey newKey;
+            DirectX::XMStoreFloat4(&newKey.value, xmm_value);
+            newKey.time = kKey.Time;
+            newKey.type = keyType;
+            linearKeys.emplace_back(std::move(newKey));
+        }
+        keyType = _LinearKeyType::_LinearKeyType_Regular;
+
+        if((idxKey + 1) >= keys.Length)
+            break;
+
+        const auto& kNextKey = keys.Values[idxKey + 1];
+        if(kKey.InterpolationType == FBXAnimationInterpolationType::FBXAnimationInterpolationType_Stepped){
+            _LinearKey newKey;
+            DirectX::XMStoreFloat4(&newKey.value, xmm_value);
+            newKey.time = kNextKey.Time;
+            newKey.type = _LinearKeyType::_LinearKeyType_Hold;
+            linearKeys.emplace_back(std::move(newKey));
+
+            keyType = _LinearKeyType::_LinearKeyType_Step;
+        }
+        // linear vector segments are already what lerp makes
+        else if((N == 4) || (kKey.InterpolationType != FBXAnimationInterpolationType::FBXAnimationInterpolationType_Linear)){
+            const auto xmm_next = ins_alignValue<N>(ins_loadValue<N>(bWorld ? kNextKey.World.Values : kNextKey.Local.Values), xmm_value);
+            ins_linearizeSegment<TYPE, N>(linearKeys, fnSample, kKey.Time, xmm_value, kNextKey.Time, xmm_next, tickDuration * 2.f, tolerance);
+        }
+    }
+}
+
+
+// quantizes every key with bitRate, and returns whether all of them are within the tolerance
+template<KeyErrorType TYPE, unsigned long N>
+static bool ins_quantizeKeys(_EncodedTrack& cOut, const fbx_vector<DirectX::XMFLOAT4>& values, unsigned long bitRate, float tolerance){
+    const auto mask = (1ull << bitRate) - 1ull;
+
+    cOut.records.resize(values.size());
+    cOut.track.bitRate = (unsigned char)bitRate;
+
+    bool bFit = true;
+    if constexpr(N == 4){
+        const auto fStep = (ins_smallestThreeRange * 2.f) / (float)mask;
+
+        cOut.recordBits = 2 + bitRate * 3;
+        for(size_t idxKey = 0u; idxKey < values.size(); ++idxKey){
+            const auto& kValue = values[idxKey];
+            const float* pValue = &kValue.x;
+
+            unsigned long idxLargest = 0;
+            for(unsigned long idx = 1; idx < 4; ++idx){
+                if(std::fabs(pValue[idx]) > std::fabs(pValue[idxLargest]))
+                    idxLargest = idx;
+            }
+            // dropped component is rebuilt as positive
+            const float fSign = (pValue[idxLargest] < 0.f) ? -1.f : 1.f;
+
+            unsigned long long record = idxLargest;
+            float decoded[4];
+            float fSum = 0.f;
+            for(unsigned long idx = 0, shift = 2; idx < 4; ++idx){
+                if(idx == idxLargest)
+                    continue;
+
+                const auto fQuantized = std::clamp(std::round((pValue[idx] * fSign + ins_smallestThreeRange) / fStep), 0.f, (float)mask);
+                record |= (unsigned long long)fQuantized << shift;
+                shift += bitRate;
+
+                decoded[idx] = fQuantized * fStep - ins_smallestThreeRange;
+                fSum += decoded[idx] * decoded[idx];
+            }
+            decoded[idxLargest] = std::sqrt(std::max(0.f, 1.f - fSum));
+
+            cOut.records[idxKey] = record;
+
+            if(bFit && (ComputeKeyError<TYPE>(DirectX::XMLoadFloat4(&kValue), ins_loadValue<4>(decoded)) > tolerance))
+                bFit = false;
+        }
+    }
+    else{
+        auto* pStep = &cOut.track.range[3];
+        for(unsigned long idx = 0; idx < 3; ++idx)
+            pStep[idx] = cOut.extent[idx] / (float)mask;
+
+        cOut.recordBits = bitRate * 3;
+        for(size_t idxKey = 0u; idxKey < values.size(); ++idxKey){
+            const auto& kValue = values[idxKey];
+            const float* pValue = &kValue.x;
+
+            unsigned long long record = 0;
+            float decoded[3];
+            for(unsigned long idx = 0, shift = 0; idx < 3; ++idx, shift += bitRate){
+                float fQuantized = 0.f;
+                if(pStep[idx] > 0.f)
+                    fQuantized = std::clamp(std::round((pValue[idx] - cOut.track.range[idx]) / pStep[idx]), 0.f, (float)mask);
+                record |= (unsigned long long)fQuantized << shift;
+
+                decoded[idx] = cOut.track.range[idx] + fQuantized * pStep[idx];
+            }
+
+            cOut.records[idxKey] = record;
+
+            if(bFit && (ComputeKeyError<TYPE>(DirectX::XMLoadFloat4(&kValue), ins_loadValue<3>(decoded)) > tolerance))
+                bFit = false;
+        }
+    }
+
+    return bFit;
+}
+
+// half of the tolerance goes to linearization, and the other half to quantization.
+// a track without keys is taken as the bind value
+template<KeyErrorType TYPE, unsigned long N>
+static void ins_linearizeKeys(
+    fbx_vector<_LinearKey>& linearKeys,
+    const FBXDynamicArray<FBXAnimationKeyFrame<FBXStaticArray<float, N>>>& keys,
+    const FBXDynamicArray<FBXAnimationKeyTangent<FBXStaticArray<float, N>>>& tangents,
+    bool bWorld,
+    DirectX::FXMVECTOR xmm_bind,
+    float tolerance,
+    float tickRate
+){
+    const auto tickDuration = (tickRate > 0.f) ? (1.f / tickRate) : FLT_MAX;
+
+    if(keys.Length)
+        ins_linearizeTrack<TYPE, N>(linearKeys, keys, tangents, bWorld, tickDuration, tolerance * 0.5f);
+    else{
+        _LinearKey newKey;
+        DirectX::XMStoreFloat4(&newKey.value, xmm_bind);
+        newKey.time = 0.f;
+        newKey.type = _LinearKeyType::_LinearKeyType_Regular;
+        linearKeys.emplace_back(std::move(newKey));
+    }
+}
+
+template<KeyErrorType TYPE, unsigned long N>
+static void ins_encodeTrack(_EncodedTrack& cOut, const fbx_vector<_LinearKey>& linearKeys, DirectX::FXMVECTOR xmm_identity, float tolerance, float tickRate){
+    fbx_vector<DirectX::XMFLOAT4> values;
+    values.reserve(linearKeys.size());
+    cOut.ticks.reserve(linearKeys.size());
+    for(const auto& iKey : linearKeys){
+        const auto fTick = iKey.time * tickRate;
+
+        auto tick = (unsigned short)std::clamp((iKey.type == _LinearKeyType::_LinearKeyType_Regular) ? std::round(fTick) : std::floor(fTick), 0.f, ins_maxTick);
+        if(iKey.type == _LinearKeyType::_LinearKeyType_Hold){
+            if(!tick)
+                continue;
+            --tick;
+        }
+
+        // later key of the same tick wins, as the step lands there
+        if((!cOut.ticks.empty()) && (cOut.ticks.back() >= tick)){
+            values.back() = iKey.value;
+            continue;
+        }
+
+        cOut.ticks.emplace_back(tick);
+        values.emplace_back(iKey.value);
+    }
+
+    auto& cTrack = cOut.track;
+    std::memset(&cTrack, 0, sizeof(cTrack));
+
+    if(std::all_of(values.cbegin(), values.cend(), [&xmm_identity, tolerance](const DirectX::XMFLOAT4& kValue){
+        return ComputeKeyError<TYPE>(DirectX::XMLoadFloat4(&kValue), xmm_identity) <= tolerance;
+    })){
+        cTrack.type = _CompressedTrackType::_CompressedTrackType_Identity;
+        cOut.ticks.clear();
+        return;
+    }
+
+    auto xmm_min = DirectX::XMLoadFloat4(&values[0]);
+    auto xmm_max = xmm_min;
+    auto xmm_sum = DirectX::XMVectorZero();
+    for(const auto& iValue : values){
+        const auto xmm_value = DirectX::XMLoadFloat4(&iValue);
+        xmm_min = DirectX::XMVectorMin(xmm_min, xmm_value);
+        xmm_max = DirectX::XMVectorMax(xmm_max, xmm_value);
+        xmm_sum = DirectX::XMVectorAdd(xmm_sum, ins_alignValue<N>(xmm_value, xmm_sum));
+    }
+
+    {
+        DirectX::XMVECTOR xmm_constant;
+        if constexpr(N == 4)
+            xmm_constant = DirectX::XMQuaternionNormalize(xmm_sum);
+        else
+            xmm_constant = DirectX::XMVectorScale(DirectX::XMVectorAdd(xmm_min, xmm_max), 0.5f);
+
+        if(std::all_of(values.cbegin(), values.cend(), [&xmm_constant, tolerance](const DirectX::XMFLOAT4& kValue){
+            return ComputeKeyError<TYPE>(DirectX::XMLoadFloat4(&kValue), xmm_constant) <= tolerance;
+        })){
+            cTrack.type = _CompressedTrackType::_CompressedTrackType_Constant;
+            DirectX::XMStoreFloat4((DirectX::XMFLOAT4*)cTrack.range, xmm_constant);
+            cOut.ticks.clear();
+            return;
+        }
+    }
+
+    cTrack.type = _CompressedTrackType::_CompressedTrackType_Animated;
+    cTrack.keyCount = (unsigned long)values.size();
+
+    unsigned long maxBitRate = ins_maxRotationBitRate;
+    if constexpr(N == 3){
+        maxBitRate = ins_maxVectorBitRate;
+        DirectX::XMStoreFloat3((DirectX::XMFLOAT3*)&cTrack.range[0], xmm_min);
+        DirectX::XMStoreFloat3((DirectX::XMFLOAT3*)cOut.extent, DirectX::XMVectorSubtract(xmm_max, xmm_min));
+    }
+
+    // keys move by up to half a tick, which moves the curve by as much as it changes over half a tick at its steepest.
+    // that comes out of the half of the tolerance given to quantization. steps are cut on their tick anyway
+    auto quantizeTolerance = tolerance * 0.5f;
+    if(tickRate > 0.f){
+        const auto halfTick = 0.5f / tickRate;
+
+        float tickError = 0.f;
+        for(size_t idxKey = 1u; idxKey < linearKeys.size(); ++idxKey){
+            const auto& kPrev = linearKeys[idxKey - 1];
+            const auto& kNext = linearKeys[idxKey];
+            if(kNext.type == _LinearKeyType::_LinearKeyType_Step)
+                continue;
+
+            const auto fDuration = kNext.time - kPrev.time;
+            if(!(fDuration > 0.f))
+                continue;
+
+            const auto xmm_prev = DirectX::XMLoadFloat4(&kPrev.value);
+            const auto xmm_moved = ins_interpolateValue<N>(xmm_prev, DirectX::XMLoadFloat4(&kNext.value), std::min(halfTick / fDuration, 1.f));
+            tickError = std::max(tickError, ComputeKeyError<TYPE>(xmm_prev, xmm_moved));
+        }
+
+        quantizeTolerance = std::max(quantizeTolerance - tickError, 0.f);
+    }
+
+    // variable bit rate. the smallest width that keeps every key in the tolerance is taken
+    for(unsigned long bitRate = 1; bitRate <= maxBitRate; ++bitRate){
+        if(ins_quantizeKeys<TYPE, N>(cOut, values, bitRate, quantizeTolerance) || (bitRate == maxBitRate))
+            break;
+    }
+}
+
+template<KeyErrorType TYPE, unsigned long N>
+static void ins_compressTrack(
+    _EncodedTrack& cOut,
+    const FBXDynamicArray<FBXAnimationKeyFrame<FBXStaticArray<float, N>>>& keys,
+    const FBXDynamicArray<FBXAnimationKeyTangent<FBXStaticArray<float, N>>>& tangents,
+    bool bWorld,
+    DirectX::FXMVECTOR xmm_bind,
+    DirectX::FXMVECTOR xmm_identity,
+    float tolerance,
+    float tickRate
+){
+    fbx_vector<_LinearKey> linearKeys;
+    ins_linearizeKeys<TYPE, N>(linearKeys, keys, tangents, bWorld, xmm_bind, tolerance, tickRate);
+    ins_encodeTrack<TYPE, N>(cOut, linearKeys, xmm_identity, tolerance, tickRate);
+}
+
+
+// value of linear keys on the time as decompression reads it. on a step, the value after the step is taken
+template<unsigned long N>
+static inline DirectX::XMVECTOR ins_sampleLinearKeys(const fbx_vector<_LinearKey>& linearKeys, float time){
+    const auto itrNext = std::upper_bound(linearKeys.cbegin(), linearKeys.cend(), time, [](float t, const _LinearKey& k){ return t < k.time; });
+    if(itrNext == linearKeys.cbegin())
+        return DirectX::XMLoadFloat4(&linearKeys.front().value);
+    if(itrNext == linearKeys.cend())
+        return DirectX::XMLoadFloat4(&linearKeys.back().value);
+
+    const auto& kPrev = *(itrNext - 1);
+    const auto fWeight = (time - kPrev.time) / (itrNext->time - kPrev.time);
+    return ins_interpolateValue<N>(DirectX::XMLoadFloat4(&kPrev.value), DirectX::XMLoadFloat4(&itrNext->value), fWeight);
+}
+
+// linear keys over [startTime, endTime] moved to start from 0. both ends get a key of the value there, so the block needs nothing around it.
+// boundary values are what lerp of the linear keys makes, so cutting adds no error.
+// a hold on endTime is kept, so a step on the boundary stays a step and the end of the block reads as the next block does
+template<unsigned long N>
+static void ins_windowLinearKeys(fbx_vector<_LinearKey>& windowKeys, const fbx_vector<_LinearKey>& linearKeys, float startTime, float endTime){
+    windowKeys.clear();
+
+    {
+        _LinearKey newKey;
+        DirectX::XMStoreFloat4(&newKey.value, ins_sampleLinearKeys<N>(linearKeys, startTime));
+        newKey.time = 0.f;
+        newKey.type = _LinearKeyType::_LinearKeyType_Regular;
+        windowKeys.emplace_back(std::move(newKey));
+    }
+
+    for(const auto& iKey : linearKeys){
+        if(iKey.time <= startTime)
+            continue;
+        if((iKey.time > endTime) || ((iKey.time == endTime) && (iKey.type != _LinearKeyType::_LinearKeyType_Hold)))
+            break;
+
+        auto newKey = iKey;
+        newKey.time -= startTime;
+        windowKeys.emplace_back(std::move(newKey));
+    }
+
+    if(endTime > startTime){
+        _LinearKey newKey;
+        DirectX::XMStoreFloat4(&newKey.value, ins_sampleLinearKeys<N>(linearKeys, endTime));
+        newKey.time = endTime - startTime;
+        newKey.type = _LinearKeyType::_LinearKeyType_Regular;
+        windowKeys.emplace_back(std::move(newKey));
+    }
+}
+
+
+// lays the tracks out as Data of FBXCompressedAnimation, and appends them to data
+static void ins_layoutTracks(fbx_vector<unsigned char>& data, _CompressedHeader header, fbx_vector<_EncodedTrack>& encodedTracks){
+    const auto nodeCount = (unsigned long)(encodedTracks.size() / 3);
+
+    // tracks of a node mostly share key times, so same ticks are written once per node
+    fbx_vector<unsigned short> ticks;
+    unsigned long long bitCount = 0;
+    for(unsigned long idxNode = 0; idxNode < nodeCount; ++idxNode){
+        auto* pEncoded = &encodedTracks[idxNode * 3];
+        for(unsigned long idxTrack = 0; idxTrack < 3; ++idxTrack){
+            auto& cEncoded = pEncoded[idxTrack];
+            if(cEncoded.track.type != _CompressedTrackType::_CompressedTrackType_Animated)
+                continue;
+
+            bool bShared = false;
+            for(unsigned long idxShared = 0; idxShared < idxTrack; ++idxShared){
+                const auto& kShared = pEncoded[idxShared];
+                if((kShared.track.type == _CompressedTrackType::_CompressedTrackType_Animated) && (kShared.ticks == cEncoded.ticks)){
+                    cEncoded.track.firstTick = kShared.track.firstTick;
+                    bShared = true;
+                    break;
+                }
+            }
+            if(!bShared){
+                cEncoded.track.firstTick = (unsigned long)ticks.size();
+                ticks.insert(ticks.end(), cEncoded.ticks.cbegin(), cEncoded.ticks.cend());
+            }
+
+            cEncoded.track.firstBit = (unsigned long)bitCount;
+            bitCount += (unsigned long long)cEncoded.recordBits * cEncoded.records.size();
+        }
+    }
+
+    header.tickOffset = (unsigned long)(sizeof(_CompressedHeader) + sizeof(_CompressedTrack) * encodedTracks.size());
+    header.bitOffset = (unsigned long)(header.tickOffset + sizeof(unsigned short) * ticks.size());
+
+    const auto offset = data.size();
+    data.resize(offset + header.bitOffset + ((bitCount + 7u) >> 3) + ins_bitPadding);
+
+    auto* pData = data.data() + offset;
+    std::memcpy(pData, &header, sizeof(header));
+    {
+        auto* pTrack = reinterpret_cast<_CompressedTrack*>(pData + sizeof(_CompressedHeader));
+        for(const auto& iEncoded : encodedTracks)
+            std::memcpy(pTrack++, &iEncoded.track, sizeof(_CompressedTrack));
+    }
+    if(!ticks.empty())
+        std::memcpy(pData + header.tickOffset, ticks.data(), sizeof(unsigned short) * ticks.size());
+
+    auto* pBits = pData + header.bitOffset;
+    for(const auto& iEncoded : encodedTracks){
+        auto position = (unsigned long long)iEncoded.track.firstBit;
+        for(const auto& iRecord : iEncoded.records){
+            ins_writeBits(pBits, position, iRecord, iEncoded.recordBits);
+            position += iEncoded.recordBits;
+        }
+    }
+}
+
+
+template<unsigned long N>
+static inline DirectX::XMVECTOR ins_decodeKey(const _CompressedTrack& track, const _CompressedView& view, unsigned long idxKey){
+    const unsigned long bitRate = track.bitRate;
+    const auto mask = (1ull << bitRate) - 1ull;
+
+    if constexpr(N == 4){
+        const auto record = ins_readBits(view.bits, track.firstBit + (unsigned long long)idxKey * (2 + bitRate * 3));
+
+        const auto xmm_quantized = DirectX::XMVectorSet(
+            (float)((record >> 2) & mask),
+            (float)((record >> (2 + bitRate)) & mask),
+            (float)((record >> (2 + (bitRate << 1))) & mask),
+            0.f
+        );
+
+        auto xmm_value = DirectX::XMVectorMultiplyAdd(
+            xmm_quantized,
+            DirectX::XMVectorReplicate((ins_smallestThreeRange * 2.f) / (float)mask),
+            DirectX::XMVectorReplicate(-ins_smallestThreeRange)
+        );
+        xmm_value = DirectX::XMVectorSelect(DirectX::g_XMZero, xmm_value, DirectX::g_XMSelect1110);
+
+        const auto xmm_largest = DirectX::XMVectorSqrt(DirectX::XMVectorMax(DirectX::g_XMZero, DirectX::XMVectorSubtract(DirectX::g_XMOne, DirectX::XMVector3Dot(xmm_value, xmm_value))));
+        xmm_value = DirectX::XMVectorSelect(xmm_largest, xmm_value, DirectX::g_XMSelect1110);
+
+        // smallest three are stored in order, with the dropped component left out
+        switch(record & 3u){
+        case 0:
+            return DirectX::XMVectorSwizzle<3, 0, 1, 2>(xmm_value);
+        case 1:
+            return DirectX::XMVectorSwizzle<0, 3, 1, 2>(xmm_value);
+        case 2:
+            return DirectX::XMVectorSwizzle<0, 1, 3, 2>(xmm_value);
+        default:
+            return xmm_value;
+        }
+    }
+    else{
+        const auto record = ins_readBits(view.bits, track.firstBit + (unsigned long long)idxKey * (bitRate * 3));
+
+        const auto xmm_quantized = DirectX::XMVectorSet(
+            (float)(record & mask),
+            (float)((record >> bitRate) & mask),
+            (float)((record >> (bitRate << 1)) & mask),
+            0.f
+        );
+        return DirectX::XMVectorMultiplyAdd(
+            xmm_quantized,
+            DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)&track.range[3]),
+            DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)&track.range[0])
+        );
+    }
+}
+
+// sequential sampling stays on the key or steps to the next one, and the rest is a binary search
+static inline unsigned long ins_findTick(const unsigned short* ticks, unsigned long count, float tick, unsigned long hint){
+    if((hint < count) && (ticks[hint] <= tick)){
+        if(((hint + 1) >= count) || (tick < ticks[hint + 1]))
+            return hint;
+        if(((hint + 2) >= count) || (tick < ticks[hint + 2]))
+            return hint + 1;
+    }
+
+    const auto* pFound = std::upper_bound(ticks, ticks + count, tick);
+    return (pFound == ticks) ? 0 : (unsigned long)(pFound - ticks - 1);
+}
+
+template<unsigned long N>
+static inline DirectX::XMVECTOR ins_decompressTrack(const _CompressedTrack& track, const _CompressedView& view, DirectX::FXMVECTOR xmm_identity, float tick, unsigned long& cursor){
+    switch(track.type){
+    case _CompressedTrackType::_CompressedTrackType_Identity:
+        return xmm_identity;
+
+    case _CompressedTrackType::_CompressedTrackType_Constant:
+        return ins_loadValue<N>(track.range);
+
+    default:
+    {
+        const auto* pTicks = view.ticks + track.firstTick;
+
+        cursor = ins_findTick(pTicks, track.keyCount, tick, cursor);
+
+        const auto xmm_from = ins_decodeKey<N>(track, view, cursor);
+        if((cursor + 1) >= track.keyCount)
+            return xmm_from;
+
+        const auto fWeight = std::clamp((tick - (float)pTicks[cursor]) / (float)(pTicks[cursor + 1] - pTicks[cursor]), 0.f, 1.f);
+        return ins_interpolateValue<N>(xmm_from, ins_decodeKey<N>(track, view, cursor + 1), fWeight);
+    }
+    }
+}
+
+template<unsigned long N>
+static inline void ins_storePose(float* const (&planes)[N], unsigned long idxNode, DirectX::FXMVECTOR xmm_value){
+    DirectX::XMFLOAT4A value;
+    DirectX::XMStoreFloat4A(&value, xmm_value);
+
+    const float* pValue = &value.x;
+    for(unsigned long idx = 0; idx < N; ++idx)
+        planes[idx][idxNode] = pValue[idx];
+}
+
+
+void SHRCompressAnimation(const FBXAnimation* pAnimation, float scalingTolerance, float rotationTolerance, float translationTolerance, bool bWorld, FBXCompressedAnimation* pOutCompressed){
+    const auto nodeCount = (unsigned long)pAnimation->AnimationNodes.Length;
+
+    pOutCompressed->NodeCount = nodeCount;
+    pOutCompressed->EndTime = pAnimation->EndTime;
+    pOutCompressed->World = bWorld;
+    pOutCompressed->Name = pAnimation->Name;
+
+    _CompressedHeader header;
+    header.tickRate = (pAnimation->EndTime > 0.f) ? (ins_maxTick / pAnimation->EndTime) : 0.f;
+
+    fbx_vector<AnimationTolerance> tolerances(nodeCount);
+    SHRComputeAnimationTolerances(pAnimation, scalingTolerance, rotationTolerance, translationTolerance, tolerances.data());
+
+    fbx_vector<_EncodedTrack> encodedTracks(nodeCount * 3);
+    std::for_each(std::execution::par, pAnimation->AnimationNodes.Values, pAnimation->AnimationNodes.Values + nodeCount, [&](const FBXAnimationNode& iNode){
+        const auto idxNode = FBX_PTRDIFFU(&iNode - pAnimation->AnimationNodes.Values);
+        const auto& kTolerance = tolerances[idxNode];
+        auto* pEncoded = &encodedTracks[idxNode * 3];
+
+        DirectX::XMVECTOR xmm_bindScaling, xmm_bindRotation, xmm_bindTranslation;
+        ins_loadBindTransform(xmm_bindScaling, xmm_bindRotation, xmm_bindTranslation, iNode.BindNode, bWorld);
+
+        ins_compressTrack<KeyErrorType::KeyErrorType_Scaling>(
+            pEncoded[0],
+            iNode.ScalingKeys,
+            iNode.ScalingTangents,
+            bWorld,
+            xmm_bindScaling,
+            DirectX::g_XMOne,
+            kTolerance.scaling,
+            header.tickRate
+        );
+        ins_compressTrack<KeyErrorType::KeyErrorType_Rotation>(
+            pEncoded[1],
+            iNode.RotationKeys,
+            iNode.RotationTangents,
+            bWorld,
+            xmm_bindRotation,
+            DirectX::XMQuaternionIdentity(),
+            kTolerance.rotation,
+            header.tickRate
+        );
+        ins_compressTrack<KeyErrorType::KeyErrorType_Translation>(
+            pEncoded[2],
+            iNode.TranslationKeys,
+            iNode.TranslationTangents,
+            bWorld,
+            xmm_bindTranslation,
+            DirectX::XMVectorZero(),
+            bWorld ? kTolerance.worldTranslation : kTolerance.localTranslation,
+            header.tickRate
+        );
+    });
+
+    fbx_vector<unsigned char> data;
+    ins_layoutTracks(data, header, encodedTracks);
+
+    pOutCompressed->Data.Assign(data.size());
+    std::memcpy(pOutCompressed->Data.Values, data.data(), data.size());
+}
+
+// time must be in the range of the data already
+static void ins_decompressPose(const unsigned char* pData, unsigned long nodeCount, float time, FBXAnimationCursor* pCursors, const FBXAnimationPose& pose){
+    const auto& kHeader = *reinterpret_cast<const _CompressedHeader*>(pData);
+    const auto* pTrack = reinterpret_cast<const _CompressedTrack*>(pData + sizeof(_CompressedHeader));
+
+    _CompressedView view;
+    view.ticks = reinterpret_cast<const unsigned short*>(pData + kHeader.tickOffset);
+    view.bits = pData + kHeader.bitOffset;
+
+    const auto fTick = time * kHeader.tickRate;
+
+    for(unsigned long idxNode = 0; idxNode < nodeCount; ++idxNode, pTrack += 3){
+        FBXAnimationCursor tmpCursor;
+        auto& iCursor = pCursors ? pCursors[idxNode] : tmpCursor;
+
+        ins_storePose(pose.Scaling, idxNode, ins_decompressTrack<3>(pTrack[0], view, DirectX::g_XMOne, fTick, iCursor.ScalingKey));
+        ins_storePose(pose.Rotation, idxNode, ins_decompressTrack<4>(pTrack[1], view, DirectX::XMQuaternionIdentity(), fTick, iCursor.RotationKey));
+        ins_storePose(pose.Translation, idxNode, ins_decompressTrack<3>(pTrack[2], view, DirectX::XMVectorZero(), fTick, iCursor.TranslationKey));
+    }
+}
+
+void SHRDecompressAnimationPose(const FBXCompressedAnimation* pCompressed, float time, FBXAnimationCursor* pCursors, const FBXAnimationPose& pose){
+    ins_decompressPose(pCompressed->Data.Values, pCompressed->NodeCount, std::clamp(time, 0.f, pCompressed->EndTime), pCursors, pose);
+}
+
+
+void SHRCompressStreamingAnimation(const FBXAnimation* pAnimation, float blockDuration, float scalingTolerance, float rotationTolerance, float translationTolerance, bool bWorld, FBXStreamingAnimation* pOutStreaming){
+    const auto nodeCount = (unsigned long)pAnimation->AnimationNodes.Length;
+    const auto endTime = std::max(pAnimation->EndTime, 0.f);
+
+    pOutStreaming->NodeCount = nodeCount;
+    pOutStreaming->EndTime = pAnimation->EndTime;
+    pOutStreaming->BlockDuration = blockDuration;
+    pOutStreaming->World = bWorld;
+    pOutStreaming->Name = pAnimation->Name;
+
+    // float error of a whole block count must not add an empty block. the last block takes the rest
+    const auto blockCount = (unsigned long)std::max(std::ceil(endTime / blockDuration - 0.001f), 1.f);
+
+    fbx_vector<AnimationTolerance> tolerances(nodeCount);
+    SHRComputeAnimationTolerances(pAnimation, scalingTolerance, rotationTolerance, translationTolerance, tolerances.data());
+
+    // tracks are linearized once over the whole clip on the tick of a full block, and only cut for each block
+    fbx_vector<fbx_vector<_LinearKey>> linearKeys(nodeCount * 3);
+    std::for_each(std::execution::par, pAnimation->AnimationNodes.Values, pAnimation->AnimationNodes.Values + nodeCount, [&](const FBXAnimationNode& iNode){
+        const auto idxNode = FBX_PTRDIFFU(&iNode - pAnimation->AnimationNodes.Values);
+        const auto& kTolerance = tolerances[idxNode];
+        auto* pLinearKeys = &linearKeys[idxNode * 3];
+
+        const auto tickRate = ins_maxTick / blockDuration;
+
+        DirectX::XMVECTOR xmm_bindScaling, xmm_bindRotation, xmm_bindTranslation;
+        ins_loadBindTransform(xmm_bindScaling, xmm_bindRotation, xmm_bindTranslation, iNode.BindNode, bWorld);
+
+        ins_linearizeKeys<KeyErrorType::KeyErrorType_Scaling>(pLinearKeys[0], iNode.ScalingKeys, iNode.ScalingTangents, bWorld, xmm_bindScaling, kTolerance.scaling, tickRate);
+        ins_linearizeKeys<KeyErrorType::KeyErrorType_Rotation>(pLinearKeys[1], iNode.RotationKeys, iNode.RotationTangents, bWorld, xmm_bindRotation, kTolerance.rotation, tickRate);
+        ins_linearizeKeys<KeyErrorType::KeyErrorType_Translation>(pLinearKeys[2], iNode.TranslationKeys, iNode.TranslationTangents, bWorld, xmm_bindTranslation, bWorld ? kTolerance.worldTranslation : kTolerance.localTranslation, tickRate);
+    });
+
+    fbx_vector<fbx_vector<unsigned char>> blocks(blockCount);
+    std::for_each(std::execution::par, blocks.begin(), blocks.end(), [&](fbx_vector<unsigned char>& cBlock){
+        const auto idxBlock = (unsigned long)(&cBlock - blocks.data());
+
+        _StreamingBlockHeader blockHeader;
+        blockHeader.startTime = (float)idxBlock * blockDuration;
+        blockHeader.duration = std::max((((idxBlock + 1) < blockCount) ? (blockHeader.startTime + blockDuration) : endTime) - blockHeader.startTime, 0.f);
+        blockHeader.nodeCount = nodeCount;
+
+        _CompressedHeader header;
+        header.tickRate = (blockHeader.duration > 0.f) ? (ins_maxTick / blockHeader.duration) : 0.f;
+
+        const auto blockEnd = blockHeader.startTime + blockHeader.duration;
+
+        fbx_vector<_EncodedTrack> encodedTracks(nodeCount * 3);
+        fbx_vector<_LinearKey> windowKeys;
+        for(unsigned long idxNode = 0; idxNode < nodeCount; ++idxNode){
+            const auto& kTolerance = tolerances[idxNode];
+            const auto* pLinearKeys = &linearKeys[idxNode * 3];
+            auto* pEncoded = &encodedTracks[idxNode * 3];
+
+            ins_windowLinearKeys<3>(windowKeys, pLinearKeys[0], blockHeader.startTime, blockEnd);
+            ins_encodeTrack<KeyErrorType::KeyErrorType_Scaling, 3>(pEncoded[0], windowKeys, DirectX::g_XMOne, kTolerance.scaling, header.tickRate);
+
+            ins_windowLinearKeys<4>(windowKeys, pLinearKeys[1], blockHeader.startTime, blockEnd);
+            ins_encodeTrack<KeyErrorType::KeyErrorType_Rotation, 4>(pEncoded[1], windowKeys, DirectX::XMQuaternionIdentity(), kTolerance.rotation, header.tickRate);
+
+            ins_windowLinearKeys<3>(windowKeys, pLinearKeys[2], blockHeader.startTime, blockEnd);
+            ins_encodeTrack<KeyErrorType::KeyErrorType_Translation, 3>(pEncoded[2], windowKeys, DirectX::XMVectorZero(), bWorld ? kTolerance.worldTranslation : kTolerance.localTranslation, header.tickRate);
+        }
+
+        cBlock.resize(sizeof(_StreamingBlockHeader));
+        ins_layoutTracks(cBlock, header, encodedTracks);
+        cBlock.resize((cBlock.size() + ins_blockAlignment - 1u) & ~(ins_blockAlignment - 1u));
+
+        blockHeader.size = (unsigned long)cBlock.size();
+        std::memcpy(cBlock.data(), &blockHeader, sizeof(blockHeader));
+    });
+
+    pOutStreaming->BlockOffsets.Assign(blockCount + 1);
+    pOutStreaming->BlockOffsets.Values[0] = 0;
+    for(unsigned long idxBlock = 0; idxBlock < blockCount; ++idxBlock)
+        pOutStreaming->BlockOffsets.Values[idxBlock + 1] = pOutStreaming->BlockOffsets.Values[idxBlock] + blocks[idxBlock].size();
+
+    pOutStreaming->Data.Assign((size_t)pOutStreaming->BlockOffsets.Values[blockCount]);
+    for(unsigned long idxBlock = 0; idxBlock < blockCount; ++idxBlock)
+        std::memcpy(pOutStreaming->Data.Values + pOutStreaming->BlockOffsets.Values[idxBlock], blocks[idxBlock].data(), blocks[idxBlock].size());
+}
+
+void SHRDecompressAnimationBlockPose(const void* pBlock, float time, FBXAnimationCursor* pCursors, const FBXAnimationPose& pose){
+    const auto* pData = reinterpret_cast<const unsigned char*>(pBlock);
+    const auto& kHeader = *reinterpret_cast<const _StreamingBlockHeader*>(pData);
+
+    ins_decompressPose(pData + sizeof(_StreamingBlockHeader), kHeader.nodeCount, std::clamp(time - kHeader.startTime, 0.f, kHeader.duration), pCursors, pose);
+}
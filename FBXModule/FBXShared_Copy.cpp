@@ -32,6 +32,9 @@ void SHRRebindRoot(FBXRoot* dest, const FBXRoot* src){
 
     for(size_t idxAnimation = 0; idxAnimation < dest->Animations.Length; ++idxAnimation)
         SHRRebindAnimation(dest->Animations.Values[idxAnimation], src->Animations.Values[idxAnimation]);
+
+    for(size_t idxInstance = 0; idxInstance < dest->MeshInstances.Length; ++idxInstance)
+        SHRRebindMeshInstance(dest->MeshInstances.Values[idxInstance], src->MeshInstances.Values[idxInstance]);
 }
 void SHRRebindNode(FBXNode* dest, const FBXNode* src){
     static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("SHRRebindNode(FBXNode*, const FBXNode*)");
@@ -44,6 +47,19 @@ void SHRRebindNode(FBXNode* dest, const FBXNode* src){
             return;
         }
 
+        if(FBXTypeHasMember(srcID, FBXType::FBXType_Mesh)){
+            auto* dest_c = static_cast<FBXMesh*>(dest);
+
+            if(dest_c->InstanceSource){
+                auto f = ins_nodeBinder.find(dest_c->InstanceSource);
+
+                if(f != ins_nodeBinder.cend())
+                    dest_c->InstanceSource = static_cast<FBXMesh*>(f->second);
+                else
+                    SHRPushErrorMessage(FBX_TEXT("an error occurred while binding node pointer on InstanceSource"), __name_of_this_func);
+            }
+        }
+
         if(FBXTypeHasMember(srcID, FBXType::FBXType_SkinnedMesh)){
             auto* dest_c = static_cast<FBXSkinnedMesh*>(dest);
 
@@ -57,6 +73,18 @@ void SHRRebindNode(FBXNode* dest, const FBXNode* src){
                         SHRPushErrorMessage(FBX_TEXT("an error occurred while binding node pointer on BoneCombinations"), __name_of_this_func);
                 }
             }
+            for(auto* p0 = dest_c->BoneBudgets.Values; FBX_PTRDIFFU(p0 - dest_c->BoneBudgets.Values) < dest_c->BoneBudgets.Length; ++p0){
+                for(auto* p1 = p0->BoneCombinations.Values; FBX_PTRDIFFU(p1 - p0->BoneCombinations.Values) < p0->BoneCombinations.Length; ++p1){
+                    for(auto* p2 = p1->Values; FBX_PTRDIFFU(p2 - p1->Values) < p1->Length; ++p2){
+                        auto f = ins_nodeBinder.find(*p2);
+
+                        if(f != ins_nodeBinder.cend())
+                            *p2 = f->second;
+                        else
+                            SHRPushErrorMessage(FBX_TEXT("an error occurred while binding node pointer on BoneBudgets"), __name_of_this_func);
+                    }
+                }
+            }
             for(auto* p0 = dest_c->SkinInfos.Values; FBX_PTRDIFFU(p0 - dest_c->SkinInfos.Values) < dest_c->SkinInfos.Length; ++p0){
                 for(auto* p1 = p0->Values; FBX_PTRDIFFU(p1 - p0->Values) < p0->Length; ++p1){
                     auto f = ins_nodeBinder.find(p1->BindNode);
@@ -98,3 +126,25 @@ void SHRRebindAnimation(FBXAnimation& dest, const FBXAnimation& src){
             SHRPushErrorMessage(FBX_TEXT("an error occurred while binding node pointer on Animation"), __name_of_this_func);
     }
 }
+void SHRRebindMeshInstance(FBXMeshInstance& dest, const FBXMeshInstance& src){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("SHRRebindMeshInstance(FBXMeshInstance&, const FBXMeshInstance&)");
+
+
+    {
+        auto f = ins_nodeBinder.find(dest.Geometry);
+
+        if(f != ins_nodeBinder.cend())
+            dest.Geometry = static_cast<FBXMesh*>(f->second);
+        else
+            SHRPushErrorMessage(FBX_TEXT("an error occurred while binding node pointer on MeshInstance"), __name_of_this_func);
+    }
+
+    for(auto** p = dest.Nodes.Values; FBX_PTRDIFFU(p - dest.Nodes.Values) < dest.Nodes.Length; ++p){
+        auto f = ins_nodeBinder.find(*p);
+
+        if(f != ins_nodeBinder.cend())
+            *p = static_cast<FBXMesh*>(f->second);
+        else
+            SHRPushErrorMessage(FBX_TEXT("an error occurred while binding node pointer on MeshInstance"), __name_of_this_func);
+    }
+}
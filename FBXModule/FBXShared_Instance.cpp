@@ -0,0 +1,176 @@
+﻿/**
+ * @file FBXShared_Instance.cpp
+ * @date 2026/10/19
+ * @author Lim Taewoo (limztudio@gmail.com)
+ */
+
+
+#include "stdafx.h"
+
+#include <FBXAssign.hpp>
+
+#include "FBXUtilites.h"
+#include "FBXMath.h"
+#include "FBXShared.h"
+
+
+template<typename T>
+static inline unsigned long long ins_hashArray(unsigned long long seed, const FBXDynamicArray<T>& table){
+    seed = CombineHash64(seed, (unsigned long long)table.Length);
+    if(table.Length)
+        seed = CombineHash64(seed, (unsigned long long)robin_hood::hash_bytes(table.Values, sizeof(T) * table.Length));
+    return seed;
+}
+template<typename T>
+static inline bool ins_isSameArray(const FBXDynamicArray<T>& lhs, const FBXDynamicArray<T>& rhs){
+    if(lhs.Length != rhs.Length)
+        return false;
+    if(!lhs.Length)
+        return true;
+    return (memcmp(lhs.Values, rhs.Values, sizeof(T) * lhs.Length) == 0);
+}
+
+static inline size_t ins_makeMeshHash(const FBXMesh* pMesh){
+    auto result = (unsigned long long)pMesh->LayeredElements.Length;
+
+    result = ins_hashArray(result, pMesh->Materials);
+    result = ins_hashArray(result, pMesh->Attributes);
+    result = ins_hashArray(result, pMesh->Indices);
+    result = ins_hashArray(result, pMesh->Vertices);
+
+    for(const auto* pLayer = pMesh->LayeredElements.Values; FBX_PTRDIFFU(pLayer - pMesh->LayeredElements.Values) < pMesh->LayeredElements.Length; ++pLayer){
+        result = ins_hashArray(result, pLayer->Material);
+        result = ins_hashArray(result, pLayer->Color);
+        result = ins_hashArray(result, pLayer->Normal);
+        result = ins_hashArray(result, pLayer->Binormal);
+        result = ins_hashArray(result, pLayer->Tangent);
+        result = ins_hashArray(result, pLayer->Texcoord);
+    }
+
+    return (size_t)result;
+}
+// bitwise comparison. geometry is already optimized and converted, so the same source always yields the same bits
+static inline bool ins_isSameMesh(const FBXMesh* lhs, const FBXMesh* rhs){
+    if(!ins_isSameArray(lhs->Vertices, rhs->Vertices))
+        return false;
+    if(!ins_isSameArray(lhs->Indices, rhs->Indices))
+        return false;
+    if(!ins_isSameArray(lhs->Attributes, rhs->Attributes))
+        return false;
+    if(!ins_isSameArray(lhs->Materials, rhs->Materials))
+        return false;
+
+    if(lhs->LayeredElements.Length != rhs->LayeredElements.Length)
+        return false;
+    for(size_t idxLayer = 0u; idxLayer < lhs->LayeredElements.Length; ++idxLayer){
+        const auto& lhsLayer = lhs->LayeredElements.Values[idxLayer];
+        const auto& rhsLayer = rhs->LayeredElements.Values[idxLayer];
+
+        if(!ins_isSameArray(lhsLayer.Material, rhsLayer.Material))
+            return false;
+        if(!ins_isSameArray(lhsLayer.Color, rhsLayer.Color))
+            return false;
+        if(!ins_isSameArray(lhsLayer.Normal, rhsLayer.Normal))
+            return false;
+        if(!ins_isSameArray(lhsLayer.Binormal, rhsLayer.Binormal))
+            return false;
+        if(!ins_isSameArray(lhsLayer.Tangent, rhsLayer.Tangent))
+            return false;
+        if(!ins_isSameArray(lhsLayer.Texcoord, rhsLayer.Texcoord))
+            return false;
+    }
+
+    return true;
+}
+
+class _MeshKey{
+public:
+    _MeshKey(const FBXMesh* _mesh, size_t _hash)
+        :
+        hash(_hash),
+        mesh(_mesh)
+    {}
+
+
+public:
+    inline operator size_t()const{ return hash; }
+
+
+public:
+    const size_t hash;
+    const FBXMesh* mesh;
+};
+static inline bool operator==(const _MeshKey& lhs, const _MeshKey& rhs){
+    return ins_isSameMesh(lhs.mesh, rhs.mesh);
+}
+
+
+static fbx_unordered_map<_MeshKey, unsigned int, CustomHasher<_MeshKey>> ins_meshFinder;
+static fbx_vector<fbx_vector<FBXMesh*>> ins_meshGroups;
+
+
+void SHRGenerateMeshInstances(FBXNode* pRootNode, FBXDynamicArray<FBXMeshInstance>* pInstances){
+    ins_meshFinder.clear();
+    ins_meshGroups.clear();
+
+    // skinned meshes are bound to their own bones, so only static meshes are considered
+    FBXIterateNode(pRootNode, [](FBXNode* pNode){
+        if(pNode->getID() != FBXType::FBXType_Mesh)
+            return;
+
+        auto* pMesh = static_cast<FBXMesh*>(pNode);
+        if(pMesh->InstanceSource || (!pMesh->Vertices.Length))
+            return;
+
+        auto idxGroup = (unsigned int)ins_meshGroups.size();
+        auto res = ins_meshFinder.emplace(_MeshKey(pMesh, ins_makeMeshHash(pMesh)), idxGroup);
+        if(res.second)
+            ins_meshGroups.emplace_back();
+        else
+            idxGroup = res.first->second;
+
+        ins_meshGroups[idxGroup].emplace_back(pMesh);
+    });
+
+    size_t instanceCount = 0u;
+    for(const auto& iGroup : ins_meshGroups){
+        if(iGroup.size() > 1u)
+            ++instanceCount;
+    }
+
+    pInstances->Assign(instanceCount);
+
+    auto* pInstance = pInstances->Values;
+    for(const auto& iGroup : ins_meshGroups){
+        if(iGroup.size() < 2u)
+            continue;
+
+        auto* pGeometry = iGroup[0];
+
+        pInstance->Geometry = pGeometry;
+        pInstance->Nodes.Assign(iGroup.size());
+        pInstance->WorldMatrices.Assign(iGroup.size());
+
+        for(size_t idxNode = 0u; idxNode < iGroup.size(); ++idxNode){
+            auto* pMesh = iGroup[idxNode];
+
+            pInstance->Nodes.Values[idxNode] = pMesh;
+            FBXGetWorldMatrix(pInstance->WorldMatrices.Values[idxNode].Values, pMesh);
+
+            if(pMesh != pGeometry){
+                pMesh->InstanceSource = pGeometry;
+
+                pMesh->Materials.Clear();
+                pMesh->Attributes.Clear();
+                pMesh->Indices.Clear();
+                pMesh->Vertices.Clear();
+                pMesh->LayeredElements.Clear();
+            }
+        }
+
+        ++pInstance;
+    }
+
+    ins_meshFinder.clear();
+    ins_meshGroups.clear();
+}
@@ -115,7 +115,11 @@ static inline bool ins_addMeshNode(
 
         SHROptimizeMesh(pNodeData);
 
-        SHRGenerateMeshAttribute(pNodeData);
+        size_t greedyCount;
+        SHRGenerateMeshAttribute(pNodeData, &greedyCount);
+
+        shr_boneCombinationReport.GreedyCount += (unsigned long)greedyCount;
+        shr_boneCombinationReport.Count += (unsigned long)pNodeData->bufMeshAttribute.size();
     }
 
     {
@@ -128,105 +132,7 @@ static inline bool ins_addMeshNode(
     {
         auto* pMesh = static_cast<FBXMesh*>(pNode);
 
-        pMesh->Attributes.Assign(pNodeData->bufMeshAttribute.size());
-        for(size_t idxAttr = 0u; idxAttr < pMesh->Attributes.Length; ++idxAttr){
-            const auto& iOldAttr = pNodeData->bufMeshAttribute[idxAttr];
-            auto& iNewAttr = pMesh->Attributes.Values[idxAttr];
-
-            iNewAttr.VertexStart = iOldAttr.VertexFirst;
-            iNewAttr.IndexStart = iOldAttr.PolygonFirst;
-
-            iNewAttr.VertexCount = 1 + iOldAttr.VertexLast - iOldAttr.VertexFirst;
-            iNewAttr.IndexCount = 1 + iOldAttr.PolygonLast - iOldAttr.PolygonFirst;
-        }
-
-        pMesh->Indices.Assign(pNodeData->bufIndices.size());
-        for(size_t idxInd = 0u; idxInd < pMesh->Indices.Length; ++idxInd){
-            auto& iInd = pMesh->Indices.Values[idxInd];
-
-            CopyArrayData(iInd.Values, pNodeData->bufIndices[idxInd].raw);
-        }
-
-        pMesh->Vertices.Assign(pNodeData->bufPositions.size());
-        for(size_t idxVert = 0u; idxVert < pMesh->Vertices.Length; ++idxVert){
-            auto& iVert = pMesh->Vertices.Values[idxVert];
-
-            CopyArrayData(iVert.Values, pNodeData->bufPositions[idxVert].mData);
-        }
-
-        pMesh->LayeredElements.Assign(pNodeData->bufLayers.size());
-        for(size_t idxLayer = 0u; idxLayer < pMesh->LayeredElements.Length; ++idxLayer){
-            auto& iLayer = pMesh->LayeredElements.Values[idxLayer];
-            const auto& nodeLayer = pNodeData->bufLayers[idxLayer];
-
-            {
-                auto& iObject = iLayer.Material;
-                const auto& nodeObject = nodeLayer.materials;
-
-                if(nodeObject.empty())
-                    iObject.Assign(0u);
-                else{
-                    iObject.Assign(pNodeData->bufMeshAttribute.size());
-                    for(size_t idxMat = 0u; idxMat < iObject.Length; ++idxMat){
-                        const auto idxOldMat = pMesh->Attributes.Values[idxMat].IndexStart;
-                        iObject.Values[idxMat] = nodeObject[idxOldMat];
-                    }
-                }
-            }
-
-            {
-                auto& iObject = iLayer.Color;
-                const auto& nodeObject = nodeLayer.colors;
-
-                iObject.Assign(nodeObject.size());
-                for(size_t idxElem = 0u; idxElem < iObject.Length; ++idxElem)
-                    CopyArrayData(iObject.Values[idxElem].Values, nodeObject[idxElem].mData);
-            }
-
-            {
-                auto& iObject = iLayer.Normal;
-                const auto& nodeObject = nodeLayer.normals;
-
-                iObject.Assign(nodeObject.size());
-                for(size_t idxElem = 0u; idxElem < iObject.Length; ++idxElem)
-                    CopyArrayData(iObject.Values[idxElem].Values, nodeObject[idxElem].mData);
-            }
-
-            {
-                auto& iObject = iLayer.Binormal;
-                const auto& nodeObject = nodeLayer.binormals;
-
-                iObject.Assign(nodeObject.size());
-                for(size_t idxElem = 0u; idxElem < iObject.Length; ++idxElem)
-                    CopyArrayData(iObject.Values[idxElem].Values, nodeObject[idxElem].mData);
-            }
-
-            {
-                auto& iObject = iLayer.Tangent;
-                const auto& nodeObject = nodeLayer.tangents;
-
-                iObject.Assign(nodeObject.size());
-                for(size_t idxElem = 0u; idxElem < iObject.Length; ++idxElem)
-                    CopyArrayData(iObject.Values[idxElem].Values, nodeObject[idxElem].mData);
-            }
-
-            {
-                auto& iObject = iLayer.Texcoord;
-                const auto& nodeObject = nodeLayer.texcoords.table;
-
-                iObject.Assign(nodeObject.size());
-                for(size_t idxElem = 0u; idxElem < iObject.Length; ++idxElem)
-                    CopyArrayData(iObject.Values[idxElem].Values, nodeObject[idxElem].mData);
-            }
-        }
-
-        pMesh->Materials.Assign(pNodeData->bufMaterials.size());
-        for(size_t idxMaterial = 0u; idxMaterial < pMesh->Materials.Length; ++idxMaterial){
-            auto& iMaterial = pMesh->Materials.Values[idxMaterial];
-            const auto& nodeMaterial = pNodeData->bufMaterials[idxMaterial];
-
-            iMaterial = nodeMaterial;
-        }
+        SHRStoreOptimizedMesh(pNodeData, pMesh);
     }
 
     if(!pNodeData->bufSkinData.empty()){
@@ -282,6 +188,31 @@ static inline bool ins_addMeshNode(
         }
     }
 
+    if(shr_ioSetting.GenerateTangentSpace)
+        SHRGenerateTangentSpace(static_cast<FBXMesh*>(pNode));
+
+    if(!pNodeData->bufBoneBudgets.empty()){
+        auto* pMesh = static_cast<FBXSkinnedMesh*>(pNode);
+
+        SHRStoreBoneBudgets(pNodeData, pMesh);
+        for(size_t idxBudget = 0u; idxBudget < pMesh->BoneBudgets.Length; ++idxBudget){
+            auto& iBudget = pMesh->BoneBudgets.Values[idxBudget];
+            const auto& nodeBudget = pNodeData->bufBoneBudgets[idxBudget];
+
+            for(size_t idxAttr = 0u; idxAttr < iBudget.BoneCombinations.Length; ++idxAttr){
+                auto& iAttr = iBudget.BoneCombinations.Values[idxAttr];
+                const auto& nodeAttr = nodeBudget.bufBoneCombination[idxAttr];
+
+                for(size_t idxBC = 0u; idxBC < iAttr.Length; ++idxBC){
+                    auto*& iCluster = iAttr.Values[idxBC];
+                    auto* nodeCluster = nodeAttr[idxBC];
+
+                    iCluster = reinterpret_cast<decltype(iCluster)>(nodeCluster->GetLink());
+                }
+            }
+        }
+    }
+
     return true;
 }
 
@@ -416,6 +347,19 @@ static void ins_bindSkinningInfoRecursive(const FbxNodeToExportNode& fbxNodeToEx
                 (*iCluster) = f->second;
             }
         }
+        for(auto* iBudget = pMesh->BoneBudgets.Values; FBX_PTRDIFFU(iBudget - pMesh->BoneBudgets.Values) < pMesh->BoneBudgets.Length; ++iBudget){
+            for(auto* iAttr = iBudget->BoneCombinations.Values; FBX_PTRDIFFU(iAttr - iBudget->BoneCombinations.Values) < iBudget->BoneCombinations.Length; ++iAttr){
+                for(auto** iCluster = iAttr->Values; FBX_PTRDIFFU(iCluster - iAttr->Values) < iAttr->Length; ++iCluster){
+                    auto* kBindNode = reinterpret_cast<FbxNode*>(*iCluster);
+
+                    auto f = fbxNodeToExportNode.find(kBindNode);
+                    if(f == fbxNodeToExportNode.cend())
+                        throw _ERROR_INDSID_BIND_SKIN;
+
+                    (*iCluster) = f->second;
+                }
+            }
+        }
 
         for(auto* iVert = pMesh->SkinInfos.Values; FBX_PTRDIFFU(iVert - pMesh->SkinInfos.Values) < pMesh->SkinInfos.Length; ++iVert){
             for(auto* iWeight = iVert->Values; FBX_PTRDIFFU(iWeight - iVert->Values) < iVert->Length; ++iWeight){
@@ -714,7 +658,11 @@ bool SHRStoreNodes(FbxManager* kSDKManager, FbxScene* kScene, ImportNodeToFbxNod
         ins_controlPointMergeMap.clear();
 
         if(FBXTypeHasMember(curID, FBXType::FBXType_Mesh)){
-            if(!SHRInitMeshNode(kSDKManager, kScene, ins_controlPointMergeMap, static_cast<const FBXMesh*>(i.first), i.second))
+            const auto* pMesh = static_cast<const FBXMesh*>(i.first);
+            if(pMesh->InstanceSource)
+                pMesh = pMesh->InstanceSource;
+
+            if(!SHRInitMeshNode(kSDKManager, kScene, ins_controlPointMergeMap, pMesh, i.second))
                 return false;
         }
 
@@ -10,6 +10,7 @@
 #include <FBXAssign.hpp>
 
 #include "FBXUtilites.h"
+#include "FBXMath.h"
 #include "FBXShared.h"
 
 
@@ -20,400 +21,345 @@ static fbx_unordered_map<FbxCluster*, FbxDouble> ins_nodeDuplicateChecker;
 static fbx_unordered_set<const FbxCluster*, PointerHasher<const FbxCluster*>> ins_nodeUsageChecker;
 
 
-class _VertexInfo{
+// every vertex is stored as one fixed-stride record of scalars(double, or float with FBXIOSetting::WeldInSinglePrecision):
+// position | colors | normals | binormals | tangents | texcoords | (padding to a full xmm register)
+// uv names are the same for every vertex of a layer, so they don't take part in comparison
+class _VertexStreamLayout{
 public:
-    static inline size_t makeHash(const _VertexInfo& data){
-        size_t c, result = 2166136261U; //FNV1 hash
+    static constexpr size_t npos = size_t(-1);
 
-#define __CAL_RESULT result = (result * 16777619) ^ c;
 
-        {
-            c = MakeHash(data.position.mData);
-            __CAL_RESULT;
+public:
+    inline void init(const NodeData* pNodeData, size_t lanes){
+        const auto layerCount = pNodeData->bufLayers.size();
+
+        offsetColor.assign(layerCount, npos);
+        offsetNormal.assign(layerCount, npos);
+        offsetBinormal.assign(layerCount, npos);
+        offsetTangent.assign(layerCount, npos);
+        offsetUV.assign(layerCount, npos);
+
+        size_t offset = 3u;
+        for(size_t idxLayer = 0u; idxLayer < layerCount; ++idxLayer){
+            if(!pNodeData->bufLayers[idxLayer].colors.empty()){
+                offsetColor[idxLayer] = offset;
+                offset += 4u;
+            }
         }
-
-        for(const auto& i : data.skinData){
-            c = MakeHash<1>(&i.weight);
-            __CAL_RESULT;
-
-            c = reinterpret_cast<size_t>(i.cluster);
-            __CAL_RESULT;
+        for(size_t idxLayer = 0u; idxLayer < layerCount; ++idxLayer){
+            if(!pNodeData->bufLayers[idxLayer].normals.empty()){
+                offsetNormal[idxLayer] = offset;
+                offset += 3u;
+            }
         }
-
-        for(const auto& i : data.layeredColor){
-            c = MakeHash(i.mData);
-            __CAL_RESULT;
+        for(size_t idxLayer = 0u; idxLayer < layerCount; ++idxLayer){
+            if(!pNodeData->bufLayers[idxLayer].binormals.empty()){
+                offsetBinormal[idxLayer] = offset;
+                offset += 3u;
+            }
         }
-
-        for(const auto& i : data.layeredNormal){
-            c = MakeHash(i.mData);
-            __CAL_RESULT;
+        for(size_t idxLayer = 0u; idxLayer < layerCount; ++idxLayer){
+            if(!pNodeData->bufLayers[idxLayer].tangents.empty()){
+                offsetTangent[idxLayer] = offset;
+                offset += 3u;
+            }
         }
-
-        for(const auto& i : data.layeredBinormal){
-            c = MakeHash(i.mData);
-            __CAL_RESULT;
+        for(size_t idxLayer = 0u; idxLayer < layerCount; ++idxLayer){
+            if(!pNodeData->bufLayers[idxLayer].texcoords.table.empty()){
+                offsetUV[idxLayer] = offset;
+                offset += 2u;
+            }
         }
 
-        for(const auto& i : data.layeredTangent){
-            c = MakeHash(i.mData);
-            __CAL_RESULT;
-        }
+        stride = (offset + (lanes - 1u)) & (~(lanes - 1u));
+    }
 
-        for(const auto& i : data.layeredUV){
-            c = MakeHash(i.first.c_str(), i.first.length());
-            __CAL_RESULT;
 
-            c = MakeHash(i.second.mData);
-            __CAL_RESULT;
-        }
+public:
+    fbx_vector<size_t> offsetColor;
+    fbx_vector<size_t> offsetNormal;
+    fbx_vector<size_t> offsetBinormal;
+    fbx_vector<size_t> offsetTangent;
+    fbx_vector<size_t> offsetUV;
 
-#undef __CAL_RESULT
+    size_t stride;
+};
 
-        return result;
-    }
+template<typename T>
+class _VertexInfoKey{
+public:
+    _VertexInfoKey(unsigned int _index, size_t _hash)
+        :
+        hash(_hash),
+        index(_index)
+    {}
 
 
 public:
-    FbxDouble3 position;
+    inline operator size_t()const{ return hash; }
 
-    fbx_vector<SkinInfo> skinData;
 
-    Vector4Container layeredColor;
+public:
+    const size_t hash;
+    const unsigned int index;
+};
 
-    Unit3Container layeredNormal;
-    Unit3Container layeredBinormal;
-    Unit3Container layeredTangent;
 
-    fbx_vector<std::pair<fbx_basic_string<char>, FbxDouble2>> layeredUV;
-};
-static inline bool operator==(const _VertexInfo& lhs, const _VertexInfo& rhs){
-    {
-        const auto& lhsVal = lhs.position;
-        const auto& rhsVal = rhs.position;
+static _VertexStreamLayout ins_soaLayout;
+static const NodeData* ins_soaSource = nullptr;
 
-        if(lhsVal.mData[0] != rhsVal.mData[0])
-            return false;
-        if(lhsVal.mData[1] != rhsVal.mData[1])
-            return false;
-        if(lhsVal.mData[2] != rhsVal.mData[2])
-            return false;
-    }
+template<typename T>
+static fbx_vector<T> ins_soaVertices;
+static bool ins_soaSinglePrecision = false;
+static size_t ins_soaVertexCount = 0u;
+static fbx_vector<unsigned int> ins_soaSkinSources;
+static Uint3Container ins_soaPolygons;
 
-    if(lhs.skinData.size() != rhs.skinData.size())
-        return false;
-    for(auto edx = (unsigned int)lhs.skinData.size(), idx = 0u; idx < edx; ++idx){
-        const auto& lhsSkin = lhs.skinData[idx];
-        const auto& rhsSkin = rhs.skinData[idx];
-        if(lhsSkin.weight != rhsSkin.weight)
-            return false;
-        if(lhsSkin.cluster != rhsSkin.cluster)
-            return false;
-    }
 
-    if(lhs.layeredColor.size() != rhs.layeredColor.size())
-        return false;
-    for(auto edx = (unsigned int)lhs.layeredColor.size(), idx = 0u; idx < edx; ++idx){
-        const auto& lhsVal = lhs.layeredColor[idx];
-        const auto& rhsVal = rhs.layeredColor[idx];
+// weights are compared in the working precision, so the merge agrees with the hash
+template<typename T>
+static inline bool ins_isSameSkin(unsigned int idxLhs, unsigned int idxRhs){
+    if(idxLhs == idxRhs)
+        return true;
 
-        if(lhsVal.mData[0] != rhsVal.mData[0])
-            return false;
-        if(lhsVal.mData[1] != rhsVal.mData[1])
-            return false;
-        if(lhsVal.mData[2] != rhsVal.mData[2])
-            return false;
-        if(lhsVal.mData[3] != rhsVal.mData[3])
-            return false;
-    }
+    const auto& lhsSkin = ins_soaSource->bufSkinData[idxLhs];
+    const auto& rhsSkin = ins_soaSource->bufSkinData[idxRhs];
 
-    if(lhs.layeredNormal.size() != rhs.layeredNormal.size())
+    if(lhsSkin.size() != rhsSkin.size())
         return false;
-    for(auto edx = (unsigned int)lhs.layeredNormal.size(), idx = 0u; idx < edx; ++idx){
-        const auto& lhsVal = lhs.layeredNormal[idx];
-        const auto& rhsVal = rhs.layeredNormal[idx];
-
-        if(lhsVal.mData[0] != rhsVal.mData[0])
-            return false;
-        if(lhsVal.mData[1] != rhsVal.mData[1])
+    for(auto edx = (unsigned int)lhsSkin.size(), idx = 0u; idx < edx; ++idx){
+        if(T(lhsSkin[idx].weight) != T(rhsSkin[idx].weight))
             return false;
-        if(lhsVal.mData[2] != rhsVal.mData[2])
+        if(lhsSkin[idx].cluster != rhsSkin[idx].cluster)
             return false;
     }
 
-    if(lhs.layeredBinormal.size() != rhs.layeredBinormal.size())
-        return false;
-    for(auto edx = (unsigned int)lhs.layeredBinormal.size(), idx = 0u; idx < edx; ++idx){
-        const auto& lhsVal = lhs.layeredBinormal[idx];
-        const auto& rhsVal = rhs.layeredBinormal[idx];
-
-        if(lhsVal.mData[0] != rhsVal.mData[0])
-            return false;
-        if(lhsVal.mData[1] != rhsVal.mData[1])
+    return true;
+}
+// stride is always a multiple of the lane count. _mm_cmpeq_pd/ps keep exact operator== semantics(-0. == +0., NaN != NaN)
+static inline bool ins_isSameRecord(const double* pLhs, const double* pRhs, size_t uStride){
+    for(size_t i = 0u; i < uStride; i += 2u){
+        auto xmm_eq = _mm_cmpeq_pd(_mm_loadu_pd(pLhs + i), _mm_loadu_pd(pRhs + i));
+        if(_mm_movemask_pd(xmm_eq) != 0x3)
             return false;
-        if(lhsVal.mData[2] != rhsVal.mData[2])
+    }
+    return true;
+}
+static inline bool ins_isSameRecord(const float* pLhs, const float* pRhs, size_t uStride){
+    for(size_t i = 0u; i < uStride; i += 4u){
+        auto xmm_eq = _mm_cmpeq_ps(_mm_loadu_ps(pLhs + i), _mm_loadu_ps(pRhs + i));
+        if(_mm_movemask_ps(xmm_eq) != 0xf)
             return false;
     }
+    return true;
+}
 
-    if(lhs.layeredTangent.size() != rhs.layeredTangent.size())
-        return false;
-    for(auto edx = (unsigned int)lhs.layeredTangent.size(), idx = 0u; idx < edx; ++idx){
-        const auto& lhsVal = lhs.layeredTangent[idx];
-        const auto& rhsVal = rhs.layeredTangent[idx];
+template<typename T>
+static inline bool ins_isSameVertex(unsigned int idxLhs, unsigned int idxRhs){
+    const auto uStride = ins_soaLayout.stride;
 
-        if(lhsVal.mData[0] != rhsVal.mData[0])
-            return false;
-        if(lhsVal.mData[1] != rhsVal.mData[1])
-            return false;
-        if(lhsVal.mData[2] != rhsVal.mData[2])
-            return false;
-    }
+    const auto* pLhs = ins_soaVertices<T>.data() + (idxLhs * uStride);
+    const auto* pRhs = ins_soaVertices<T>.data() + (idxRhs * uStride);
 
-    if(lhs.layeredUV.size() != rhs.layeredUV.size())
+    if(!ins_isSameRecord(pLhs, pRhs, uStride))
         return false;
-    for(auto edx = (unsigned int)lhs.layeredUV.size(), idx = 0u; idx < edx; ++idx){
-        const auto& lhsVal = lhs.layeredUV[idx];
-        const auto& rhsVal = rhs.layeredUV[idx];
 
-        if(lhsVal.second.mData[0] != rhsVal.second.mData[0])
-            return false;
-        if(lhsVal.second.mData[1] != rhsVal.second.mData[1])
-            return false;
-
-        if(lhsVal.first != rhsVal.first)
+    if(!ins_soaSource->bufSkinData.empty()){
+        if(!ins_isSameSkin<T>(ins_soaSkinSources[idxLhs], ins_soaSkinSources[idxRhs]))
             return false;
     }
 
     return true;
 }
+template<typename T>
+static inline bool operator==(const _VertexInfoKey<T>& lhs, const _VertexInfoKey<T>& rhs){
+    return ins_isSameVertex<T>(lhs.index, rhs.index);
+}
 
-class _PolygonInfo{
-public:
-    inline bool useSameMaterial(const _PolygonInfo& rhs)const{
-        if(layeredMaterial.size() != rhs.layeredMaterial.size())
-            return false;
-        for(auto edx = (unsigned int)layeredMaterial.size(), idx = 0u; idx < edx; ++idx){
-            if(layeredMaterial[idx] != rhs.layeredMaterial[idx])
-                return false;
-        }
-
-        return true;
-    }
-
-
-public:
-    Uint3 indices;
-    UintContainer layeredMaterial;
-};
-
-class _VertexInfoKey{
-public:
-    _VertexInfoKey(const _VertexInfo& _data, size_t _hash)
-        :
-        hash(_hash),
-        data(_data)
-    {}
+template<typename T>
+static fbx_unordered_map<_VertexInfoKey<T>, unsigned int, CustomHasher<_VertexInfoKey<T>>> ins_soaVertexFinder;
 
 
-public:
-    inline operator size_t()const{ return hash; }
+template<typename T>
+static inline unsigned long long ins_makeSkinHash(const fbx_vector<SkinInfo>& skinData, unsigned long long seed){
+    auto result = seed;
 
+    for(const auto& i : skinData){
+        const auto weight = T(i.weight);
+        result = CombineHash64(result, MakeHash64(&weight, 1u));
+        result = CombineHash64(result, (unsigned long long)reinterpret_cast<size_t>(i.cluster));
+    }
 
-public:
-    const size_t hash;
-    const _VertexInfo& data;
-};
-static inline bool operator==(const _VertexInfoKey& lhs, const _VertexInfoKey& rhs){
-    return (lhs.data == rhs.data);
+    return result;
 }
 
+template<typename T>
+static inline void ins_fillVertexRecord(T* pRecord, unsigned int idxVert){
+    const auto& layout = ins_soaLayout;
+    const auto& bufLayers = ins_soaSource->bufLayers;
+
+    CopyArrayData<3>(pRecord, ins_soaSource->bufPositions[idxVert].mData);
+
+    for(auto edxLayer = bufLayers.size(), idxLayer = size_t(0u); idxLayer < edxLayer; ++idxLayer){
+        const auto& iLayer = bufLayers[idxLayer];
+
+        if(layout.offsetColor[idxLayer] != layout.npos)
+            CopyArrayData<4>(pRecord + layout.offsetColor[idxLayer], iLayer.colors[idxVert].mData);
+        if(layout.offsetNormal[idxLayer] != layout.npos)
+            CopyArrayData<3>(pRecord + layout.offsetNormal[idxLayer], iLayer.normals[idxVert].mData);
+        if(layout.offsetBinormal[idxLayer] != layout.npos)
+            CopyArrayData<3>(pRecord + layout.offsetBinormal[idxLayer], iLayer.binormals[idxVert].mData);
+        if(layout.offsetTangent[idxLayer] != layout.npos)
+            CopyArrayData<3>(pRecord + layout.offsetTangent[idxLayer], iLayer.tangents[idxVert].mData);
+        if(layout.offsetUV[idxLayer] != layout.npos)
+            CopyArrayData<2>(pRecord + layout.offsetUV[idxLayer], iLayer.texcoords.table[idxVert].mData);
+    }
+}
 
-static fbx_vector<_VertexInfo> ins_aosVertices;
-static fbx_vector<_PolygonInfo> ins_aosPolygons;
+template<typename T>
+static inline void ins_fillSOAContainers(const NodeData* pNodeData){
+    auto& soaVertices = ins_soaVertices<T>;
+    auto& soaVertexFinder = ins_soaVertexFinder<T>;
 
-static fbx_unordered_map<_VertexInfoKey, unsigned int, CustomHasher<_VertexInfoKey>> ins_aosVertexFinder;
-static fbx_vector<unsigned int> ins_flatVertexBinder;
+    ins_soaSource = pNodeData;
+    ins_soaLayout.init(pNodeData, sizeof(__m128) / sizeof(T));
 
+    const bool isSkinned = (!pNodeData->bufSkinData.empty());
+    const auto uStride = ins_soaLayout.stride;
 
-static inline void ins_fillAOSContainers(const NodeData* pNodeData){
-    const auto layerCount = pNodeData->bufLayers.size();
     { // reserve
         const auto vertexCount = pNodeData->bufPositions.size();
         const auto polyCount = pNodeData->bufIndices.size();
 
-        ins_flatVertexBinder.resize(vertexCount);
+        soaVertexFinder.clear();
+        soaVertexFinder.rehash(vertexCount << 1);
 
-        ins_aosVertexFinder.clear();
-        ins_aosVertexFinder.rehash(vertexCount << 1);
+        // one extra record is used as scratch for the candidate vertex
+        soaVertices.clear();
+        soaVertices.reserve((vertexCount + 1u) * uStride);
 
-        ins_aosVertices.clear();
-        ins_aosVertices.reserve(vertexCount);
+        ins_soaSkinSources.clear();
+        if(isSkinned)
+            ins_soaSkinSources.reserve(vertexCount + 1u);
 
-        ins_aosPolygons.resize(polyCount);
-        for(auto& iPoly : ins_aosPolygons){
-            iPoly.layeredMaterial.resize(layerCount);
-        }
+        ins_soaPolygons.resize(polyCount);
     }
 
     for(auto edxPoly = (unsigned int)pNodeData->bufIndices.size(), idxPoly = 0u; idxPoly < edxPoly; ++idxPoly){
         const auto& iPoly = pNodeData->bufIndices[idxPoly];
 
-        auto& iPolyInfo = ins_aosPolygons[idxPoly];
-
-        for(auto edxLayer = (unsigned int)pNodeData->bufLayers.size(), idxLayer = 0u; idxLayer < edxLayer; ++idxLayer){
-            const auto& iLayer = pNodeData->bufLayers[idxLayer];
-
-            iPolyInfo.layeredMaterial[idxLayer] = (!iLayer.materials.empty()) ? iLayer.materials[idxPoly] : (-1);
-        }
+        auto& iPolyInfo = ins_soaPolygons[idxPoly];
 
         for(size_t idxLocalVert = 0u; idxLocalVert < 3u; ++idxLocalVert){
             const auto idxVert = iPoly.raw[idxLocalVert];
 
+            // candidate is written in place at the tail and dropped again if it already exists
+            const auto idxCandidate = (unsigned int)(soaVertices.size() / uStride);
+            soaVertices.resize(soaVertices.size() + uStride, T(0));
+            ins_fillVertexRecord(soaVertices.data() + (idxCandidate * uStride), idxVert);
+
+            auto uHash = MakeHash64(soaVertices.data() + (idxCandidate * uStride), uStride);
+            if(isSkinned){
+                ins_soaSkinSources.emplace_back(idxVert);
+                uHash = ins_makeSkinHash<T>(pNodeData->bufSkinData[idxVert], uHash);
+            }
+
+            const auto iVertInfoHash = (size_t)uHash;
+
             unsigned int idxVertInfo;
-            {
-                _VertexInfo iVertInfo;
-                {
-                    iVertInfo.position = pNodeData->bufPositions[idxVert];
-
-                    if(!pNodeData->bufSkinData.empty())
-                        iVertInfo.skinData = pNodeData->bufSkinData[idxVert];
-
-                    size_t colorCount = 0u;
-                    size_t normalCount = 0u;
-                    size_t binormalCount = 0u;
-                    size_t tangentCount = 0u;
-                    size_t uvCount = 0u;
-
-                    for(size_t idxLayer = 0u; idxLayer < layerCount; ++idxLayer){
-                        const auto& iLayer = pNodeData->bufLayers[idxLayer];
-
-                        if(!iLayer.colors.empty())
-                            ++colorCount;
-                        if(!iLayer.normals.empty())
-                            ++normalCount;
-                        if(!iLayer.binormals.empty())
-                            ++binormalCount;
-                        if(!iLayer.tangents.empty())
-                            ++tangentCount;
-                        if(!iLayer.texcoords.table.empty())
-                            ++uvCount;
-                    }
-
-                    iVertInfo.layeredColor.resize(colorCount);
-                    iVertInfo.layeredNormal.resize(normalCount);
-                    iVertInfo.layeredBinormal.resize(binormalCount);
-                    iVertInfo.layeredTangent.resize(tangentCount);
-                    iVertInfo.layeredUV.resize(uvCount);
-
-                    for(auto edxLayer = (unsigned int)iVertInfo.layeredColor.size(), idxLayer = 0u; idxLayer < edxLayer; ++idxLayer){
-                        const auto& iLayer = pNodeData->bufLayers[idxLayer];
-
-                        iVertInfo.layeredColor[idxLayer] = iLayer.colors[idxVert];
-                    }
-                    for(auto edxLayer = (unsigned int)iVertInfo.layeredNormal.size(), idxLayer = 0u; idxLayer < edxLayer; ++idxLayer){
-                        const auto& iLayer = pNodeData->bufLayers[idxLayer];
-
-                        iVertInfo.layeredNormal[idxLayer] = iLayer.normals[idxVert];
-                    }
-                    for(auto edxLayer = (unsigned int)iVertInfo.layeredBinormal.size(), idxLayer = 0u; idxLayer < edxLayer; ++idxLayer){
-                        const auto& iLayer = pNodeData->bufLayers[idxLayer];
-
-                        iVertInfo.layeredBinormal[idxLayer] = iLayer.binormals[idxVert];
-                    }
-                    for(auto edxLayer = (unsigned int)iVertInfo.layeredTangent.size(), idxLayer = 0u; idxLayer < edxLayer; ++idxLayer){
-                        const auto& iLayer = pNodeData->bufLayers[idxLayer];
-
-                        iVertInfo.layeredTangent[idxLayer] = iLayer.tangents[idxVert];
-                    }
-                    for(auto edxLayer = (unsigned int)iVertInfo.layeredUV.size(), idxLayer = 0u; idxLayer < edxLayer; ++idxLayer){
-                        const auto& iLayer = pNodeData->bufLayers[idxLayer];
-
-                        auto& v = iVertInfo.layeredUV[idxLayer];
-                        v.first = iLayer.texcoords.name;
-                        v.second = iLayer.texcoords.table[idxVert];
-                    }
-                }
-
-                const auto iVertInfoHash = _VertexInfo::makeHash(iVertInfo);
-                auto fVertexInfo = ins_aosVertexFinder.find(_VertexInfoKey(iVertInfo, iVertInfoHash));
-                if(fVertexInfo == ins_aosVertexFinder.end()){
-                    idxVertInfo = decltype(idxVertInfo)(ins_aosVertices.size());
-                    ins_aosVertices.emplace_back(std::move(iVertInfo));
-
-                    ins_aosVertexFinder.emplace(_VertexInfoKey(ins_aosVertices[idxVertInfo], iVertInfoHash), idxVertInfo);
-                }
-                else{
-                    idxVertInfo = fVertexInfo->second;
-                }
+            auto fVertexInfo = soaVertexFinder.find(_VertexInfoKey<T>(idxCandidate, iVertInfoHash));
+            if(fVertexInfo == soaVertexFinder.end()){
+                idxVertInfo = idxCandidate;
+                soaVertexFinder.emplace(_VertexInfoKey<T>(idxVertInfo, iVertInfoHash), idxVertInfo);
             }
+            else{
+                idxVertInfo = fVertexInfo->second;
 
-            iPolyInfo.indices.raw[idxLocalVert] = idxVertInfo;
+                soaVertices.resize(soaVertices.size() - uStride);
+                if(isSkinned)
+                    ins_soaSkinSources.pop_back();
+            }
 
-            ins_flatVertexBinder[idxVert] = idxVertInfo;
+            iPolyInfo.raw[idxLocalVert] = idxVertInfo;
         }
     }
+
+    ins_soaVertexCount = soaVertices.size() / uStride;
 }
 
+// only polygons and skin data go back to NodeData. vertex data stays in the record stream until SHRStoreOptimizedMesh,
+// so the per-vertex buffers of NodeData are released here instead of being rewritten
 static inline void ins_genOptimizeMesh(NodeData* pNodeData){
     const bool isSkinned = (!pNodeData->bufSkinData.empty());
 
-    {
-        pNodeData->bufIndices.clear();
-        for(const auto& iPolyInfo : ins_aosPolygons)
-            pNodeData->bufIndices.emplace_back(iPolyInfo.indices);
-    }
-    {
-        pNodeData->bufPositions.clear();
-        for(const auto& iVertInfo : ins_aosVertices)
-            pNodeData->bufPositions.emplace_back(iVertInfo.position);
-    }
+    // polygon order is left untouched, thus material indices per polygon stay valid as they are
+    pNodeData->bufIndices.swap(ins_soaPolygons);
+
     if(isSkinned){
-        pNodeData->bufSkinData.clear();
-        for(const auto& iVertInfo : ins_aosVertices)
-            pNodeData->bufSkinData.emplace_back(std::move(iVertInfo.skinData));
+        SkinInfoContainer newSkinData(ins_soaVertexCount);
+        for(size_t idxVert = 0u; idxVert < ins_soaVertexCount; ++idxVert)
+            newSkinData[idxVert] = std::move(pNodeData->bufSkinData[ins_soaSkinSources[idxVert]]);
+        pNodeData->bufSkinData.swap(newSkinData);
     }
 
-    for(auto edxLayer = (unsigned int)pNodeData->bufLayers.size(), idxLayer = 0u; idxLayer < edxLayer; ++idxLayer){
-        auto& iLayer = pNodeData->bufLayers[idxLayer];
+    Vector3Container().swap(pNodeData->bufPositions);
+    for(auto& iLayer : pNodeData->bufLayers){
+        Vector4Container().swap(iLayer.colors);
+        Unit3Container().swap(iLayer.normals);
+        Unit3Container().swap(iLayer.binormals);
+        Unit3Container().swap(iLayer.tangents);
+        fbx_vector<FbxDouble2>().swap(iLayer.texcoords.table);
+    }
 
-        if(!iLayer.materials.empty()){
-            iLayer.materials.clear();
-            for(const auto& iPolyInfo : ins_aosPolygons){
-                const auto& curMat = iPolyInfo.layeredMaterial[idxLayer];
-                if(curMat >= 0u)
-                    iLayer.materials.emplace_back((unsigned int)curMat);
-            }
-        }
+    ins_soaSource = nullptr;
+}
 
-        if(!iLayer.colors.empty()){
-            iLayer.colors.clear();
-            for(const auto& iVertInfo : ins_aosVertices)
-                iLayer.colors.emplace_back(iVertInfo.layeredColor[idxLayer]);
-        }
+static inline void ins_convElement(FBXStaticArray<float, 4>& dest, const double* src){
+    _mm_storeu_ps(dest.Values, _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(src)), _mm_cvtpd_ps(_mm_loadu_pd(src + 2))));
+}
+static inline void ins_convElement(FBXStaticArray<float, 3>& dest, const double* src){
+    _mm_storel_pi(reinterpret_cast<__m64*>(dest.Values), _mm_cvtpd_ps(_mm_loadu_pd(src)));
+    _mm_store_ss(dest.Values + 2, _mm_cvtsd_ss(_mm_setzero_ps(), _mm_load_sd(src + 2)));
+}
+static inline void ins_convElement(FBXStaticArray<float, 2>& dest, const double* src){
+    _mm_storel_pi(reinterpret_cast<__m64*>(dest.Values), _mm_cvtpd_ps(_mm_loadu_pd(src)));
+}
+template<unsigned long LEN>
+static inline void ins_convElement(FBXStaticArray<float, LEN>& dest, const float* src){
+    CopyArrayData(dest.Values, src);
+}
 
-        if(!iLayer.normals.empty()){
-            iLayer.normals.clear();
-            for(const auto& iVertInfo : ins_aosVertices)
-                iLayer.normals.emplace_back(iVertInfo.layeredNormal[idxLayer]);
-        }
+// gathers one attribute out of the records in the final vertex order
+template<typename T, unsigned long LEN>
+static inline void ins_storeStream(FBXDynamicArray<FBXStaticArray<float, LEN>>& dest, const UintContainer& vertexOrder, size_t offset){
+    if(offset == _VertexStreamLayout::npos){
+        dest.Assign(0u);
+        return;
+    }
 
-        if(!iLayer.binormals.empty()){
-            iLayer.binormals.clear();
-            for(const auto& iVertInfo : ins_aosVertices)
-                iLayer.binormals.emplace_back(iVertInfo.layeredBinormal[idxLayer]);
-        }
+    const auto uStride = ins_soaLayout.stride;
+    const auto* pStream = ins_soaVertices<T>.data() + offset;
 
-        if(!iLayer.tangents.empty()){
-            iLayer.tangents.clear();
-            for(const auto& iVertInfo : ins_aosVertices)
-                iLayer.tangents.emplace_back(iVertInfo.layeredTangent[idxLayer]);
-        }
+    dest.Assign(vertexOrder.size());
+    for(size_t idxVert = 0u; idxVert < dest.Length; ++idxVert)
+        ins_convElement(dest.Values[idxVert], pStream + (size_t(vertexOrder[idxVert]) * uStride));
+}
 
-        if(!iLayer.texcoords.table.empty()){
-            iLayer.texcoords.table.clear();
-            for(const auto& iVertInfo : ins_aosVertices)
-                iLayer.texcoords.table.emplace_back(iVertInfo.layeredUV[idxLayer].second);
-        }
+template<typename T>
+static inline void ins_storeOptimizedVertices(const NodeData* pNodeData, FBXMesh* pMesh){
+    const auto& layout = ins_soaLayout;
+    const auto& vertexOrder = pNodeData->bufVertexOrder;
+
+    ins_storeStream<T>(pMesh->Vertices, vertexOrder, 0u);
+
+    for(size_t idxLayer = 0u; idxLayer < pMesh->LayeredElements.Length; ++idxLayer){
+        auto& iLayer = pMesh->LayeredElements.Values[idxLayer];
+
+        ins_storeStream<T>(iLayer.Color, vertexOrder, layout.offsetColor[idxLayer]);
+        ins_storeStream<T>(iLayer.Normal, vertexOrder, layout.offsetNormal[idxLayer]);
+        ins_storeStream<T>(iLayer.Binormal, vertexOrder, layout.offsetBinormal[idxLayer]);
+        ins_storeStream<T>(iLayer.Tangent, vertexOrder, layout.offsetTangent[idxLayer]);
+        ins_storeStream<T>(iLayer.Texcoord, vertexOrder, layout.offsetUV[idxLayer]);
     }
 }
 
@@ -469,8 +415,63 @@ static inline void ins_removeUnusedDeforms(NodeData* pNodeData){
 
 
 void SHROptimizeMesh(NodeData* pNodeData){
-    ins_fillAOSContainers(pNodeData);
+    ins_soaSinglePrecision = shr_ioSetting.WeldInSinglePrecision;
+
+    if(ins_soaSinglePrecision)
+        ins_fillSOAContainers<float>(pNodeData);
+    else
+        ins_fillSOAContainers<double>(pNodeData);
+
     ins_genOptimizeMesh(pNodeData);
     ins_removeDuplicatedDeforms(pNodeData);
     ins_removeUnusedDeforms(pNodeData);
 }
+
+size_t SHRGetOptimizedVertexCount(){
+    return ins_soaVertexCount;
+}
+
+void SHRStoreOptimizedMesh(const NodeData* pNodeData, FBXMesh* pMesh){
+    pMesh->Attributes.Assign(pNodeData->bufMeshAttribute.size());
+    for(size_t idxAttr = 0u; idxAttr < pMesh->Attributes.Length; ++idxAttr){
+        const auto& iOldAttr = pNodeData->bufMeshAttribute[idxAttr];
+        auto& iNewAttr = pMesh->Attributes.Values[idxAttr];
+
+        iNewAttr.VertexStart = iOldAttr.VertexFirst;
+        iNewAttr.IndexStart = iOldAttr.PolygonFirst;
+
+        iNewAttr.VertexCount = 1 + iOldAttr.VertexLast - iOldAttr.VertexFirst;
+        iNewAttr.IndexCount = 1 + iOldAttr.PolygonLast - iOldAttr.PolygonFirst;
+    }
+
+    pMesh->Indices.Assign(pNodeData->bufIndices.size());
+    for(size_t idxInd = 0u; idxInd < pMesh->Indices.Length; ++idxInd){
+        auto& iInd = pMesh->Indices.Values[idxInd];
+
+        CopyArrayData(iInd.Values, pNodeData->bufIndices[idxInd].raw);
+    }
+
+    pMesh->LayeredElements.Assign(pNodeData->bufLayers.size());
+    for(size_t idxLayer = 0u; idxLayer < pMesh->LayeredElements.Length; ++idxLayer){
+        auto& iObject = pMesh->LayeredElements.Values[idxLayer].Material;
+        const auto& nodeObject = pNodeData->bufLayers[idxLayer].materials;
+
+        if(nodeObject.empty())
+            iObject.Assign(0u);
+        else{
+            iObject.Assign(pNodeData->bufMeshAttribute.size());
+            for(size_t idxMat = 0u; idxMat < iObject.Length; ++idxMat){
+                const auto idxOldMat = pMesh->Attributes.Values[idxMat].IndexStart;
+                iObject.Values[idxMat] = nodeObject[idxOldMat];
+            }
+        }
+    }
+
+    if(ins_soaSinglePrecision)
+        ins_storeOptimizedVertices<float>(pNodeData, pMesh);
+    else
+        ins_storeOptimizedVertices<double>(pNodeData, pMesh);
+
+    pMesh->Materials.Assign(pNodeData->bufMaterials.size());
+    CopyArrayData(pMesh->Materials.Values, pNodeData->bufMaterials.data(), pMesh->Materials.Length);
+}
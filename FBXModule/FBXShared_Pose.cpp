@@ -0,0 +1,813 @@
+﻿/**
+ * @file FBXShared_Pose.cpp
+ * @date 2026/10/19
+ * @author Lim Taewoo (limztudio@gmail.com)
+ */
+
+
+#include "stdafx.h"
+
+#include <algorithm>
+
+#ifdef _SIMD_AVX
+#include <immintrin.h>
+#endif
+
+#include "FBXUtilites.h"
+#include "FBXMath.h"
+#include "FBXShared.h"
+
+
+// every FBXAnimationNode is a lane. four lanes are gathered per step and interpolated together in SoA form
+
+
+static const unsigned long ins_poseLaneCount = 4;
+
+// value = basis[0] * from + basis[1] * to + basis[2] * fromTangent + basis[3] * toTangent.
+// stepped and linear lanes get a linear basis with zero tangents, so every lane runs the same math
+template<unsigned long N>
+class _PoseLanes{
+public:
+    float from[N][ins_poseLaneCount];
+    float to[N][ins_poseLaneCount];
+    float fromTangent[N][ins_poseLaneCount];
+    float toTangent[N][ins_poseLaneCount];
+    float basis[4][ins_poseLaneCount];
+    float weight[ins_poseLaneCount];
+    float cubic[ins_poseLaneCount];
+};
+
+
+// tracks without a bind node are taken as bound to identity
+static inline void ins_loadBindMatrix(FbxAMatrix& matOut, const FBXNode* pNode, bool bWorld){
+    if(!pNode){
+        matOut.SetIdentity();
+        return;
+    }
+    if(!bWorld){
+        CopyArrayData<pNode->TransformMatrix.Length>((double*)matOut, pNode->TransformMatrix.Values);
+        return;
+    }
+
+    matOut = GetBindWorldTransform(pNode);
+}
+
+template<unsigned long N>
+static inline void ins_gatherLane(
+    _PoseLanes<N>& lanes,
+    unsigned long lane,
+    const FBXDynamicArray<FBXAnimationKeyFrame<FBXStaticArray<float, N>>>& keys,
+    const FBXDynamicArray<FBXAnimationKeyTangent<FBXStaticArray<float, N>>>& tangents,
+    FBXStaticArray<float, N> FBXAnimationKeyFrame<FBXStaticArray<float, N>>::* member,
+    FBXAnimationTangent<FBXStaticArray<float, N>> FBXAnimationKeyTangent<FBXStaticArray<float, N>>::* tangentMember,
+    float time,
+    unsigned long& cursor
+){
+    cursor = FindAnimationKey(keys, time, cursor);
+
+    const auto idxTo = std::min<unsigned long>(cursor + 1, keys.Length - 1);
+    const auto& kFrom = keys.Values[cursor];
+    const auto& kTo = keys.Values[idxTo];
+
+    auto type = FBXAnimationInterpolationType::FBXAnimationInterpolationType_Stepped;
+    float weight = 0.f;
+    float duration = 0.f;
+    if(&kFrom != &kTo){
+        type = kFrom.InterpolationType;
+        duration = kTo.Time - kFrom.Time;
+        weight = std::clamp((time - kFrom.Time) / duration, 0.f, 1.f);
+    }
+
+    const bool bCubic = (type == FBXAnimationInterpolationType::FBXAnimationInterpolationType_Cubic);
+    if(bCubic){
+        const auto weight2 = weight * weight;
+        const auto weight3 = weight2 * weight;
+
+        lanes.basis[0][lane] = 2.f * weight3 - 3.f * weight2 + 1.f;
+        lanes.basis[1][lane] = -2.f * weight3 + 3.f * weight2;
+        lanes.basis[2][lane] = (weight3 - 2.f * weight2 + weight) * duration;
+        lanes.basis[3][lane] = (weight3 - weight2) * duration;
+    }
+    else{
+        if(type == FBXAnimationInterpolationType::FBXAnimationInterpolationType_Stepped)
+            weight = 0.f;
+
+        lanes.basis[0][lane] = 1.f - weight;
+        lanes.basis[1][lane] = weight;
+        lanes.basis[2][lane] = 0.f;
+        lanes.basis[3][lane] = 0.f;
+    }
+
+    const auto& kFromTangent = GetKeyTangent(tangents, cursor).*tangentMember;
+    const auto& kToTangent = GetKeyTangent(tangents, idxTo).*tangentMember;
+    for(unsigned long idx = 0; idx < N; ++idx){
+        lanes.from[idx][lane] = (kFrom.*member).Values[idx];
+        lanes.to[idx][lane] = (kTo.*member).Values[idx];
+        lanes.fromTangent[idx][lane] = bCubic ? kFromTangent.Out.Values[idx] : 0.f;
+        lanes.toTangent[idx][lane] = bCubic ? kToTangent.In.Values[idx] : 0.f;
+    }
+    lanes.weight[lane] = weight;
+    lanes.cubic[lane] = bCubic ? 1.f : 0.f;
+}
+template<unsigned long N>
+static inline void ins_fillLane(_PoseLanes<N>& lanes, unsigned long lane, const double* value){
+    for(unsigned long idx = 0; idx < N; ++idx){
+        lanes.from[idx][lane] = lanes.to[idx][lane] = (float)value[idx];
+        lanes.fromTangent[idx][lane] = lanes.toTangent[idx][lane] = 0.f;
+    }
+
+    lanes.basis[0][lane] = 1.f;
+    lanes.basis[1][lane] = 0.f;
+    lanes.basis[2][lane] = 0.f;
+    lanes.basis[3][lane] = 0.f;
+
+    lanes.weight[lane] = 0.f;
+    lanes.cubic[lane] = 0.f;
+}
+
+template<unsigned long N>
+static inline void ins_storeLanes(float* const (&planes)[N], const DirectX::XMVECTOR (&values)[N], unsigned long first, unsigned long count){
+    if(count == ins_poseLaneCount){
+        for(unsigned long idx = 0; idx < N; ++idx)
+            DirectX::XMStoreFloat4((DirectX::XMFLOAT4*)(planes[idx] + first), values[idx]);
+    }
+    else{
+        DirectX::XMFLOAT4A tmp;
+        for(unsigned long idx = 0; idx < N; ++idx){
+            DirectX::XMStoreFloat4A(&tmp, values[idx]);
+            CopyArrayData(planes[idx] + first, &tmp.x, count);
+        }
+    }
+}
+
+template<unsigned long N>
+static inline void ins_blendLanes(DirectX::XMVECTOR (&values)[N], const _PoseLanes<N>& lanes, bool bFlipTo = false, DirectX::FXMVECTOR xmm_flip = DirectX::g_XMZero){
+    const auto xmm_basis0 = DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)lanes.basis[0]);
+    const auto xmm_basis2 = DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)lanes.basis[2]);
+
+    auto xmm_basis1 = DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)lanes.basis[1]);
+    auto xmm_basis3 = DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)lanes.basis[3]);
+    if(bFlipTo){
+        xmm_basis1 = DirectX::XMVectorSelect(xmm_basis1, DirectX::XMVectorNegate(xmm_basis1), xmm_flip);
+        xmm_basis3 = DirectX::XMVectorSelect(xmm_basis3, DirectX::XMVectorNegate(xmm_basis3), xmm_flip);
+    }
+
+    for(unsigned long idx = 0; idx < N; ++idx){
+        auto xmm_ret = DirectX::XMVectorMultiply(DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)lanes.from[idx]), xmm_basis0);
+        xmm_ret = DirectX::XMVectorMultiplyAdd(DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)lanes.to[idx]), xmm_basis1, xmm_ret);
+        xmm_ret = DirectX::XMVectorMultiplyAdd(DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)lanes.fromTangent[idx]), xmm_basis2, xmm_ret);
+        xmm_ret = DirectX::XMVectorMultiplyAdd(DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)lanes.toTangent[idx]), xmm_basis3, xmm_ret);
+        values[idx] = xmm_ret;
+    }
+}
+
+static inline void ins_lerpLanes(float* const (&planes)[3], const _PoseLanes<3>& lanes, unsigned long first, unsigned long count){
+    DirectX::XMVECTOR xmm_ret[3];
+    ins_blendLanes(xmm_ret, lanes);
+
+    ins_storeLanes(planes, xmm_ret, first, count);
+}
+// same as XMQuaternionSlerp followed by XMQuaternionNormalize, but four quaternions at once.
+// cubic lanes take the hermite blend instead, with the end key flipped onto the same hemisphere
+static inline void ins_slerpLanes(float* const (&planes)[4], const _PoseLanes<4>& lanes, unsigned long first, unsigned long count){
+    static const DirectX::XMVECTORF32 xmm_threshold = { { { 1.f - 0.00001f, 1.f - 0.00001f, 1.f - 0.00001f, 1.f - 0.00001f } } };
+
+    const auto xmm_weight = DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)lanes.weight);
+
+    DirectX::XMVECTOR xmm_from[4];
+    DirectX::XMVECTOR xmm_to[4];
+    for(unsigned long idx = 0; idx < 4; ++idx){
+        xmm_from[idx] = DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)lanes.from[idx]);
+        xmm_to[idx] = DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)lanes.to[idx]);
+    }
+
+    auto xmm_cos = DirectX::XMVectorMultiply(xmm_from[0], xmm_to[0]);
+    xmm_cos = DirectX::XMVectorMultiplyAdd(xmm_from[1], xmm_to[1], xmm_cos);
+    xmm_cos = DirectX::XMVectorMultiplyAdd(xmm_from[2], xmm_to[2], xmm_cos);
+    xmm_cos = DirectX::XMVectorMultiplyAdd(xmm_from[3], xmm_to[3], xmm_cos);
+
+    const auto xmm_negative = DirectX::XMVectorLess(xmm_cos, DirectX::g_XMZero);
+    xmm_cos = DirectX::XMVectorAbs(xmm_cos);
+
+    auto xmm_sin = DirectX::XMVectorSqrt(DirectX::XMVectorNegativeMultiplySubtract(xmm_cos, xmm_cos, DirectX::g_XMOne));
+    const auto xmm_omega = DirectX::XMVectorATan2(xmm_sin, xmm_cos);
+    xmm_sin = DirectX::XMVectorReciprocal(xmm_sin);
+
+    const auto xmm_inverseWeight = DirectX::XMVectorSubtract(DirectX::g_XMOne, xmm_weight);
+
+    auto xmm_scaleFrom = DirectX::XMVectorMultiply(DirectX::XMVectorSin(DirectX::XMVectorMultiply(xmm_inverseWeight, xmm_omega)), xmm_sin);
+    auto xmm_scaleTo = DirectX::XMVectorMultiply(DirectX::XMVectorSin(DirectX::XMVectorMultiply(xmm_weight, xmm_omega)), xmm_sin);
+
+    // nearly same rotations fall back to lerp, as XMQuaternionSlerp does
+    const auto xmm_close = DirectX::XMVectorGreaterOrEqual(xmm_cos, xmm_threshold);
+    xmm_scaleFrom = DirectX::XMVectorSelect(xmm_scaleFrom, xmm_inverseWeight, xmm_close);
+    xmm_scaleTo = DirectX::XMVectorSelect(xmm_scaleTo, xmm_weight, xmm_close);
+    xmm_scaleTo = DirectX::XMVectorSelect(xmm_scaleTo, DirectX::XMVectorNegate(xmm_scaleTo), xmm_negative);
+
+    DirectX::XMVECTOR xmm_ret[4];
+    for(unsigned long idx = 0; idx < 4; ++idx)
+        xmm_ret[idx] = DirectX::XMVectorMultiplyAdd(xmm_to[idx], xmm_scaleTo, DirectX::XMVectorMultiply(xmm_from[idx], xmm_scaleFrom));
+
+    const auto xmm_cubic = DirectX::XMVectorGreater(DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)lanes.cubic), DirectX::g_XMZero);
+    if(!DirectX::XMVector4EqualInt(xmm_cubic, DirectX::XMVectorFalseInt())){
+        DirectX::XMVECTOR xmm_hermite[4];
+        ins_blendLanes(xmm_hermite, lanes, true, xmm_negative);
+
+        for(unsigned long idx = 0; idx < 4; ++idx)
+            xmm_ret[idx] = DirectX::XMVectorSelect(xmm_ret[idx], xmm_hermite[idx], xmm_cubic);
+    }
+
+    auto xmm_length = DirectX::XMVectorMultiply(xmm_ret[0], xmm_ret[0]);
+    xmm_length = DirectX::XMVectorMultiplyAdd(xmm_ret[1], xmm_ret[1], xmm_length);
+    xmm_length = DirectX::XMVectorMultiplyAdd(xmm_ret[2], xmm_ret[2], xmm_length);
+    xmm_length = DirectX::XMVectorMultiplyAdd(xmm_ret[3], xmm_ret[3], xmm_length);
+    xmm_length = DirectX::XMVectorReciprocalSqrt(xmm_length);
+    for(unsigned long idx = 0; idx < 4; ++idx)
+        xmm_ret[idx] = DirectX::XMVectorMultiply(xmm_ret[idx], xmm_length);
+
+    ins_storeLanes(planes, xmm_ret, first, count);
+}
+
+
+void SHRSampleAnimationPose(const FBXAnimation* pAnimation, float time, bool bWorld, FBXAnimationCursor* pCursors, const FBXAnimationPose& pose){
+    using Vector3Key = FBXAnimationKeyFrame<FBXStaticArray<float, 3>>;
+    using Vector4Key = FBXAnimationKeyFrame<FBXStaticArray<float, 4>>;
+    using Vector3Tangent = FBXAnimationKeyTangent<FBXStaticArray<float, 3>>;
+    using Vector4Tangent = FBXAnimationKeyTangent<FBXStaticArray<float, 4>>;
+
+    auto vector3Member = bWorld ? &Vector3Key::World : &Vector3Key::Local;
+    auto vector4Member = bWorld ? &Vector4Key::World : &Vector4Key::Local;
+    auto vector3TangentMember = bWorld ? &Vector3Tangent::World : &Vector3Tangent::Local;
+    auto vector4TangentMember = bWorld ? &Vector4Tangent::World : &Vector4Tangent::Local;
+
+    _PoseLanes<3> scalingLanes;
+    _PoseLanes<4> rotationLanes;
+    _PoseLanes<3> translationLanes;
+
+    const auto nodeCount = pAnimation->AnimationNodes.Length;
+    for(unsigned long idxFirst = 0; idxFirst < nodeCount; idxFirst += ins_poseLaneCount){
+        const auto laneCount = std::min<unsigned long>(ins_poseLaneCount, nodeCount - idxFirst);
+
+        for(unsigned long idxLane = 0; idxLane < ins_poseLaneCount; ++idxLane){
+            // unused tail lanes repeat the last node, so the math stays finite
+            const auto idxNode = idxFirst + std::min(idxLane, laneCount - 1);
+            const auto& iNode = pAnimation->AnimationNodes.Values[idxNode];
+
+            FBXAnimationCursor tmpCursor;
+            auto& iCursor = pCursors ? pCursors[idxNode] : tmpCursor;
+
+            bool bBindLoaded = false;
+            FbxAMatrix matBind;
+            auto loadBind = [&](){
+                if(!bBindLoaded){
+                    ins_loadBindMatrix(matBind, iNode.BindNode, bWorld);
+                    bBindLoaded = true;
+                }
+            };
+
+            if(iNode.ScalingKeys.Length)
+                ins_gatherLane(scalingLanes, idxLane, iNode.ScalingKeys, iNode.ScalingTangents, vector3Member, vector3TangentMember, time, iCursor.ScalingKey);
+            else{
+                loadBind();
+                ins_fillLane(scalingLanes, idxLane, matBind.GetS().mData);
+            }
+
+            if(iNode.RotationKeys.Length)
+                ins_gatherLane(rotationLanes, idxLane, iNode.RotationKeys, iNode.RotationTangents, vector4Member, vector4TangentMember, time, iCursor.RotationKey);
+            else{
+                loadBind();
+                ins_fillLane(rotationLanes, idxLane, matBind.GetQ().mData);
+            }
+
+            if(iNode.TranslationKeys.Length)
+                ins_gatherLane(translationLanes, idxLane, iNode.TranslationKeys, iNode.TranslationTangents, vector3Member, vector3TangentMember, time, iCursor.TranslationKey);
+            else{
+                loadBind();
+                ins_fillLane(translationLanes, idxLane, matBind.GetT().mData);
+            }
+        }
+
+        ins_lerpLanes(pose.Scaling, scalingLanes, idxFirst, laneCount);
+        ins_slerpLanes(pose.Rotation, rotationLanes, idxFirst, laneCount);
+        ins_lerpLanes(pose.Translation, translationLanes, idxFirst, laneCount);
+    }
+}
+
+
+// blending works on lanes of pose planes directly. tail lanes are padded with zero, and never stored
+template<unsigned long N>
+static inline void ins_loadPlanes(DirectX::XMVECTOR (&values)[N], float* const (&planes)[N], unsigned long first, unsigned long count){
+    if(count == ins_poseLaneCount){
+        for(unsigned long idx = 0; idx < N; ++idx)
+            values[idx] = DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)(planes[idx] + first));
+    }
+    else{
+        DirectX::XMFLOAT4A tmp(0.f, 0.f, 0.f, 0.f);
+        for(unsigned long idx = 0; idx < N; ++idx){
+            CopyArrayData(&tmp.x, planes[idx] + first, count);
+            values[idx] = DirectX::XMLoadFloat4A(&tmp);
+        }
+    }
+}
+static inline DirectX::XMVECTOR ins_loadMask(const float* pMask, unsigned long first, unsigned long count){
+    if(!pMask)
+        return DirectX::g_XMOne;
+    if(count == ins_poseLaneCount)
+        return DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)(pMask + first));
+
+    DirectX::XMFLOAT4A tmp(0.f, 0.f, 0.f, 0.f);
+    CopyArrayData(&tmp.x, pMask + first, count);
+    return DirectX::XMLoadFloat4A(&tmp);
+}
+
+static inline DirectX::XMVECTOR ins_dotLanes(const DirectX::XMVECTOR (&lhs)[4], const DirectX::XMVECTOR (&rhs)[4]){
+    auto xmm_ret = DirectX::XMVectorMultiply(lhs[0], rhs[0]);
+    xmm_ret = DirectX::XMVectorMultiplyAdd(lhs[1], rhs[1], xmm_ret);
+    xmm_ret = DirectX::XMVectorMultiplyAdd(lhs[2], rhs[2], xmm_ret);
+    xmm_ret = DirectX::XMVectorMultiplyAdd(lhs[3], rhs[3], xmm_ret);
+    return xmm_ret;
+}
+// lanes of zero length are left as they are
+static inline void ins_normalizeLanes(DirectX::XMVECTOR (&values)[4]){
+    const auto xmm_length = ins_dotLanes(values, values);
+    const auto xmm_scale = DirectX::XMVectorSelect(DirectX::g_XMOne, DirectX::XMVectorReciprocalSqrt(xmm_length), DirectX::XMVectorGreater(xmm_length, DirectX::g_XMZero));
+    for(unsigned long idx = 0; idx < 4; ++idx)
+        values[idx] = DirectX::XMVectorMultiply(values[idx], xmm_scale);
+}
+
+// XMQuaternionMultiply(lhs, rhs), which is rhs * lhs
+static inline void ins_multiplyQuaternionLanes(DirectX::XMVECTOR (&out)[4], const DirectX::XMVECTOR (&lhs)[4], const DirectX::XMVECTOR (&rhs)[4]){
+    out[0] = DirectX::XMVectorMultiply(rhs[3], lhs[0]);
+    out[0] = DirectX::XMVectorMultiplyAdd(rhs[0], lhs[3], out[0]);
+    out[0] = DirectX::XMVectorMultiplyAdd(rhs[1], lhs[2], out[0]);
+    out[0] = DirectX::XMVectorNegativeMultiplySubtract(rhs[2], lhs[1], out[0]);
+
+    out[1] = DirectX::XMVectorMultiply(rhs[3], lhs[1]);
+    out[1] = DirectX::XMVectorNegativeMultiplySubtract(rhs[0], lhs[2], out[1]);
+    out[1] = DirectX::XMVectorMultiplyAdd(rhs[1], lhs[3], out[1]);
+    out[1] = DirectX::XMVectorMultiplyAdd(rhs[2], lhs[0], out[1]);
+
+    out[2] = DirectX::XMVectorMultiply(rhs[3], lhs[2]);
+    out[2] = DirectX::XMVectorMultiplyAdd(rhs[0], lhs[1], out[2]);
+    out[2] = DirectX::XMVectorNegativeMultiplySubtract(rhs[1], lhs[0], out[2]);
+    out[2] = DirectX::XMVectorMultiplyAdd(rhs[2], lhs[3], out[2]);
+
+    out[3] = DirectX::XMVectorMultiply(rhs[3], lhs[3]);
+    out[3] = DirectX::XMVectorNegativeMultiplySubtract(rhs[0], lhs[0], out[3]);
+    out[3] = DirectX::XMVectorNegativeMultiplySubtract(rhs[1], lhs[1], out[3]);
+    out[3] = DirectX::XMVectorNegativeMultiplySubtract(rhs[2], lhs[2], out[3]);
+}
+
+
+// scaling and translation are averaged by weight, and rotations are summed on the hemisphere of the first pose then normalized.
+// lanes whose weights sum to zero take the first pose
+void SHRBlendPoses(const FBXAnimationPose& pose, const FBXAnimationPose* pPoses, const float* pWeights, const float* const* pMasks, unsigned long poseCount, unsigned long nodeCount){
+    if(!poseCount)
+        return;
+
+    for(unsigned long idxFirst = 0; idxFirst < nodeCount; idxFirst += ins_poseLaneCount){
+        const auto laneCount = std::min<unsigned long>(ins_poseLaneCount, nodeCount - idxFirst);
+
+        DirectX::XMVECTOR xmm_firstScaling[3], xmm_firstRotation[4], xmm_firstTranslation[3];
+        ins_loadPlanes(xmm_firstScaling, pPoses[0].Scaling, idxFirst, laneCount);
+        ins_loadPlanes(xmm_firstRotation, pPoses[0].Rotation, idxFirst, laneCount);
+        ins_loadPlanes(xmm_firstTranslation, pPoses[0].Translation, idxFirst, laneCount);
+
+        DirectX::XMVECTOR xmm_scaling[3] = { DirectX::g_XMZero, DirectX::g_XMZero, DirectX::g_XMZero };
+        DirectX::XMVECTOR xmm_rotation[4] = { DirectX::g_XMZero, DirectX::g_XMZero, DirectX::g_XMZero, DirectX::g_XMZero };
+        DirectX::XMVECTOR xmm_translation[3] = { DirectX::g_XMZero, DirectX::g_XMZero, DirectX::g_XMZero };
+        auto xmm_weightSum = DirectX::XMVectorZero();
+
+        for(unsigned long idxPose = 0; idxPose < poseCount; ++idxPose){
+            const auto& kPose = pPoses[idxPose];
+
+            auto xmm_weight = DirectX::XMVectorMultiply(DirectX::XMVectorReplicate(pWeights[idxPose]), ins_loadMask(pMasks ? pMasks[idxPose] : nullptr, idxFirst, laneCount));
+            xmm_weightSum = DirectX::XMVectorAdd(xmm_weightSum, xmm_weight);
+
+            DirectX::XMVECTOR xmm_vector[3], xmm_quaternion[4];
+
+            ins_loadPlanes(xmm_vector, kPose.Scaling, idxFirst, laneCount);
+            for(unsigned long idx = 0; idx < 3; ++idx)
+                xmm_scaling[idx] = DirectX::XMVectorMultiplyAdd(xmm_vector[idx], xmm_weight, xmm_scaling[idx]);
+
+            ins_loadPlanes(xmm_vector, kPose.Translation, idxFirst, laneCount);
+            for(unsigned long idx = 0; idx < 3; ++idx)
+                xmm_translation[idx] = DirectX::XMVectorMultiplyAdd(xmm_vector[idx], xmm_weight, xmm_translation[idx]);
+
+            ins_loadPlanes(xmm_quaternion, kPose.Rotation, idxFirst, laneCount);
+            xmm_weight = DirectX::XMVectorSelect(xmm_weight, DirectX::XMVectorNegate(xmm_weight), DirectX::XMVectorLess(ins_dotLanes(xmm_quaternion, xmm_firstRotation), DirectX::g_XMZero));
+            for(unsigned long idx = 0; idx < 4; ++idx)
+                xmm_rotation[idx] = DirectX::XMVectorMultiplyAdd(xmm_quaternion[idx], xmm_weight, xmm_rotation[idx]);
+        }
+
+        const auto xmm_empty = DirectX::XMVectorLessOrEqual(DirectX::XMVectorAbs(xmm_weightSum), DirectX::XMVectorReplicate(FLT_EPSILON));
+        const auto xmm_weightInv = DirectX::XMVectorReciprocal(DirectX::XMVectorSelect(xmm_weightSum, DirectX::g_XMOne, xmm_empty));
+        for(unsigned long idx = 0; idx < 3; ++idx){
+            xmm_scaling[idx] = DirectX::XMVectorSelect(DirectX::XMVectorMultiply(xmm_scaling[idx], xmm_weightInv), xmm_firstScaling[idx], xmm_empty);
+            xmm_translation[idx] = DirectX::XMVectorSelect(DirectX::XMVectorMultiply(xmm_translation[idx], xmm_weightInv), xmm_firstTranslation[idx], xmm_empty);
+        }
+
+        // opposite rotations of same weight cancel out. the first pose is taken there as well
+        const auto xmm_cancelled = DirectX::XMVectorOrInt(xmm_empty, DirectX::XMVectorLessOrEqual(ins_dotLanes(xmm_rotation, xmm_rotation), DirectX::XMVectorReplicate(FLT_EPSILON * FLT_EPSILON)));
+        ins_normalizeLanes(xmm_rotation);
+        for(unsigned long idx = 0; idx < 4; ++idx)
+            xmm_rotation[idx] = DirectX::XMVectorSelect(xmm_rotation[idx], xmm_firstRotation[idx], xmm_cancelled);
+
+        ins_storeLanes(pose.Scaling, xmm_scaling, idxFirst, laneCount);
+        ins_storeLanes(pose.Rotation, xmm_rotation, idxFirst, laneCount);
+        ins_storeLanes(pose.Translation, xmm_translation, idxFirst, laneCount);
+    }
+}
+
+// additive pose is of SHRMakeAdditiveAnimation. scaling multiplies, rotation is applied in parent space of the base, and translation adds.
+// weight scales the delta from identity, and rotation deltas are blended from identity on its hemisphere
+void SHRApplyAdditivePose(const FBXAnimationPose& pose, const FBXAnimationPose& basePose, const FBXAnimationPose& additivePose, float weight, const float* pMask, unsigned long nodeCount){
+    for(unsigned long idxFirst = 0; idxFirst < nodeCount; idxFirst += ins_poseLaneCount){
+        const auto laneCount = std::min<unsigned long>(ins_poseLaneCount, nodeCount - idxFirst);
+
+        const auto xmm_weight = DirectX::XMVectorMultiply(DirectX::XMVectorReplicate(weight), ins_loadMask(pMask, idxFirst, laneCount));
+        const auto xmm_weightInv = DirectX::XMVectorSubtract(DirectX::g_XMOne, xmm_weight);
+
+        DirectX::XMVECTOR xmm_baseVector[3], xmm_deltaVector[3];
+
+        ins_loadPlanes(xmm_baseVector, basePose.Scaling, idxFirst, laneCount);
+        ins_loadPlanes(xmm_deltaVector, additivePose.Scaling, idxFirst, laneCount);
+        for(unsigned long idx = 0; idx < 3; ++idx)
+            xmm_baseVector[idx] = DirectX::XMVectorMultiply(xmm_baseVector[idx], DirectX::XMVectorMultiplyAdd(xmm_deltaVector[idx], xmm_weight, xmm_weightInv));
+        ins_storeLanes(pose.Scaling, xmm_baseVector, idxFirst, laneCount);
+
+        ins_loadPlanes(xmm_baseVector, basePose.Translation, idxFirst, laneCount);
+        ins_loadPlanes(xmm_deltaVector, additivePose.Translation, idxFirst, laneCount);
+        for(unsigned long idx = 0; idx < 3; ++idx)
+            xmm_baseVector[idx] = DirectX::XMVectorMultiplyAdd(xmm_deltaVector[idx], xmm_weight, xmm_baseVector[idx]);
+        ins_storeLanes(pose.Translation, xmm_baseVector, idxFirst, laneCount);
+
+        DirectX::XMVECTOR xmm_base[4], xmm_delta[4];
+        ins_loadPlanes(xmm_base, basePose.Rotation, idxFirst, laneCount);
+        ins_loadPlanes(xmm_delta, additivePose.Rotation, idxFirst, laneCount);
+        {
+            // identity is (0, 0, 0, 1), so the hemisphere is the sign of w
+            const auto xmm_scale = DirectX::XMVectorSelect(xmm_weight, DirectX::XMVectorNegate(xmm_weight), DirectX::XMVectorLess(xmm_delta[3], DirectX::g_XMZero));
+            for(unsigned long idx = 0; idx < 3; ++idx)
+                xmm_delta[idx] = DirectX::XMVectorMultiply(xmm_delta[idx], xmm_scale);
+            xmm_delta[3] = DirectX::XMVectorMultiplyAdd(xmm_delta[3], xmm_scale, xmm_weightInv);
+            ins_normalizeLanes(xmm_delta);
+        }
+
+        DirectX::XMVECTOR xmm_rotation[4];
+        ins_multiplyQuaternionLanes(xmm_rotation, xmm_base, xmm_delta);
+
+        ins_storeLanes(pose.Rotation, xmm_rotation, idxFirst, laneCount);
+    }
+}
+
+
+void SHRBuildAnimationPoseLinks(const FBXAnimation* pAnimation, FBXAnimationPoseLink* pOutLinks){
+    const auto nodeCount = (unsigned long)pAnimation->AnimationNodes.Length;
+    const auto* pNodes = pAnimation->AnimationNodes.Values;
+
+    fbx_unordered_map<const FBXNode*, unsigned long, PointerHasher<const FBXNode*>> nodeIndices;
+    nodeIndices.rehash(nodeCount << 1);
+    for(unsigned long idxNode = 0; idxNode < nodeCount; ++idxNode){
+        if(pNodes[idxNode].BindNode)
+            nodeIndices.emplace(pNodes[idxNode].BindNode, idxNode);
+    }
+
+    fbx_vector<unsigned long> depths(nodeCount);
+    for(unsigned long idxNode = 0; idxNode < nodeCount; ++idxNode){
+        auto& cLink = pOutLinks[idxNode];
+        cLink.Node = idxNode;
+        cLink.Parent = nodeCount;
+
+        auto xmm4_offset = DirectX::XMMatrixIdentity();
+        if(pNodes[idxNode].BindNode){
+            for(const auto* pParent = pNodes[idxNode].BindNode->Parent; pParent; pParent = pParent->Parent){
+                auto f = nodeIndices.find(pParent);
+                if(f != nodeIndices.end()){
+                    cLink.Parent = f->second;
+                    break;
+                }
+
+                auto xmm4_tmp = DirectX::XMLoadFloat4x4((const DirectX::XMFLOAT4X4*)pParent->TransformMatrix.Values);
+                xmm4_offset = DirectX::XMMatrixMultiply(xmm4_offset, xmm4_tmp);
+            }
+        }
+
+        DirectX::XMVECTOR xmm_scale, xmm_rotation, xmm_translation;
+        DecomposeTransform(&xmm_scale, &xmm_rotation, &xmm_translation, xmm4_offset);
+        DirectX::XMStoreFloat3((DirectX::XMFLOAT3*)cLink.OffsetScaling.Values, xmm_scale);
+        DirectX::XMStoreFloat4((DirectX::XMFLOAT4*)cLink.OffsetRotation.Values, xmm_rotation);
+        DirectX::XMStoreFloat3((DirectX::XMFLOAT3*)cLink.OffsetTranslation.Values, xmm_translation);
+    }
+    for(unsigned long idxNode = 0; idxNode < nodeCount; ++idxNode){
+        for(auto idxParent = pOutLinks[idxNode].Parent; idxParent < nodeCount; idxParent = pOutLinks[idxParent].Parent)
+            ++depths[idxNode];
+    }
+
+    std::stable_sort(pOutLinks, pOutLinks + nodeCount, [&depths](const FBXAnimationPoseLink& lhs, const FBXAnimationPoseLink& rhs){
+        return depths[lhs.Node] < depths[rhs.Node];
+    });
+}
+
+// links read by one step must not depend on each other. links are sorted by depth, so a step only stops early where the depth changes
+static inline unsigned long ins_countIndependentLinks(const FBXAnimationPoseLink* pLinks, unsigned long count){
+    for(unsigned long idxLink = 1; idxLink < count; ++idxLink){
+        for(unsigned long idxPrev = 0; idxPrev < idxLink; ++idxPrev){
+            if(pLinks[idxLink].Parent == pLinks[idxPrev].Node)
+                return idxLink;
+        }
+    }
+    return count;
+}
+
+// lanes whose index is not less than invalid, and tail lanes, take identity
+template<unsigned long N>
+static inline void ins_gatherPlanes(DirectX::XMVECTOR (&values)[N], float* const (&planes)[N], const unsigned long* indices, unsigned long count, unsigned long invalid, const float (&identity)[N]){
+    for(unsigned long idx = 0; idx < N; ++idx){
+        DirectX::XMFLOAT4A tmp(identity[idx], identity[idx], identity[idx], identity[idx]);
+        for(unsigned long lane = 0; lane < count; ++lane){
+            if(indices[lane] < invalid)
+                (&tmp.x)[lane] = planes[idx][indices[lane]];
+        }
+        values[idx] = DirectX::XMLoadFloat4A(&tmp);
+    }
+}
+template<unsigned long N>
+static inline void ins_gatherOffsets(DirectX::XMVECTOR (&values)[N], const FBXAnimationPoseLink* pLinks, const FBXStaticArray<float, N> FBXAnimationPoseLink::* pOffset, unsigned long count, const float (&identity)[N]){
+    for(unsigned long idx = 0; idx < N; ++idx){
+        DirectX::XMFLOAT4A tmp(identity[idx], identity[idx], identity[idx], identity[idx]);
+        for(unsigned long lane = 0; lane < count; ++lane)
+            (&tmp.x)[lane] = (pLinks[lane].*pOffset).Values[idx];
+        values[idx] = DirectX::XMLoadFloat4A(&tmp);
+    }
+}
+template<unsigned long N>
+static inline void ins_scatterPlanes(float* const (&planes)[N], const DirectX::XMVECTOR (&values)[N], const unsigned long* indices, unsigned long count){
+    DirectX::XMFLOAT4A tmp;
+    for(unsigned long idx = 0; idx < N; ++idx){
+        DirectX::XMStoreFloat4A(&tmp, values[idx]);
+        for(unsigned long lane = 0; lane < count; ++lane)
+            planes[idx][indices[lane]] = (&tmp.x)[lane];
+    }
+}
+
+// local transform of the lanes is put under the parent transform of the lanes, as scale, rotation and translation each
+static inline void ins_concatenateLanes(
+    DirectX::XMVECTOR (&scaling)[3],
+    DirectX::XMVECTOR (&rotation)[4],
+    DirectX::XMVECTOR (&translation)[3],
+    const DirectX::XMVECTOR (&parentScaling)[3],
+    const DirectX::XMVECTOR (&parentRotation)[4],
+    const DirectX::XMVECTOR (&parentTranslation)[3]
+){
+    for(unsigned long idx = 0; idx < 3; ++idx){
+        scaling[idx] = DirectX::XMVectorMultiply(scaling[idx], parentScaling[idx]);
+        translation[idx] = DirectX::XMVectorMultiply(translation[idx], parentScaling[idx]);
+    }
+
+    // v + w * t + q x t, where t = 2 * (q x v)
+    {
+        auto cross = [](DirectX::XMVECTOR (&out)[3], const DirectX::XMVECTOR* lhs, const DirectX::XMVECTOR* rhs){
+            out[0] = DirectX::XMVectorNegativeMultiplySubtract(lhs[2], rhs[1], DirectX::XMVectorMultiply(lhs[1], rhs[2]));
+            out[1] = DirectX::XMVectorNegativeMultiplySubtract(lhs[0], rhs[2], DirectX::XMVectorMultiply(lhs[2], rhs[0]));
+            out[2] = DirectX::XMVectorNegativeMultiplySubtract(lhs[1], rhs[0], DirectX::XMVectorMultiply(lhs[0], rhs[1]));
+        };
+
+        DirectX::XMVECTOR xmm_twice[3], xmm_cross[3];
+        cross(xmm_twice, parentRotation, translation);
+        for(unsigned long idx = 0; idx < 3; ++idx)
+            xmm_twice[idx] = DirectX::XMVectorAdd(xmm_twice[idx], xmm_twice[idx]);
+        cross(xmm_cross, parentRotation, xmm_twice);
+
+        for(unsigned long idx = 0; idx < 3; ++idx){
+            translation[idx] = DirectX::XMVectorMultiplyAdd(parentRotation[3], xmm_twice[idx], translation[idx]);
+            translation[idx] = DirectX::XMVectorAdd(DirectX::XMVectorAdd(translation[idx], xmm_cross[idx]), parentTranslation[idx]);
+        }
+    }
+
+    DirectX::XMVECTOR xmm_rotation[4];
+    ins_multiplyQuaternionLanes(xmm_rotation, rotation, parentRotation);
+    for(unsigned long idx = 0; idx < 4; ++idx)
+        rotation[idx] = xmm_rotation[idx];
+}
+
+// transforms are concatenated as scale, rotation and translation each, which is exact unless a non-uniform scale meets a rotation below it.
+// links run parents first, so the output may be the local pose itself. four links are converted per step, as long as none of them is the parent of another
+void SHRConvertPoseToWorld(const FBXAnimationPose& pose, const FBXAnimationPose& localPose, const FBXAnimationPoseLink* pLinks, unsigned long nodeCount){
+    static const float identityScaling[3] = { 1.f, 1.f, 1.f };
+    static const float identityRotation[4] = { 0.f, 0.f, 0.f, 1.f };
+    static const float identityTranslation[3] = { 0.f, 0.f, 0.f };
+
+    for(unsigned long idxFirst = 0; idxFirst < nodeCount;){
+        const auto* pFirst = pLinks + idxFirst;
+        const auto laneCount = ins_countIndependentLinks(pFirst, std::min<unsigned long>(ins_poseLaneCount, nodeCount - idxFirst));
+
+        unsigned long nodes[ins_poseLaneCount], parents[ins_poseLaneCount];
+        for(unsigned long lane = 0; lane < laneCount; ++lane){
+            nodes[lane] = pFirst[lane].Node;
+            parents[lane] = pFirst[lane].Parent;
+        }
+
+        DirectX::XMVECTOR xmm_scaling[3], xmm_rotation[4], xmm_translation[3];
+        ins_gatherPlanes(xmm_scaling, localPose.Scaling, nodes, laneCount, nodeCount, identityScaling);
+        ins_gatherPlanes(xmm_rotation, localPose.Rotation, nodes, laneCount, nodeCount, identityRotation);
+        ins_gatherPlanes(xmm_translation, localPose.Translation, nodes, laneCount, nodeCount, identityTranslation);
+
+        DirectX::XMVECTOR xmm_parentScaling[3], xmm_parentRotation[4], xmm_parentTranslation[3];
+        ins_gatherOffsets(xmm_parentScaling, pFirst, &FBXAnimationPoseLink::OffsetScaling, laneCount, identityScaling);
+        ins_gatherOffsets(xmm_parentRotation, pFirst, &FBXAnimationPoseLink::OffsetRotation, laneCount, identityRotation);
+        ins_gatherOffsets(xmm_parentTranslation, pFirst, &FBXAnimationPoseLink::OffsetTranslation, laneCount, identityTranslation);
+        ins_concatenateLanes(xmm_scaling, xmm_rotation, xmm_translation, xmm_parentScaling, xmm_parentRotation, xmm_parentTranslation);
+
+        // lanes without an animated ancestor are put under identity, which leaves them as they are
+        ins_gatherPlanes(xmm_parentScaling, pose.Scaling, parents, laneCount, nodeCount, identityScaling);
+        ins_gatherPlanes(xmm_parentRotation, pose.Rotation, parents, laneCount, nodeCount, identityRotation);
+        ins_gatherPlanes(xmm_parentTranslation, pose.Translation, parents, laneCount, nodeCount, identityTranslation);
+        ins_concatenateLanes(xmm_scaling, xmm_rotation, xmm_translation, xmm_parentScaling, xmm_parentRotation, xmm_parentTranslation);
+
+        ins_scatterPlanes(pose.Scaling, xmm_scaling, nodes, laneCount);
+        ins_scatterPlanes(pose.Rotation, xmm_rotation, nodes, laneCount);
+        ins_scatterPlanes(pose.Translation, xmm_translation, nodes, laneCount);
+
+        idxFirst += laneCount;
+    }
+}
+
+
+// nodes of a tree are baked in preorder, which puts every parent before its children
+class _BakeNode{
+public:
+    const FBXNode* node;
+    unsigned long parent; // slot of the parent. ins_noParent for nodes on the top level
+    unsigned long animationNode; // index in AnimationNodes. ins_noParent if the node is not animated
+};
+
+static const unsigned long ins_noParent = ~0ul;
+
+static void ins_flattenNodes(fbx_vector<_BakeNode>& nodes, const FBXNode* pRootNode){
+    fbx_vector<std::pair<const FBXNode*, unsigned long>> nodeStack;
+    if(pRootNode)
+        nodeStack.emplace_back(pRootNode, ins_noParent);
+
+    while(!nodeStack.empty()){
+        const auto [pNode, idxParent] = nodeStack.back();
+        nodeStack.pop_back();
+
+        const auto idxSlot = (unsigned long)nodes.size();
+        nodes.emplace_back(_BakeNode{ pNode, idxParent, ins_noParent });
+
+        // child is popped first, and the sibling after the whole subtree of the child
+        if(pNode->Sibling)
+            nodeStack.emplace_back(pNode->Sibling, idxParent);
+        if(pNode->Child)
+            nodeStack.emplace_back(pNode->Child, idxSlot);
+    }
+}
+
+// samples local transforms of the animation at once, and makes matrices of animated nodes. the others keep their TransformMatrix
+static void ins_bakeLocalMatrices(fbx_vector<_BakeNode>& nodes, fbx_vector<DirectX::XMFLOAT4X4>& localMatrices, const FBXAnimation* pAnimation, float time){
+    localMatrices.resize(nodes.size());
+    for(size_t idxSlot = 0u; idxSlot < nodes.size(); ++idxSlot)
+        CopyArrayData<16>(&localMatrices[idxSlot]._11, nodes[idxSlot].node->TransformMatrix.Values);
+
+    if(!pAnimation || !pAnimation->AnimationNodes.Length)
+        return;
+
+    const auto nodeCount = (unsigned long)pAnimation->AnimationNodes.Length;
+    {
+        fbx_unordered_map<const FBXNode*, unsigned long, PointerHasher<const FBXNode*>> slotFinder;
+        slotFinder.rehash(nodes.size() << 1);
+        for(size_t idxSlot = 0u; idxSlot < nodes.size(); ++idxSlot)
+            slotFinder.emplace(nodes[idxSlot].node, (unsigned long)idxSlot);
+
+        for(unsigned long idxNode = 0; idxNode < nodeCount; ++idxNode){
+            auto f = slotFinder.find(pAnimation->AnimationNodes.Values[idxNode].BindNode);
+            if(f != slotFinder.end())
+                nodes[f->second].animationNode = idxNode;
+        }
+    }
+
+    fbx_vector<float> planes(size_t(nodeCount) * 10u);
+    FBXAnimationPose pose;
+    for(unsigned long idx = 0; idx < 3; ++idx){
+        pose.Scaling[idx] = planes.data() + size_t(nodeCount) * idx;
+        pose.Translation[idx] = planes.data() + size_t(nodeCount) * (idx + 7);
+    }
+    for(unsigned long idx = 0; idx < 4; ++idx)
+        pose.Rotation[idx] = planes.data() + size_t(nodeCount) * (idx + 3);
+
+    SHRSampleAnimationPose(pAnimation, time, false, nullptr, pose);
+
+    for(size_t idxSlot = 0u; idxSlot < nodes.size(); ++idxSlot){
+        const auto idxNode = nodes[idxSlot].animationNode;
+        if(idxNode == ins_noParent)
+            continue;
+
+        const auto xmm_scale = DirectX::XMVectorSet(pose.Scaling[0][idxNode], pose.Scaling[1][idxNode], pose.Scaling[2][idxNode], 0.f);
+        const auto xmm_rotation = DirectX::XMVectorSet(pose.Rotation[0][idxNode], pose.Rotation[1][idxNode], pose.Rotation[2][idxNode], pose.Rotation[3][idxNode]);
+        const auto xmm_translation = DirectX::XMVectorSet(pose.Translation[0][idxNode], pose.Translation[1][idxNode], pose.Translation[2][idxNode], 0.f);
+
+        DirectX::XMStoreFloat4x4(&localMatrices[idxSlot], DirectX::XMMatrixAffineTransformation(xmm_scale, DirectX::XMVectorZero(), xmm_rotation, xmm_translation));
+    }
+}
+
+// out = lhs * rhs of row major 4x4 matrices. out must be neither of them
+static inline void ins_multiplyMatrix(double* pOut, const double* pLhs, const double* pRhs){
+#ifdef _SIMD_AVX
+    const auto xmm_row0 = _mm256_loadu_pd(pRhs);
+    const auto xmm_row1 = _mm256_loadu_pd(pRhs + 4);
+    const auto xmm_row2 = _mm256_loadu_pd(pRhs + 8);
+    const auto xmm_row3 = _mm256_loadu_pd(pRhs + 12);
+
+    for(int i = 0; i < 4; ++i){
+        const auto* pRow = pLhs + (i << 2);
+
+#ifdef _SIMD_FMA
+        auto xmm_ret = _mm256_mul_pd(_mm256_broadcast_sd(pRow), xmm_row0);
+        xmm_ret = _mm256_fmadd_pd(_mm256_broadcast_sd(pRow + 1), xmm_row1, xmm_ret);
+        xmm_ret = _mm256_fmadd_pd(_mm256_broadcast_sd(pRow + 2), xmm_row2, xmm_ret);
+        xmm_ret = _mm256_fmadd_pd(_mm256_broadcast_sd(pRow + 3), xmm_row3, xmm_ret);
+#else
+        auto xmm_ret = _mm256_mul_pd(_mm256_broadcast_sd(pRow), xmm_row0);
+        xmm_ret = _mm256_add_pd(xmm_ret, _mm256_mul_pd(_mm256_broadcast_sd(pRow + 1), xmm_row1));
+        xmm_ret = _mm256_add_pd(xmm_ret, _mm256_mul_pd(_mm256_broadcast_sd(pRow + 2), xmm_row2));
+        xmm_ret = _mm256_add_pd(xmm_ret, _mm256_mul_pd(_mm256_broadcast_sd(pRow + 3), xmm_row3));
+#endif
+
+        _mm256_storeu_pd(pOut + (i << 2), xmm_ret);
+    }
+#else
+    for(int i = 0; i < 4; ++i){
+        const auto* pRow = pLhs + (i << 2);
+
+        auto xmm_xy = _mm_setzero_pd();
+        auto xmm_zw = _mm_setzero_pd();
+        for(int k = 0; k < 4; ++k){
+            const auto xmm_factor = _mm_set1_pd(pRow[k]);
+
+            xmm_xy = _mm_add_pd(xmm_xy, _mm_mul_pd(xmm_factor, _mm_loadu_pd(pRhs + (k << 2))));
+            xmm_zw = _mm_add_pd(xmm_zw, _mm_mul_pd(xmm_factor, _mm_loadu_pd(pRhs + (k << 2) + 2)));
+        }
+
+        _mm_storeu_pd(pOut + (i << 2), xmm_xy);
+        _mm_storeu_pd(pOut + (i << 2) + 2, xmm_zw);
+    }
+#endif
+}
+
+
+unsigned long SHRCollectNodes(const FBXNode* pRootNode, const FBXNode** pOutNodes){
+    fbx_vector<_BakeNode> nodes;
+    ins_flattenNodes(nodes, pRootNode);
+
+    if(pOutNodes){
+        for(size_t idxSlot = 0u; idxSlot < nodes.size(); ++idxSlot)
+            pOutNodes[idxSlot] = nodes[idxSlot].node;
+    }
+
+    return (unsigned long)nodes.size();
+}
+
+// one pass over the preorder. each node multiplies its local matrix by the world matrix already written for its parent
+void SHRBakeWorldMatrices(float* pOutMatrices, const FBXNode* pRootNode, const FBXAnimation* pAnimation, float time){
+    fbx_vector<_BakeNode> nodes;
+    ins_flattenNodes(nodes, pRootNode);
+
+    fbx_vector<DirectX::XMFLOAT4X4> localMatrices;
+    ins_bakeLocalMatrices(nodes, localMatrices, pAnimation, time);
+
+    auto* pOut = reinterpret_cast<DirectX::XMFLOAT4X4*>(pOutMatrices);
+    for(size_t idxSlot = 0u; idxSlot < nodes.size(); ++idxSlot){
+        const auto idxParent = nodes[idxSlot].parent;
+        if(idxParent == ins_noParent){
+            pOut[idxSlot] = localMatrices[idxSlot];
+            continue;
+        }
+
+        const auto xmm4_local = DirectX::XMLoadFloat4x4(&localMatrices[idxSlot]);
+        const auto xmm4_parent = DirectX::XMLoadFloat4x4(&pOut[idxParent]);
+        DirectX::XMStoreFloat4x4(&pOut[idxSlot], DirectX::XMMatrixMultiply(xmm4_local, xmm4_parent));
+    }
+}
+// same as of float, but the chain is accumulated in double so deep hierarchies don't drift
+void SHRBakeWorldMatrices(double* pOutMatrices, const FBXNode* pRootNode, const FBXAnimation* pAnimation, float time){
+    fbx_vector<_BakeNode> nodes;
+    ins_flattenNodes(nodes, pRootNode);
+
+    fbx_vector<DirectX::XMFLOAT4X4> localMatrices;
+    ins_bakeLocalMatrices(nodes, localMatrices, pAnimation, time);
+
+    for(size_t idxSlot = 0u; idxSlot < nodes.size(); ++idxSlot){
+        auto* pOut = pOutMatrices + (idxSlot << 4);
+
+        const auto idxParent = nodes[idxSlot].parent;
+        if(idxParent == ins_noParent){
+            CopyArrayData<16>(pOut, &localMatrices[idxSlot]._11);
+            continue;
+        }
+
+        double local[16];
+        CopyArrayData<16>((double*)local, &localMatrices[idxSlot]._11);
+        ins_multiplyMatrix(pOut, local, pOutMatrices + (size_t(idxParent) << 4));
+    }
+}
@@ -8,14 +8,24 @@
 #include "stdafx.h"
 
 #include <map>
+#include <limits>
+#include <cmath>
+#include <execution>
 
 #include "FBXUtilites.h"
 #include "FBXMath.h"
 #include "FBXShared.h"
 
 
+// the number of poses sampled evenly over each animation stack for influence limiting
+static const int ins_influenceSampleCountPerStack = 8;
+
+
 static fbx_vector<fbx_vector<unsigned int>> ins_newToOldIndexer;
 
+static fbx_vector<FbxAMatrix> ins_poseMatrices; // [sample][cluster] matrices moving a bind pose vertex to the sampled pose
+static size_t ins_poseSampleCount = 0u;
+
 
 FbxAMatrix SHRGetBlendMatrix(const SkinData* skins, size_t count){
     FbxAMatrix matOut;
@@ -30,6 +40,280 @@ FbxAMatrix SHRGetBlendMatrix(const SkinData* skins, size_t count){
     return matOut;
 }
 
+static void ins_samplePoses(FbxNode* kNode, const fbx_vector<FbxCluster*>& clusterFinder){
+    const auto clusterCount = clusterFinder.size();
+
+    fbx_vector<FbxAMatrix> bindMatrices(clusterCount);
+    for(size_t idxCluster = 0u; idxCluster < clusterCount; ++idxCluster){
+        auto* kCluster = clusterFinder[idxCluster];
+        if(!kCluster)
+            continue;
+
+        FbxAMatrix kMatNodeTM, kMatClusterTM;
+        kCluster->GetTransformMatrix(kMatNodeTM);
+        kCluster->GetTransformLinkMatrix(kMatClusterTM);
+
+        kMatClusterTM *= GetGeometry(kCluster->GetLink());
+
+        // vertex(pose) = link(pose) * link(bind)^-1 * mesh(bind) * vertex(bind)
+        bindMatrices[idxCluster] = kMatClusterTM.Inverse() * kMatNodeTM * GetGeometry(kNode);
+    }
+
+    ins_poseMatrices.clear();
+    ins_poseSampleCount = 0u;
+
+    auto appendSample = [&](const auto& getLinkMatrix){
+        for(size_t idxCluster = 0u; idxCluster < clusterCount; ++idxCluster){
+            auto* kCluster = clusterFinder[idxCluster];
+            if(kCluster)
+                ins_poseMatrices.emplace_back(getLinkMatrix(kCluster) * bindMatrices[idxCluster]);
+            else
+                ins_poseMatrices.emplace_back();
+        }
+        ++ins_poseSampleCount;
+    };
+
+    appendSample([](FbxCluster* kCluster){
+        FbxAMatrix kMatClusterTM;
+        kCluster->GetTransformLinkMatrix(kMatClusterTM);
+        return kMatClusterTM * GetGeometry(kCluster->GetLink());
+    });
+
+    auto* kScene = kNode->GetScene();
+    if(!kScene)
+        return;
+
+    auto* kDefaultAnimStack = kScene->GetCurrentAnimationStack();
+
+    for(auto edxAnimStack = kScene->GetSrcObjectCount<FbxAnimStack>(), idxAnimStack = 0; idxAnimStack < edxAnimStack; ++idxAnimStack){
+        auto* kAnimStack = kScene->GetSrcObject<FbxAnimStack>(idxAnimStack);
+        if(!kAnimStack)
+            continue;
+
+        kScene->SetCurrentAnimationStack(kAnimStack);
+
+        const auto kTimeSpan = kAnimStack->GetLocalTimeSpan();
+        const auto kStart = kTimeSpan.GetStart();
+        const auto kDuration = kTimeSpan.GetDuration();
+
+        for(int idxSample = 1; idxSample <= ins_influenceSampleCountPerStack; ++idxSample){
+            const auto kTime = kStart + FbxTime((kDuration.Get() * idxSample) / ins_influenceSampleCountPerStack);
+
+            appendSample([&kTime](FbxCluster* kCluster){
+                auto* kLink = kCluster->GetLink();
+                return kLink->EvaluateGlobalTransform(kTime) * GetGeometry(kLink);
+            });
+        }
+    }
+
+    kScene->SetCurrentAnimationStack(kDefaultAnimStack);
+}
+
+// solves min |sum(w_i * x_i) - y|^2 over every sampled pose with sum(w_i) = 1.
+// a weak pull to the given weights keeps the system solvable when the poses can't tell the bones apart
+static bool ins_solveInfluenceWeights(const fbx_vector<double>& gram, const fbx_vector<double>& cross, const fbx_vector<double>& prior, fbx_vector<double>& weights){
+    const auto count = prior.size();
+    const auto stride = count + 2u;
+
+    double trace = 0.;
+    for(size_t idx = 0u; idx < count; ++idx)
+        trace += gram[idx * count + idx];
+    const auto regularizer = (trace > 0. ? trace / double(count) : 1.) * 1e-6;
+
+    fbx_vector<double> system((count + 1u) * stride, 0.);
+    for(size_t idxRow = 0u; idxRow < count; ++idxRow){
+        auto* pRow = &system[idxRow * stride];
+
+        for(size_t idxCol = 0u; idxCol < count; ++idxCol)
+            pRow[idxCol] = gram[idxRow * count + idxCol];
+        pRow[idxRow] += regularizer;
+
+        pRow[count] = 1.;
+        pRow[count + 1u] = cross[idxRow] + regularizer * prior[idxRow];
+    }
+    {
+        auto* pRow = &system[count * stride];
+
+        for(size_t idxCol = 0u; idxCol < count; ++idxCol)
+            pRow[idxCol] = 1.;
+        pRow[count + 1u] = 1.;
+    }
+
+    for(size_t idxPivot = 0u; idxPivot <= count; ++idxPivot){
+        auto idxBest = idxPivot;
+        for(auto idxRow = idxPivot + 1u; idxRow <= count; ++idxRow){
+            if(std::abs(system[idxRow * stride + idxPivot]) > std::abs(system[idxBest * stride + idxPivot]))
+                idxBest = idxRow;
+        }
+        if(std::abs(system[idxBest * stride + idxPivot]) < 1e-300)
+            return false;
+        if(idxBest != idxPivot)
+            std::swap_ranges(system.begin() + idxPivot * stride, system.begin() + (idxPivot + 1u) * stride, system.begin() + idxBest * stride);
+
+        const auto* pPivot = &system[idxPivot * stride];
+        for(size_t idxRow = 0u; idxRow <= count; ++idxRow){
+            if(idxRow == idxPivot)
+                continue;
+
+            auto* pRow = &system[idxRow * stride];
+            const auto factor = pRow[idxPivot] / pPivot[idxPivot];
+            if(!factor)
+                continue;
+
+            for(auto idxCol = idxPivot; idxCol < stride; ++idxCol)
+                pRow[idxCol] -= factor * pPivot[idxCol];
+        }
+    }
+
+    weights.resize(count);
+    for(size_t idx = 0u; idx < count; ++idx)
+        weights[idx] = system[idx * stride + count + 1u] / system[idx * stride + idx];
+
+    return true;
+}
+
+// backward elimination. the influence whose removal costs the least error over the sampled poses is dropped until the limit is met,
+// and the remaining weights are solved again each time instead of being scaled
+static void ins_limitInfluences(const FbxVector4& kPosition, fbx_vector<std::pair<unsigned int, double>>& influences, size_t maxInfluence){
+    const auto sampleCount = ins_poseSampleCount;
+    const auto clusterCount = ins_poseMatrices.size() / sampleCount;
+
+    const auto allCount = influences.size();
+
+    // positions each influence alone would give, and the positions every influence together gives
+    fbx_vector<FbxVector4> allPositions(allCount * sampleCount);
+    fbx_vector<FbxVector4> targets(sampleCount, FbxVector4(0., 0., 0., 0.));
+    for(size_t idxSample = 0u; idxSample < sampleCount; ++idxSample){
+        for(size_t idxInf = 0u; idxInf < allCount; ++idxInf){
+            const auto& iInf = influences[idxInf];
+
+            auto& kPos = allPositions[idxInf * sampleCount + idxSample];
+            kPos = ins_poseMatrices[idxSample * clusterCount + iInf.first].MultT(kPosition);
+
+            targets[idxSample] += kPos * iInf.second;
+        }
+    }
+
+    fbx_vector<size_t> kept(allCount);
+    for(size_t idx = 0u; idx < allCount; ++idx)
+        kept[idx] = idx;
+
+    fbx_vector<double> gram, cross, prior, weights, bestWeights;
+
+    // heaviest influences with their weights scaled to one, as the plain limit does. taken when nothing has to be dropped, or when no candidate
+    // gives a finite error, which happens on degenerate or near singular systems. influences are sorted heaviest first, and kept stays in that order
+    auto keepHeaviest = [&](){
+        kept.resize(std::min(kept.size(), maxInfluence));
+
+        double weightSum = 0.;
+        for(const auto& idx : kept)
+            weightSum += influences[idx].second;
+
+        bestWeights.resize(kept.size());
+        for(size_t idx = 0u; idx < kept.size(); ++idx)
+            bestWeights[idx] = weightSum > 0. ? influences[kept[idx]].second / weightSum : 1. / double(kept.size());
+    };
+    if(allCount <= maxInfluence)
+        keepHeaviest();
+    auto solve = [&](const fbx_vector<size_t>& subset, fbx_vector<double>& outWeights)->double{
+        const auto count = subset.size();
+
+        gram.assign(count * count, 0.);
+        cross.assign(count, 0.);
+        prior.resize(count);
+
+        double priorSum = 0.;
+        for(size_t idx = 0u; idx < count; ++idx)
+            priorSum += influences[subset[idx]].second;
+        for(size_t idx = 0u; idx < count; ++idx)
+            prior[idx] = priorSum > 0. ? influences[subset[idx]].second / priorSum : 1. / double(count);
+
+        for(size_t idxSample = 0u; idxSample < sampleCount; ++idxSample){
+            const auto& kTarget = targets[idxSample];
+
+            for(size_t idxRow = 0u; idxRow < count; ++idxRow){
+                const auto& kRow = allPositions[subset[idxRow] * sampleCount + idxSample];
+
+                cross[idxRow] += kRow[0] * kTarget[0] + kRow[1] * kTarget[1] + kRow[2] * kTarget[2];
+                for(size_t idxCol = idxRow; idxCol < count; ++idxCol){
+                    const auto& kCol = allPositions[subset[idxCol] * sampleCount + idxSample];
+                    gram[idxRow * count + idxCol] += kRow[0] * kCol[0] + kRow[1] * kCol[1] + kRow[2] * kCol[2];
+                }
+            }
+        }
+        for(size_t idxRow = 0u; idxRow < count; ++idxRow){
+            for(size_t idxCol = 0u; idxCol < idxRow; ++idxCol)
+                gram[idxRow * count + idxCol] = gram[idxCol * count + idxRow];
+        }
+
+        if(!ins_solveInfluenceWeights(gram, cross, prior, outWeights))
+            outWeights = prior;
+
+        // negative weights are clamped, then the rest is scaled back to one
+        double weightSum = 0.;
+        for(auto& w : outWeights){
+            if(w < 0.)
+                w = 0.;
+            weightSum += w;
+        }
+        if(weightSum > 0.){
+            for(auto& w : outWeights)
+                w /= weightSum;
+        }
+        else
+            outWeights = prior;
+
+        double error = 0.;
+        for(size_t idxSample = 0u; idxSample < sampleCount; ++idxSample){
+            FbxVector4 kDiff = targets[idxSample];
+            for(size_t idx = 0u; idx < count; ++idx)
+                kDiff -= allPositions[subset[idx] * sampleCount + idxSample] * outWeights[idx];
+
+            error += kDiff[0] * kDiff[0] + kDiff[1] * kDiff[1] + kDiff[2] * kDiff[2];
+        }
+        return error;
+    };
+
+    fbx_vector<size_t> subset;
+    while(kept.size() > maxInfluence){
+        auto bestError = std::numeric_limits<double>::infinity();
+        auto bestDrop = kept.size();
+
+        for(size_t idxDrop = 0u; idxDrop < kept.size(); ++idxDrop){
+            subset.clear();
+            for(size_t idx = 0u; idx < kept.size(); ++idx){
+                if(idx != idxDrop)
+                    subset.emplace_back(kept[idx]);
+            }
+
+            const auto error = solve(subset, weights);
+            if(!std::isfinite(error))
+                continue;
+
+            if(error < bestError){
+                bestError = error;
+                bestDrop = idxDrop;
+                std::swap(bestWeights, weights);
+            }
+        }
+
+        if(bestDrop == kept.size()){
+            keepHeaviest();
+            break;
+        }
+
+        kept.erase(kept.begin() + bestDrop);
+    }
+
+    fbx_vector<std::pair<unsigned int, double>> result;
+    result.reserve(kept.size());
+    for(size_t idx = 0u; idx < kept.size(); ++idx){
+        if(bestWeights[idx] > 0.)
+            result.emplace_back(influences[kept[idx]].first, bestWeights[idx]);
+    }
+    std::swap(influences, result);
+}
+
 bool SHRLoadSkinFromNode(const ControlPointRemap& controlPointRemap, FbxNode* kNode, NodeData* pNodeData){
     static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("SHRLoadSkinFromNode(const ControlPointRemap&, FbxNode*, NodeData*)");
 
@@ -162,49 +446,85 @@ bool SHRLoadSkinFromNode(const ControlPointRemap& controlPointRemap, FbxNode* kN
         }
     }
 
+    const bool bMinimizeError = shr_ioSetting.MinimizeInfluenceError;
+    if(bMinimizeError)
+        ins_samplePoses(kNode, clusterFinder);
+
+    // without pruning or error minimizing, weights are stored as read and only the lightest influences are dropped, as they always were
+    const bool bReweight = bMinimizeError || (shr_ioSetting.SkinWeightPruneEpsilon > 0.);
+
+    fbx_vector<std::pair<unsigned int, double>> influences;
     for(auto edxVert = (unsigned int)vertexBoneList.size(), idxVert = 0u; idxVert < edxVert; ++idxVert){
-        auto& weightBoneMap = vertexBoneList[idxVert];
+        const auto& weightBoneMap = vertexBoneList[idxVert];
 
-        // remove too many participated clusters
-        while(weightBoneMap.size() > shr_ioSetting.MaxParticipateClusterPerVertex){
-            auto itrBone = weightBoneMap.begin();
-            auto& vertexBoneWeightMap = boneMapList[itrBone->second];
-            auto itrVertBone = vertexBoneWeightMap.find(idxVert);
+        if(!bReweight){
+            auto itrFirst = weightBoneMap.cbegin();
+            for(auto cntBone = weightBoneMap.size(); cntBone > shr_ioSetting.MaxParticipateClusterPerVertex; --cntBone)
+                ++itrFirst;
+
+            double totalWeight = 0.;
+            for(auto itrBone = itrFirst; itrBone != weightBoneMap.cend(); ++itrBone)
+                totalWeight += itrBone->first;
 
-            weightBoneMap.erase(itrBone);
+            if(!totalWeight)
+                continue;
 
-            if(itrVertBone != vertexBoneWeightMap.end())
-                vertexBoneWeightMap.erase(itrVertBone);
+            for(auto itrBone = itrFirst; itrBone != weightBoneMap.cend(); ++itrBone){
+                auto* curCluster = clusterFinder[itrBone->second];
+                if(!curCluster)
+                    continue;
+
+                SkinInfo _emplace = { curCluster, itrBone->first };
+                skinTable[idxVert].emplace_back(std::move(_emplace));
+            }
+            continue;
+        }
+
+        influences.clear();
+        for(auto itrBone = weightBoneMap.crbegin(); itrBone != weightBoneMap.crend(); ++itrBone){
+            if(clusterFinder[itrBone->second])
+                influences.emplace_back(itrBone->second, itrBone->first);
         }
 
         double totalWeight = 0.;
-        { // normalize
-            for(const auto& i : weightBoneMap)
-                totalWeight += i.first;
+        for(const auto& i : influences)
+            totalWeight += i.second;
 
-            if(totalWeight > 0){
-                for(auto& iWeightBone : weightBoneMap){
-                    auto& vertexBoneWeightMap = boneMapList[iWeightBone.second];
-                    auto itrVertBone = vertexBoneWeightMap.find(idxVert);
+        if(!(totalWeight > 0.))
+            continue;
 
-                    itrVertBone->second /= totalWeight;
-                }
+        // negligible weights go first, so they don't take a palette slot. the heaviest one always stays
+        if(shr_ioSetting.SkinWeightPruneEpsilon > 0.){
+            const auto threshold = shr_ioSetting.SkinWeightPruneEpsilon * totalWeight;
+            while((influences.size() > 1u) && (influences.back().second < threshold)){
+                totalWeight -= influences.back().second;
+                influences.pop_back();
             }
         }
 
-        if(!totalWeight)
-            continue;
+        // remove too many participated clusters
+        if(influences.size() > shr_ioSetting.MaxParticipateClusterPerVertex){
+            if(bMinimizeError){
+                ins_limitInfluences(FbxVector4(pNodeData->bufPositions[idxVert]), influences, shr_ioSetting.MaxParticipateClusterPerVertex);
 
-        for(auto& iWeightBone : weightBoneMap){
-            auto* curCluster = clusterFinder[iWeightBone.second];
-            if(!curCluster)
-                continue;
-            
-            {
-                SkinInfo _emplace = { curCluster, iWeightBone.first };
-                skinTable[idxVert].emplace_back(std::move(_emplace));
+                totalWeight = 0.;
+                for(const auto& i : influences)
+                    totalWeight += i.second;
+            }
+            else{
+                while(influences.size() > shr_ioSetting.MaxParticipateClusterPerVertex){
+                    totalWeight -= influences.back().second;
+                    influences.pop_back();
+                }
             }
         }
+
+        for(auto itrInfluence = influences.crbegin(); itrInfluence != influences.crend(); ++itrInfluence){
+            const auto& iInfluence = *itrInfluence;
+
+            SkinInfo _emplace = { clusterFinder[iInfluence.first], iInfluence.second / totalWeight };
+            skinTable[idxVert].emplace_back(std::move(_emplace));
+        }
     }
 
     for(auto* iCluster : clusterFinder){
@@ -460,3 +780,293 @@ bool SHRInitSkinData(FbxManager* kSDKManager, PoseNodeList& poseNodeList, const
 
     return true;
 }
+
+
+// row vector convention, as FBXNode::TransformMatrix. skin matrix = mesh(bind) * link(bind)^-1 * link(pose)
+class _SkinningPalette{
+public:
+    fbx_vector<DirectX::XMMATRIX> matrices;
+    fbx_unordered_map<const FBXNode*, unsigned int, PointerHasher<const FBXNode*>> finder;
+};
+class _DualQuaternion{
+public:
+    DirectX::XMVECTOR real;
+    DirectX::XMVECTOR dual;
+    DirectX::XMVECTOR scale;
+};
+class _SkinningTask{
+public:
+    size_t attribute;
+    size_t vertexFirst;
+    size_t vertexLast;
+};
+
+static const size_t ins_skinningVerticesPerTask = 4096;
+
+// hamilton product. XMQuaternionMultiply(q0, q1) is q1 * q0
+static inline DirectX::XMVECTOR XM_CALLCONV ins_multiplyQuaternion(DirectX::FXMVECTOR lhs, DirectX::FXMVECTOR rhs){
+    return DirectX::XMQuaternionMultiply(rhs, lhs);
+}
+
+static inline _DualQuaternion ins_makeDualQuaternion(DirectX::FXMMATRIX matSkin){
+    _DualQuaternion dq;
+
+    DirectX::XMVECTOR xmm_translation;
+    DirectX::XMMatrixDecompose(&dq.scale, &dq.real, &xmm_translation, matSkin);
+
+    dq.real = DirectX::XMQuaternionNormalize(dq.real);
+    xmm_translation = DirectX::XMVectorSelect(DirectX::g_XMZero, xmm_translation, DirectX::g_XMSelect1110);
+    dq.dual = DirectX::XMVectorScale(ins_multiplyQuaternion(xmm_translation, dq.real), 0.5f);
+
+    return dq;
+}
+
+template<FBXSkinningMode MODE>
+static void ins_skinVertices(
+    const FBXSkinnedMesh* pMesh,
+    const fbx_vector<DirectX::XMMATRIX>& skinMatrices,
+    const fbx_vector<_DualQuaternion>& skinDualQuaternions,
+    const _SkinningPalette& palette,
+    size_t vertexFirst,
+    size_t vertexLast,
+    const FBXStaticArray<float, 3>* pNormals,
+    FBXStaticArray<float, 3>* pOutPositions,
+    FBXStaticArray<float, 3>* pOutNormals,
+    bool& bFailed
+){
+    for(auto idxVert = vertexFirst; idxVert <= vertexLast; ++idxVert){
+        const auto& iSkin = pMesh->SkinInfos.Values[idxVert];
+
+        auto xmm_position = DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)pMesh->Vertices.Values[idxVert].Values);
+        auto xmm_normal = pNormals ? DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)pNormals[idxVert].Values) : DirectX::g_XMZero;
+
+        // vertices without any weight keep their bind pose, instead of collapsing to the origin
+        float weightSum = 0.f;
+
+        if(MODE == FBXSkinningMode::FBXSkinningMode_LinearBlend){
+            DirectX::XMMATRIX xmm4_blend;
+            xmm4_blend.r[0] = xmm4_blend.r[1] = xmm4_blend.r[2] = xmm4_blend.r[3] = DirectX::g_XMZero;
+
+            for(const auto* pWeight = iSkin.Values; FBX_PTRDIFFU(pWeight - iSkin.Values) < iSkin.Length; ++pWeight){
+                auto f = palette.finder.find(pWeight->BindNode);
+                if(f == palette.finder.cend()){
+                    bFailed = true;
+                    continue;
+                }
+
+                const auto& xmm4_skin = skinMatrices[f->second];
+                const auto xmm_weight = DirectX::XMVectorReplicate(pWeight->Weight);
+                weightSum += pWeight->Weight;
+
+                xmm4_blend.r[0] = DirectX::XMVectorMultiplyAdd(xmm4_skin.r[0], xmm_weight, xmm4_blend.r[0]);
+                xmm4_blend.r[1] = DirectX::XMVectorMultiplyAdd(xmm4_skin.r[1], xmm_weight, xmm4_blend.r[1]);
+                xmm4_blend.r[2] = DirectX::XMVectorMultiplyAdd(xmm4_skin.r[2], xmm_weight, xmm4_blend.r[2]);
+                xmm4_blend.r[3] = DirectX::XMVectorMultiplyAdd(xmm4_skin.r[3], xmm_weight, xmm4_blend.r[3]);
+            }
+
+            if(weightSum > 0.f){
+                xmm_position = DirectX::XMVector3Transform(xmm_position, xmm4_blend);
+                if(pNormals){
+                    // normals go through the inverse transpose, so they stay perpendicular under non-uniform scale and shear.
+                    // the cofactor matrix is the inverse transpose times the determinant, so only its sign is kept
+                    const auto xmm_cofactor0 = DirectX::XMVector3Cross(xmm4_blend.r[1], xmm4_blend.r[2]);
+                    const auto xmm_cofactor1 = DirectX::XMVector3Cross(xmm4_blend.r[2], xmm4_blend.r[0]);
+                    const auto xmm_cofactor2 = DirectX::XMVector3Cross(xmm4_blend.r[0], xmm4_blend.r[1]);
+
+                    auto xmm_skinned = DirectX::XMVectorMultiply(DirectX::XMVectorSplatX(xmm_normal), xmm_cofactor0);
+                    xmm_skinned = DirectX::XMVectorMultiplyAdd(DirectX::XMVectorSplatY(xmm_normal), xmm_cofactor1, xmm_skinned);
+                    xmm_skinned = DirectX::XMVectorMultiplyAdd(DirectX::XMVectorSplatZ(xmm_normal), xmm_cofactor2, xmm_skinned);
+                    if(DirectX::XMVectorGetX(DirectX::XMVector3Dot(xmm4_blend.r[0], xmm_cofactor0)) < 0.f)
+                        xmm_skinned = DirectX::XMVectorNegate(xmm_skinned);
+
+                    xmm_normal = DirectX::XMVector3Normalize(xmm_skinned);
+                }
+            }
+        }
+        else{
+            auto xmm_real = DirectX::g_XMZero.v;
+            auto xmm_dual = DirectX::g_XMZero.v;
+            auto xmm_scale = DirectX::g_XMZero.v;
+            auto xmm_pivot = DirectX::g_XMIdentityR3.v;
+            bool bFirst = true;
+
+            for(const auto* pWeight = iSkin.Values; FBX_PTRDIFFU(pWeight - iSkin.Values) < iSkin.Length; ++pWeight){
+                auto f = palette.finder.find(pWeight->BindNode);
+                if(f == palette.finder.cend()){
+                    bFailed = true;
+                    continue;
+                }
+
+                const auto& dq = skinDualQuaternions[f->second];
+                if(bFirst){
+                    xmm_pivot = dq.real;
+                    bFirst = false;
+                }
+
+                // antipodal rotations are flipped onto the same hemisphere as the first one
+                auto xmm_weight = DirectX::XMVectorReplicate(pWeight->Weight);
+                weightSum += pWeight->Weight;
+                xmm_scale = DirectX::XMVectorMultiplyAdd(dq.scale, xmm_weight, xmm_scale);
+                if(DirectX::XMVectorGetX(DirectX::XMVector4Dot(xmm_pivot, dq.real)) < 0.f)
+                    xmm_weight = DirectX::XMVectorNegate(xmm_weight);
+
+                xmm_real = DirectX::XMVectorMultiplyAdd(dq.real, xmm_weight, xmm_real);
+                xmm_dual = DirectX::XMVectorMultiplyAdd(dq.dual, xmm_weight, xmm_dual);
+            }
+
+            if(weightSum > 0.f){
+                const auto xmm_length = DirectX::XMVector4Length(xmm_real);
+                if(DirectX::XMVectorGetX(xmm_length) > 0.f){
+                    xmm_real = DirectX::XMVectorDivide(xmm_real, xmm_length);
+                    xmm_dual = DirectX::XMVectorDivide(xmm_dual, xmm_length);
+                }
+                else
+                    xmm_real = DirectX::XMQuaternionIdentity();
+
+                // translation = 2 * dual * conjugate(real)
+                auto xmm_translation = ins_multiplyQuaternion(xmm_dual, DirectX::XMQuaternionConjugate(xmm_real));
+                xmm_translation = DirectX::XMVectorAdd(xmm_translation, xmm_translation);
+
+                // scale isn't a part of the rigid transform, so it's blended linearly and applied in the bind space
+                xmm_position = DirectX::XMVectorMultiply(xmm_position, xmm_scale);
+                xmm_position = DirectX::XMVectorAdd(DirectX::XMVector3Rotate(xmm_position, xmm_real), xmm_translation);
+                if(pNormals)
+                    xmm_normal = DirectX::XMVector3Normalize(DirectX::XMVector3Rotate(DirectX::XMVectorDivide(xmm_normal, xmm_scale), xmm_real));
+            }
+        }
+
+        DirectX::XMStoreFloat3((DirectX::XMFLOAT3*)pOutPositions[idxVert].Values, xmm_position);
+        if(pOutNormals && pNormals)
+            DirectX::XMStoreFloat3((DirectX::XMFLOAT3*)pOutNormals[idxVert].Values, xmm_normal);
+    }
+}
+
+bool SHRComputeSkinning(const FBXSkinnedMesh* pMesh, const FBXStaticArray<float, 16>* pBoneMatrices, FBXSkinningMode mode, FBXStaticArray<float, 3>* pOutPositions, FBXStaticArray<float, 3>* pOutNormals){
+    static const FBX_CHAR __name_of_this_func[] = FBX_TEXT("SHRComputeSkinning(const FBXSkinnedMesh*, const FBXStaticArray<float, 16>*, FBXSkinningMode, FBXStaticArray<float, 3>*, FBXStaticArray<float, 3>*)");
+
+
+    if(pMesh->SkinInfos.Length != pMesh->Vertices.Length){
+        SHRPushErrorMessage(FBX_TEXT("SkinInfos must have same count with Vertices"), __name_of_this_func);
+        return false;
+    }
+
+    const FBXStaticArray<float, 3>* pNormals = nullptr;
+    if(pOutNormals){
+        for(const auto* pLayer = pMesh->LayeredElements.Values; FBX_PTRDIFFU(pLayer - pMesh->LayeredElements.Values) < pMesh->LayeredElements.Length; ++pLayer){
+            if(pLayer->Normal.Length == pMesh->Vertices.Length){
+                pNormals = pLayer->Normal.Values;
+                break;
+            }
+        }
+    }
+
+    const auto deformCount = pMesh->SkinDeforms.Length;
+
+    fbx_vector<DirectX::XMMATRIX> skinMatrices(deformCount);
+    fbx_vector<_DualQuaternion> skinDualQuaternions;
+    for(size_t idxDeform = 0u; idxDeform < deformCount; ++idxDeform){
+        const auto& iDeform = pMesh->SkinDeforms.Values[idxDeform];
+
+        auto xmm4_mesh = DirectX::XMLoadFloat4x4((const DirectX::XMFLOAT4X4*)iDeform.TransformMatrix.Values);
+        auto xmm4_link = DirectX::XMLoadFloat4x4((const DirectX::XMFLOAT4X4*)iDeform.LinkMatrix.Values);
+        auto xmm4_pose = DirectX::XMLoadFloat4x4((const DirectX::XMFLOAT4X4*)pBoneMatrices[idxDeform].Values);
+
+        xmm4_link = DirectX::XMMatrixInverse(nullptr, xmm4_link);
+        skinMatrices[idxDeform] = DirectX::XMMatrixMultiply(DirectX::XMMatrixMultiply(xmm4_mesh, xmm4_link), xmm4_pose);
+    }
+    if(mode == FBXSkinningMode::FBXSkinningMode_DualQuaternion){
+        skinDualQuaternions.reserve(deformCount);
+        for(const auto& xmm4_skin : skinMatrices)
+            skinDualQuaternions.emplace_back(ins_makeDualQuaternion(xmm4_skin));
+    }
+
+    // every attribute only needs the bones of its own combination, just like a gpu palette
+    const bool bUseCombination = (pMesh->BoneCombinations.Length == pMesh->Attributes.Length) && pMesh->Attributes.Length;
+    const auto paletteCount = bUseCombination ? pMesh->Attributes.Length : 1u;
+
+    fbx_vector<_SkinningPalette> palettes(paletteCount);
+    fbx_vector<fbx_vector<_DualQuaternion>> paletteDualQuaternions(paletteCount);
+    {
+        fbx_unordered_map<const FBXNode*, unsigned int, PointerHasher<const FBXNode*>> deformFinder;
+        deformFinder.reserve(deformCount);
+        for(size_t idxDeform = 0u; idxDeform < deformCount; ++idxDeform)
+            deformFinder.emplace(pMesh->SkinDeforms.Values[idxDeform].TargetNode, (unsigned int)idxDeform);
+
+        for(size_t idxPalette = 0u; idxPalette < paletteCount; ++idxPalette){
+            auto& iPalette = palettes[idxPalette];
+            auto& iDualQuaternions = paletteDualQuaternions[idxPalette];
+
+            auto appendBone = [&](const FBXNode* pBone)->bool{
+                auto f = deformFinder.find(pBone);
+                if(f == deformFinder.cend())
+                    return false;
+
+                iPalette.finder.emplace(pBone, (unsigned int)iPalette.matrices.size());
+                iPalette.matrices.emplace_back(skinMatrices[f->second]);
+                if(!skinDualQuaternions.empty())
+                    iDualQuaternions.emplace_back(skinDualQuaternions[f->second]);
+                return true;
+            };
+
+            if(bUseCombination){
+                const auto& iCombination = pMesh->BoneCombinations.Values[idxPalette];
+                for(const auto* pBone = iCombination.Values; FBX_PTRDIFFU(pBone - iCombination.Values) < iCombination.Length; ++pBone){
+                    if(!appendBone(*pBone)){
+                        SHRPushErrorMessage(FBX_TEXT("BoneCombinations has a bone not in SkinDeforms"), __name_of_this_func);
+                        return false;
+                    }
+                }
+            }
+            else{
+                for(size_t idxDeform = 0u; idxDeform < deformCount; ++idxDeform)
+                    appendBone(pMesh->SkinDeforms.Values[idxDeform].TargetNode);
+            }
+        }
+    }
+
+    fbx_vector<_SkinningTask> tasks;
+    {
+        auto appendTasks = [&tasks](size_t idxAttr, size_t vertexFirst, size_t vertexLast){
+            for(auto idxVert = vertexFirst; idxVert <= vertexLast; idxVert += ins_skinningVerticesPerTask){
+                _SkinningTask newTask;
+                newTask.attribute = idxAttr;
+                newTask.vertexFirst = idxVert;
+                newTask.vertexLast = std::min(vertexLast, idxVert + ins_skinningVerticesPerTask - 1u);
+                tasks.emplace_back(std::move(newTask));
+            }
+        };
+
+        if(bUseCombination){
+            for(size_t idxAttr = 0u; idxAttr < pMesh->Attributes.Length; ++idxAttr){
+                const auto& iAttr = pMesh->Attributes.Values[idxAttr];
+                if(iAttr.VertexCount)
+                    appendTasks(idxAttr, iAttr.VertexStart, iAttr.VertexStart + iAttr.VertexCount - 1u);
+            }
+        }
+        else if(pMesh->Vertices.Length)
+            appendTasks(0u, 0u, pMesh->Vertices.Length - 1u);
+    }
+
+    fbx_vector<unsigned char> failed(tasks.size(), 0u);
+    std::for_each(std::execution::par, tasks.cbegin(), tasks.cend(), [&](const _SkinningTask& iTask){
+        const auto idxTask = FBX_PTRDIFFU(&iTask - tasks.data());
+        bool bFailed = false;
+
+        const auto& iPalette = palettes[iTask.attribute];
+        if(mode == FBXSkinningMode::FBXSkinningMode_DualQuaternion)
+            ins_skinVertices<FBXSkinningMode::FBXSkinningMode_DualQuaternion>(pMesh, iPalette.matrices, paletteDualQuaternions[iTask.attribute], iPalette, iTask.vertexFirst, iTask.vertexLast, pNormals, pOutPositions, pOutNormals, bFailed);
+        else
+            ins_skinVertices<FBXSkinningMode::FBXSkinningMode_LinearBlend>(pMesh, iPalette.matrices, paletteDualQuaternions[iTask.attribute], iPalette, iTask.vertexFirst, iTask.vertexLast, pNormals, pOutPositions, pOutNormals, bFailed);
+
+        failed[idxTask] = bFailed ? 1u : 0u;
+    });
+
+    for(const auto& iFailed : failed){
+        if(iFailed){
+            SHRPushWarningMessage(FBX_TEXT("some skin weights point a bone out of the bone combination. they were ignored"), __name_of_this_func);
+            break;
+        }
+    }
+
+    return true;
+}
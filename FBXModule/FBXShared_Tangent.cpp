@@ -0,0 +1,639 @@
+﻿/**
+ * @file FBXShared_Tangent.cpp
+ * @date 2026/10/19
+ * @author Lim Taewoo (limztudio@gmail.com)
+ */
+
+
+#include "stdafx.h"
+
+#include <execution>
+
+#include <FBXAssign.hpp>
+
+#include "FBXUtilites.h"
+#include "FBXMath.h"
+#include "FBXShared.h"
+
+
+// port of the MikkTSpace reference implementation(mikktspace.c) for triangle lists.
+// float operations are kept in the same order as the reference, so baked normal maps stay valid.
+// FBXMeshAttribute ranges never share vertices, therefore every range is processed independently and in parallel.
+
+
+enum _TriangleFlag : int{
+    _TriangleFlag_Degenerate = 1 << 0,
+    _TriangleFlag_GroupWithAny = 1 << 2,
+    _TriangleFlag_OrientPreserving = 1 << 3,
+};
+
+
+struct _Vec3{
+    float x, y, z;
+};
+
+static inline _Vec3 ins_vadd(const _Vec3& v1, const _Vec3& v2){ return { v1.x + v2.x, v1.y + v2.y, v1.z + v2.z }; }
+static inline _Vec3 ins_vsub(const _Vec3& v1, const _Vec3& v2){ return { v1.x - v2.x, v1.y - v2.y, v1.z - v2.z }; }
+static inline _Vec3 ins_vscale(float fS, const _Vec3& v){ return { fS * v.x, fS * v.y, fS * v.z }; }
+static inline float ins_vdot(const _Vec3& v1, const _Vec3& v2){ return v1.x * v2.x + v1.y * v2.y + v1.z * v2.z; }
+static inline float ins_length(const _Vec3& v){ return sqrtf(v.x * v.x + v.y * v.y + v.z * v.z); }
+static inline _Vec3 ins_normalize(const _Vec3& v){ return ins_vscale(1 / ins_length(v), v); }
+static inline bool ins_veq(const _Vec3& v1, const _Vec3& v2){ return (v1.x == v2.x) && (v1.y == v2.y) && (v1.z == v2.z); }
+static inline bool ins_notZero(float fX){ return fabsf(fX) > FLT_MIN; }
+static inline bool ins_vNotZero(const _Vec3& v){ return ins_notZero(v.x) || ins_notZero(v.y) || ins_notZero(v.z); }
+
+// removes the normal component and normalizes what is left
+static inline _Vec3 ins_project(const _Vec3& n, const _Vec3& v){
+    auto ret = ins_vsub(v, ins_vscale(ins_vdot(n, v), n));
+    if(ins_vNotZero(ret))
+        ret = ins_normalize(ret);
+    return ret;
+}
+
+
+struct _TangentSpace{
+    _Vec3 vOs;
+    float magS;
+    _Vec3 vOt;
+    float magT;
+    bool orient;
+};
+
+struct _TriangleInfo{
+    int neighbors[3];
+    int groups[3];
+
+    _Vec3 vOs;
+    _Vec3 vOt;
+    float magS;
+    float magT;
+
+    int flag;
+};
+
+struct _TriangleGroup{
+    unsigned int vertexRepresentative;
+    bool orientPreserving;
+
+    UintContainer faces;
+};
+
+struct _TriangleSubGroup{
+    UintContainer members;
+    _TangentSpace space;
+};
+
+struct _TriangleEdge{
+    unsigned int i0; // smaller vertex
+    unsigned int i1; // larger vertex
+    unsigned int f;
+    unsigned int edge; // edge number inside the triangle, which starts from the corner of the same number
+    unsigned int from; // vertex the edge starts from in winding order
+};
+
+// MikkTSpace welds on position, normal and texcoord only
+class _WeldKey{
+public:
+    inline operator size_t()const{ return (size_t)MakeHash64(raw, 8u); }
+
+
+public:
+    float raw[8];
+};
+static inline bool operator==(const _WeldKey& lhs, const _WeldKey& rhs){
+    for(size_t i = 0u; i < 8u; ++i){
+        if(lhs.raw[i] != rhs.raw[i])
+            return false;
+    }
+    return true;
+}
+
+
+class _TangentSpaceBuilder{
+public:
+    void build(const FBXMesh* pMesh, const FBXMeshLayerElement& layer, const FBXMeshAttribute& attribute){
+        positions = pMesh->Vertices.Values + attribute.VertexStart;
+        normals = layer.Normal.Values + attribute.VertexStart;
+        texcoords = layer.Texcoord.Values + attribute.VertexStart;
+
+        vertexCount = (unsigned int)attribute.VertexCount;
+        triangleCount = (unsigned int)attribute.IndexCount;
+
+        corners.resize(size_t(triangleCount) * 3u);
+        for(unsigned int idxTri = 0u; idxTri < triangleCount; ++idxTri){
+            const auto& iInd = pMesh->Indices.Values[attribute.IndexStart + idxTri];
+            for(unsigned int idxCorner = 0u; idxCorner < 3u; ++idxCorner)
+                corners[(idxTri * 3u) + idxCorner] = (unsigned int)(iInd.Values[idxCorner] - attribute.VertexStart);
+        }
+
+        weldVertices();
+        initTriangleInfos();
+        buildNeighbors();
+        buildGroups();
+        generateTangentSpaces();
+        fillDegenerates();
+        storeOutput();
+    }
+
+
+private:
+    inline _Vec3 getPosition(unsigned int idx)const{ const auto* v = positions[idx].Values; return { v[0], v[1], v[2] }; }
+    inline _Vec3 getNormal(unsigned int idx)const{ const auto* v = normals[idx].Values; return { v[0], v[1], v[2] }; }
+    inline _Vec3 getTexcoord(unsigned int idx)const{ const auto* v = texcoords[idx].Values; return { v[0], v[1], 1.f }; }
+
+    void weldVertices(){
+        welder.clear();
+        welder.reserve(vertexCount);
+
+        welded.resize(corners.size());
+        for(size_t idxCorner = 0u; idxCorner < corners.size(); ++idxCorner){
+            const auto idxVert = corners[idxCorner];
+
+            _WeldKey key;
+            CopyArrayData<3>(key.raw, positions[idxVert].Values);
+            CopyArrayData<3>(key.raw + 3, normals[idxVert].Values);
+            CopyArrayData<2>(key.raw + 6, texcoords[idxVert].Values);
+
+            welded[idxCorner] = welder.emplace(key, idxVert).first->second;
+        }
+    }
+
+    void initTriangleInfos(){
+        triangles.resize(triangleCount);
+
+        for(unsigned int f = 0u; f < triangleCount; ++f){
+            auto& iTri = triangles[f];
+
+            for(size_t i = 0u; i < 3u; ++i){
+                iTri.neighbors[i] = -1;
+                iTri.groups[i] = -1;
+            }
+            iTri.vOs = { 0.f, 0.f, 0.f };
+            iTri.vOt = { 0.f, 0.f, 0.f };
+            iTri.magS = 0.f;
+            iTri.magT = 0.f;
+            iTri.flag = _TriangleFlag_GroupWithAny;
+
+            const auto* pVerts = &welded[f * 3u];
+            const auto p0 = getPosition(pVerts[0]);
+            const auto p1 = getPosition(pVerts[1]);
+            const auto p2 = getPosition(pVerts[2]);
+            if(ins_veq(p0, p1) || ins_veq(p0, p2) || ins_veq(p1, p2))
+                iTri.flag |= _TriangleFlag_Degenerate;
+        }
+
+        for(unsigned int f = 0u; f < triangleCount; ++f){
+            auto& iTri = triangles[f];
+            const auto* pVerts = &welded[f * 3u];
+
+            const auto v1 = getPosition(pVerts[0]);
+            const auto v2 = getPosition(pVerts[1]);
+            const auto v3 = getPosition(pVerts[2]);
+            const auto t1 = getTexcoord(pVerts[0]);
+            const auto t2 = getTexcoord(pVerts[1]);
+            const auto t3 = getTexcoord(pVerts[2]);
+
+            const float t21x = t2.x - t1.x;
+            const float t21y = t2.y - t1.y;
+            const float t31x = t3.x - t1.x;
+            const float t31y = t3.y - t1.y;
+            const auto d1 = ins_vsub(v2, v1);
+            const auto d2 = ins_vsub(v3, v1);
+
+            const float fSignedAreaSTx2 = t21x * t31y - t21y * t31x;
+            auto vOs = ins_vsub(ins_vscale(t31y, d1), ins_vscale(t21y, d2));
+            auto vOt = ins_vadd(ins_vscale(-t31x, d1), ins_vscale(t21x, d2));
+
+            iTri.flag |= (fSignedAreaSTx2 > 0 ? _TriangleFlag_OrientPreserving : 0);
+
+            if(ins_notZero(fSignedAreaSTx2)){
+                const float fAbsArea = fabsf(fSignedAreaSTx2);
+                const float fLenOs = ins_length(vOs);
+                const float fLenOt = ins_length(vOt);
+                const float fS = (iTri.flag & _TriangleFlag_OrientPreserving) == 0 ? (-1.0f) : 1.0f;
+                if(ins_notZero(fLenOs))
+                    iTri.vOs = ins_vscale(fS / fLenOs, vOs);
+                if(ins_notZero(fLenOt))
+                    iTri.vOt = ins_vscale(fS / fLenOt, vOt);
+
+                iTri.magS = fLenOs / fAbsArea;
+                iTri.magT = fLenOt / fAbsArea;
+
+                if(ins_notZero(iTri.magS) && ins_notZero(iTri.magT))
+                    iTri.flag &= (~_TriangleFlag_GroupWithAny);
+            }
+        }
+    }
+
+    void buildNeighbors(){
+        edges.clear();
+        edges.reserve(size_t(triangleCount) * 3u);
+
+        for(unsigned int f = 0u; f < triangleCount; ++f){
+            if(triangles[f].flag & _TriangleFlag_Degenerate)
+                continue;
+
+            for(unsigned int i = 0u; i < 3u; ++i){
+                const auto i0 = welded[(f * 3u) + i];
+                const auto i1 = welded[(f * 3u) + (i < 2u ? (i + 1u) : 0u)];
+                edges.push_back({ i0 < i1 ? i0 : i1, i0 < i1 ? i1 : i0, f, i, i0 });
+            }
+        }
+
+        std::sort(edges.begin(), edges.end(), [](const _TriangleEdge& lhs, const _TriangleEdge& rhs){
+            if(lhs.i0 != rhs.i0)
+                return lhs.i0 < rhs.i0;
+            if(lhs.i1 != rhs.i1)
+                return lhs.i1 < rhs.i1;
+            return lhs.f < rhs.f;
+        });
+
+        for(size_t idxEdge = 0u; idxEdge < edges.size(); ++idxEdge){
+            const auto& iEdge = edges[idxEdge];
+            if(triangles[iEdge.f].neighbors[iEdge.edge] != -1)
+                continue;
+
+            for(size_t idxOther = idxEdge + 1u; idxOther < edges.size(); ++idxOther){
+                const auto& iOther = edges[idxOther];
+                if(iOther.i0 != iEdge.i0 || iOther.i1 != iEdge.i1)
+                    break;
+
+                // the neighbor must run the edge the other way around
+                if(iOther.from == iEdge.from)
+                    continue;
+                if(triangles[iOther.f].neighbors[iOther.edge] != -1)
+                    continue;
+
+                triangles[iEdge.f].neighbors[iEdge.edge] = (int)iOther.f;
+                triangles[iOther.f].neighbors[iOther.edge] = (int)iEdge.f;
+                break;
+            }
+        }
+    }
+
+    bool assignRecursive(unsigned int f, int idxGroup){
+        auto& iTri = triangles[f];
+        auto& iGroup = groups[idxGroup];
+
+        const auto* pVerts = &welded[f * 3u];
+        const auto i = (pVerts[0] == iGroup.vertexRepresentative) ? 0u : ((pVerts[1] == iGroup.vertexRepresentative) ? 1u : 2u);
+
+        if(iTri.groups[i] == idxGroup)
+            return true;
+        else if(iTri.groups[i] != -1)
+            return false;
+
+        if(iTri.flag & _TriangleFlag_GroupWithAny){
+            // first time this triangle is reached, so it follows the orientation of the group
+            if(iTri.groups[0] == -1 && iTri.groups[1] == -1 && iTri.groups[2] == -1){
+                iTri.flag &= (~_TriangleFlag_OrientPreserving);
+                iTri.flag |= (iGroup.orientPreserving ? _TriangleFlag_OrientPreserving : 0);
+            }
+        }
+
+        const bool bOrient = (iTri.flag & _TriangleFlag_OrientPreserving) != 0;
+        if(bOrient != iGroup.orientPreserving)
+            return false;
+
+        iGroup.faces.emplace_back(f);
+        iTri.groups[i] = idxGroup;
+
+        const auto neighborL = iTri.neighbors[i];
+        const auto neighborR = iTri.neighbors[i > 0u ? (i - 1u) : 2u];
+        if(neighborL >= 0)
+            assignRecursive((unsigned int)neighborL, idxGroup);
+        if(neighborR >= 0)
+            assignRecursive((unsigned int)neighborR, idxGroup);
+
+        return true;
+    }
+    void buildGroups(){
+        groups.clear();
+
+        for(unsigned int f = 0u; f < triangleCount; ++f){
+            auto& iTri = triangles[f];
+            if(iTri.flag & (_TriangleFlag_Degenerate | _TriangleFlag_GroupWithAny))
+                continue;
+
+            for(unsigned int i = 0u; i < 3u; ++i){
+                if(iTri.groups[i] != -1)
+                    continue;
+
+                const auto idxGroup = (int)groups.size();
+                groups.emplace_back();
+                {
+                    auto& iGroup = groups.back();
+                    iGroup.vertexRepresentative = welded[(f * 3u) + i];
+                    iGroup.orientPreserving = (iTri.flag & _TriangleFlag_OrientPreserving) != 0;
+                    iGroup.faces.emplace_back(f);
+                }
+                iTri.groups[i] = idxGroup;
+
+                const auto neighborL = iTri.neighbors[i];
+                const auto neighborR = iTri.neighbors[i > 0u ? (i - 1u) : 2u];
+                if(neighborL >= 0)
+                    assignRecursive((unsigned int)neighborL, idxGroup);
+                if(neighborR >= 0)
+                    assignRecursive((unsigned int)neighborR, idxGroup);
+            }
+        }
+    }
+
+    _TangentSpace evalTangentSpace(const UintContainer& faces, unsigned int vertexRepresentative)const{
+        _TangentSpace res = { { 0.f, 0.f, 0.f }, 0.f, { 0.f, 0.f, 0.f }, 0.f, false };
+        float fAngleSum = 0;
+
+        for(const auto f : faces){
+            const auto& iTri = triangles[f];
+
+            // only valid triangles get to add their contribution
+            if(iTri.flag & _TriangleFlag_GroupWithAny)
+                continue;
+
+            const auto* pVerts = &welded[f * 3u];
+            const auto i = (pVerts[0] == vertexRepresentative) ? 0u : ((pVerts[1] == vertexRepresentative) ? 1u : 2u);
+
+            const auto n = getNormal(pVerts[i]);
+            const auto vOs = ins_project(n, iTri.vOs);
+            const auto vOt = ins_project(n, iTri.vOt);
+
+            const auto p0 = getPosition(pVerts[i > 0u ? (i - 1u) : 2u]);
+            const auto p1 = getPosition(pVerts[i]);
+            const auto p2 = getPosition(pVerts[i < 2u ? (i + 1u) : 0u]);
+            const auto v1 = ins_project(n, ins_vsub(p0, p1));
+            const auto v2 = ins_project(n, ins_vsub(p2, p1));
+
+            // weight contribution by the angle between the two edge vectors
+            float fCos = ins_vdot(v1, v2);
+            fCos = fCos > 1 ? 1 : (fCos < (-1) ? (-1) : fCos);
+            const float fAngle = (float)acos(fCos);
+
+            res.vOs = ins_vadd(res.vOs, ins_vscale(fAngle, vOs));
+            res.vOt = ins_vadd(res.vOt, ins_vscale(fAngle, vOt));
+            res.magS += (fAngle * iTri.magS);
+            res.magT += (fAngle * iTri.magT);
+            fAngleSum += fAngle;
+        }
+
+        if(ins_vNotZero(res.vOs))
+            res.vOs = ins_normalize(res.vOs);
+        if(ins_vNotZero(res.vOt))
+            res.vOt = ins_normalize(res.vOt);
+        if(fAngleSum > 0){
+            res.magS /= fAngleSum;
+            res.magT /= fAngleSum;
+        }
+
+        return res;
+    }
+    void generateTangentSpaces(){
+        // cos(180 degree), which is the default angular threshold of the reference
+        static const float fThresCos = -1.f;
+
+        cornerSpaces.resize(corners.size());
+        for(auto& iSpace : cornerSpaces)
+            iSpace = { { 1.f, 0.f, 0.f }, 1.f, { 0.f, 1.f, 0.f }, 1.f, false };
+
+        for(auto edxGroup = (int)groups.size(), idxGroup = 0; idxGroup < edxGroup; ++idxGroup){
+            const auto& iGroup = groups[idxGroup];
+
+            subGroups.clear();
+
+            for(const auto f : iGroup.faces){
+                const auto& iTri = triangles[f];
+                const auto index = (iTri.groups[0] == idxGroup) ? 0u : ((iTri.groups[1] == idxGroup) ? 1u : 2u);
+
+                const auto n = getNormal(welded[(f * 3u) + index]);
+                const auto vOs = ins_project(n, iTri.vOs);
+                const auto vOt = ins_project(n, iTri.vOt);
+
+                members.clear();
+                for(const auto t : iGroup.faces){
+                    const auto& iOther = triangles[t];
+
+                    const auto vOs2 = ins_project(n, iOther.vOs);
+                    const auto vOt2 = ins_project(n, iOther.vOt);
+
+                    const bool bAny = ((iTri.flag | iOther.flag) & _TriangleFlag_GroupWithAny) != 0;
+                    const bool bSameOrgFace = (f == t);
+
+                    const float fCosS = ins_vdot(vOs, vOs2);
+                    const float fCosT = ins_vdot(vOt, vOt2);
+
+                    if(bAny || bSameOrgFace || (fCosS > fThresCos && fCosT > fThresCos))
+                        members.emplace_back(t);
+                }
+                std::sort(members.begin(), members.end());
+
+                size_t idxSubGroup = 0u;
+                for(; idxSubGroup < subGroups.size(); ++idxSubGroup){
+                    if(subGroups[idxSubGroup].members == members)
+                        break;
+                }
+                if(idxSubGroup == subGroups.size()){
+                    subGroups.emplace_back();
+                    subGroups.back().members = members;
+                    subGroups.back().space = evalTangentSpace(members, iGroup.vertexRepresentative);
+                }
+
+                auto& iSpace = cornerSpaces[(f * 3u) + index];
+                iSpace = subGroups[idxSubGroup].space;
+                iSpace.orient = iGroup.orientPreserving;
+            }
+        }
+    }
+
+    void fillDegenerates(){
+        for(unsigned int t = 0u; t < triangleCount; ++t){
+            if(!(triangles[t].flag & _TriangleFlag_Degenerate))
+                continue;
+
+            for(unsigned int i = 0u; i < 3u; ++i){
+                const auto index1 = welded[(t * 3u) + i];
+
+                // search through the good triangles
+                for(size_t j = 0u; j < corners.size(); ++j){
+                    if(triangles[j / 3u].flag & _TriangleFlag_Degenerate)
+                        continue;
+                    if(welded[j] == index1){
+                        cornerSpaces[(t * 3u) + i] = cornerSpaces[j];
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    void storeOutput(){
+        // a vertex is split when its corners ended up with different tangent frames
+        vertexSources.resize(vertexCount);
+        tangents.resize(vertexCount);
+        binormals.resize(vertexCount);
+        copyLinks.assign(vertexCount, -1);
+        assigned.assign(vertexCount, false);
+
+        for(unsigned int idxVert = 0u; idxVert < vertexCount; ++idxVert){
+            vertexSources[idxVert] = idxVert;
+            tangents[idxVert] = { 0.f, 0.f, 0.f };
+            binormals[idxVert] = { 0.f, 0.f, 0.f };
+        }
+
+        indices.resize(corners.size());
+        for(size_t idxCorner = 0u; idxCorner < corners.size(); ++idxCorner){
+            const auto idxVert = corners[idxCorner];
+            const auto& iSpace = cornerSpaces[idxCorner];
+
+            const auto n = getNormal(idxVert);
+            const auto& t = iSpace.vOs;
+            const float fSign = iSpace.orient ? 1.0f : (-1.0f);
+            const auto b = ins_vscale(fSign, { n.y * t.z - n.z * t.y, n.z * t.x - n.x * t.z, n.x * t.y - n.y * t.x });
+
+            if(!assigned[idxVert]){
+                assigned[idxVert] = true;
+                tangents[idxVert] = t;
+                binormals[idxVert] = b;
+                indices[idxCorner] = idxVert;
+                continue;
+            }
+
+            auto idxFound = -1;
+            for(auto idxCopy = (int)idxVert; idxCopy >= 0; idxCopy = copyLinks[idxCopy]){
+                if(!memcmp(&tangents[idxCopy], &t, sizeof(t)) && !memcmp(&binormals[idxCopy], &b, sizeof(b))){
+                    idxFound = idxCopy;
+                    break;
+                }
+            }
+            if(idxFound < 0){
+                idxFound = (int)vertexSources.size();
+
+                vertexSources.emplace_back(idxVert);
+                tangents.emplace_back(t);
+                binormals.emplace_back(b);
+
+                copyLinks.emplace_back(copyLinks[idxVert]);
+                copyLinks[idxVert] = idxFound;
+            }
+
+            indices[idxCorner] = (unsigned int)idxFound;
+        }
+    }
+
+
+public:
+    UintContainer vertexSources; // local vertex of the attribute range each output vertex is copied from
+    UintContainer indices; // three per triangle, pointing vertexSources
+    fbx_vector<_Vec3> tangents;
+    fbx_vector<_Vec3> binormals;
+
+
+private:
+    const FBXStaticArray<float, 3>* positions;
+    const FBXStaticArray<float, 3>* normals;
+    const FBXStaticArray<float, 2>* texcoords;
+
+    unsigned int vertexCount;
+    unsigned int triangleCount;
+
+    UintContainer corners;
+    UintContainer welded;
+    fbx_unordered_map<_WeldKey, unsigned int, CustomHasher<_WeldKey>> welder;
+
+    fbx_vector<_TriangleInfo> triangles;
+    fbx_vector<_TriangleEdge> edges;
+    fbx_vector<_TriangleGroup> groups;
+    fbx_vector<_TriangleSubGroup> subGroups;
+    UintContainer members;
+    fbx_vector<_TangentSpace> cornerSpaces;
+
+    IntContainer copyLinks;
+    fbx_vector<bool> assigned;
+};
+
+
+template<typename T>
+static inline void ins_remapVertexTable(FBXDynamicArray<T>& table, const UintContainer& sources){
+    if(!table.Length)
+        return;
+
+    FBXDynamicArray<T> newTable;
+    newTable.Assign(sources.size());
+    for(size_t idxVert = 0u; idxVert < newTable.Length; ++idxVert)
+        newTable.Values[idxVert] = table.Values[sources[idxVert]];
+
+    table = std::move(newTable);
+}
+
+
+void SHRGenerateTangentSpace(FBXMesh* pMesh){
+    // tangents follow the first layer which has both of normals and texcoords
+    FBXMeshLayerElement* pLayer = nullptr;
+    for(auto* iLayer = pMesh->LayeredElements.Values; FBX_PTRDIFFU(iLayer - pMesh->LayeredElements.Values) < pMesh->LayeredElements.Length; ++iLayer){
+        if(iLayer->Normal.Length && iLayer->Texcoord.Length){
+            pLayer = iLayer;
+            break;
+        }
+    }
+    if(!pLayer || !pMesh->Attributes.Length)
+        return;
+
+    fbx_vector<_TangentSpaceBuilder> builders(pMesh->Attributes.Length);
+    std::for_each(std::execution::par, builders.begin(), builders.end(), [pMesh, pLayer, &builders](_TangentSpaceBuilder& builder){
+        const auto idxAttr = FBX_PTRDIFFU(&builder - builders.data());
+        builder.build(pMesh, *pLayer, pMesh->Attributes.Values[idxAttr]);
+    });
+
+    size_t vertexCount = 0u;
+    for(const auto& iBuilder : builders)
+        vertexCount += iBuilder.vertexSources.size();
+
+    if(vertexCount != pMesh->Vertices.Length){
+        UintContainer sources;
+        sources.reserve(vertexCount);
+
+        for(size_t idxAttr = 0u; idxAttr < pMesh->Attributes.Length; ++idxAttr){
+            auto& iAttr = pMesh->Attributes.Values[idxAttr];
+            const auto& iBuilder = builders[idxAttr];
+
+            const auto oldStart = iAttr.VertexStart;
+            const auto newStart = (unsigned long)sources.size();
+
+            for(const auto& idxSource : iBuilder.vertexSources)
+                sources.emplace_back((unsigned int)(oldStart + idxSource));
+
+            for(size_t idxTri = 0u; idxTri < iAttr.IndexCount; ++idxTri){
+                auto& iInd = pMesh->Indices.Values[iAttr.IndexStart + idxTri];
+                for(size_t idxCorner = 0u; idxCorner < 3u; ++idxCorner)
+                    iInd.Values[idxCorner] = newStart + iBuilder.indices[(idxTri * 3u) + idxCorner];
+            }
+
+            iAttr.VertexStart = newStart;
+            iAttr.VertexCount = (unsigned long)iBuilder.vertexSources.size();
+        }
+
+        ins_remapVertexTable(pMesh->Vertices, sources);
+        for(auto* iLayer = pMesh->LayeredElements.Values; FBX_PTRDIFFU(iLayer - pMesh->LayeredElements.Values) < pMesh->LayeredElements.Length; ++iLayer){
+            ins_remapVertexTable(iLayer->Color, sources);
+            ins_remapVertexTable(iLayer->Normal, sources);
+            ins_remapVertexTable(iLayer->Binormal, sources);
+            ins_remapVertexTable(iLayer->Tangent, sources);
+            ins_remapVertexTable(iLayer->Texcoord, sources);
+        }
+
+        if(pMesh->getID() == FBXType::FBXType_SkinnedMesh)
+            ins_remapVertexTable(static_cast<FBXSkinnedMesh*>(pMesh)->SkinInfos, sources);
+    }
+
+    pLayer->Tangent.Assign(vertexCount);
+    pLayer->Binormal.Assign(vertexCount);
+    for(size_t idxAttr = 0u, idxVert = 0u; idxAttr < pMesh->Attributes.Length; ++idxAttr){
+        const auto& iBuilder = builders[idxAttr];
+
+        for(size_t idxLocal = 0u; idxLocal < iBuilder.vertexSources.size(); ++idxLocal, ++idxVert){
+            const auto& t = iBuilder.tangents[idxLocal];
+            const auto& b = iBuilder.binormals[idxLocal];
+
+            pLayer->Tangent.Values[idxVert] = FBXStaticArray<float, 3>(t.x, t.y, t.z);
+            pLayer->Binormal.Values[idxVert] = FBXStaticArray<float, 3>(b.x, b.y, b.z);
+        }
+    }
+}
@@ -8,6 +8,8 @@
 #pragma once
 
 
+#include <algorithm>
+
 #include <fbxsdk.h>
 #include <FBXNode.hpp>
 
@@ -459,6 +461,41 @@ static inline fbx_basic_string<TYPE> ToString(const TABLE<TYPE>& str){
     return fbx_basic_string<TYPE>();
 }
 
+// index of the last key whose time isn't greater than "time", or 0 if every key is later.
+// gallops from "hint"(the result of previous lookup) and binary searches inside the bracket, so sequential lookups are amortized O(1) and random ones O(log n)
+template<typename KEY>
+static inline unsigned long FindAnimationKey(const FBXDynamicArray<KEY>& keys, float time, unsigned long hint = 0){
+    const auto* pKeys = keys.Values;
+    const auto keyCount = (unsigned long)keys.Length;
+    const auto compare = [](float t, const KEY& k){ return t < k.Time; };
+
+    unsigned long low, high;
+
+    hint = std::min(hint, keyCount - 1);
+    if(pKeys[hint].Time <= time){
+        low = hint;
+        high = hint + 1;
+        for(unsigned long step = 1; (high < keyCount) && (pKeys[high].Time <= time); step <<= 1){
+            low = high;
+            high = low + step;
+        }
+        high = std::min(high, keyCount);
+    }
+    else{
+        high = hint;
+        low = hint;
+        for(unsigned long step = 1; low; step <<= 1){
+            low = (high > step) ? (high - step) : 0;
+            if(pKeys[low].Time <= time)
+                break;
+            high = low;
+        }
+    }
+
+    const auto* pFound = std::upper_bound(pKeys + low, pKeys + high, time, compare);
+    return (pFound == pKeys) ? 0 : (unsigned long)(pFound - pKeys - 1);
+}
+
 static inline fbxsdk::FbxAMatrix GetGeometry(fbxsdk::FbxNode* kNode){
     return fbxsdk::FbxAMatrix(
         kNode->GetGeometricTranslation(fbxsdk::FbxNode::eSourcePivot),
@@ -467,6 +504,18 @@ static inline fbxsdk::FbxAMatrix GetGeometry(fbxsdk::FbxNode* kNode){
     );
 }
 
+// TransformMatrix of the node composed with those of every ancestor, which is the bind world transform FBXGetWorldMatrix gives.
+// pOutMatrix takes 16 floats in the layout of TransformMatrix
+extern void GetBindWorldMatrix(float* pOutMatrix, const FBXNode* pNode);
+static inline fbxsdk::FbxAMatrix GetBindWorldTransform(const FBXNode* pNode){
+    float matFlt[16];
+    GetBindWorldMatrix(matFlt, pNode);
+
+    fbxsdk::FbxAMatrix kMatRes;
+    CopyArrayData<16>((double*)kMatRes, (const float*)matFlt);
+    return kMatRes;
+}
+
 template<typename L_TYPE, typename R_TYPE>
 static inline fbx_basic_string<L_TYPE> ConvertString(const fbx_basic_string<R_TYPE>& strSrc){ return strSrc; }
 
@@ -20,8 +20,22 @@ class FBXNode;
 enum class FBXAnimationInterpolationType : unsigned char{
     FBXAnimationInterpolationType_Stepped,
     FBXAnimationInterpolationType_Linear,
+    FBXAnimationInterpolationType_Cubic,
 };
 
+// slopes(per second) at the key. In is the slope of the segment ending at the key, Out of the one starting at the key
+template<typename T>
+class FBXAnimationTangent{
+public:
+    T In;
+    T Out;
+};
+template<typename T>
+class FBXAnimationKeyTangent{
+public:
+    FBXAnimationTangent<T> Local;
+    FBXAnimationTangent<T> World;
+};
 template<typename T>
 class FBXAnimationKeyFrame{
 public:
@@ -33,13 +47,44 @@ public:
     FBXAnimationInterpolationType InterpolationType;
 };
 class FBXAnimationNode{
+public:
+    FBXAnimationNode()
+        :
+        BindNode(nullptr),
+        HasWorldKeys(true)
+    {}
+
+
 public:
     FBXDynamicArray<FBXAnimationKeyFrame<FBXStaticArray<float, 3>>> ScalingKeys;
     FBXDynamicArray<FBXAnimationKeyFrame<FBXStaticArray<float, 4>>> RotationKeys;
     FBXDynamicArray<FBXAnimationKeyFrame<FBXStaticArray<float, 3>>> TranslationKeys;
 
+public:
+    // tangents of the keys above in same order, only read by FBXAnimationInterpolationType_Cubic segments(hermite).
+    // a track without cubic keys leaves them empty, and cubic segments of a track without them are flat at both ends
+    FBXDynamicArray<FBXAnimationKeyTangent<FBXStaticArray<float, 3>>> ScalingTangents;
+    FBXDynamicArray<FBXAnimationKeyTangent<FBXStaticArray<float, 4>>> RotationTangents;
+    FBXDynamicArray<FBXAnimationKeyTangent<FBXStaticArray<float, 3>>> TranslationTangents;
+
 public:
     FBXNode* BindNode;
+
+    // same as HasWorldKeys of the owning FBXAnimation, so that world queries on a single node can tell whether World of its keys is filled
+    bool HasWorldKeys;
+};
+
+
+class FBXAnimationTransform{
+public:
+    FBXStaticArray<float, 3> Scaling;
+    FBXStaticArray<float, 4> Rotation;
+    FBXStaticArray<float, 3> Translation;
+};
+class FBXAnimationSample{
+public:
+    FBXAnimationTransform Local;
+    FBXAnimationTransform World;
 };
 
 
@@ -48,13 +93,156 @@ public:
     virtual FBXType getID()const{ return FBXType::FBXType_Animation; }
 
 
+public:
+    FBXAnimation()
+        :
+        EndTime(0.f),
+        HasWorldKeys(true),
+        SampleFrameCount(0),
+        SampleRate(0.f)
+    {}
+
+
 public:
     FBXDynamicArray<FBXAnimationNode> AnimationNodes;
     float EndTime;
 
+    // false if World of keys and tangents and World of samples are not filled, as on import with "IgnoreAnimationWorldKeys" of FBXIOSetting.
+    // queries in world space fail on such animation until FBXBuildAnimationWorldKeys fills them. HasWorldKeys of every animation node follows it
+    bool HasWorldKeys;
+
+public:
+    // frame-major samples over [0, EndTime], whose last frame is at EndTime. node i of frame f is Samples.Values[f * AnimationNodes.Length + i].
+    // filled only if "AnimationSampleRate" of FBXIOSetting is set, or by FBXResampleAnimation
+    FBXDynamicArray<FBXAnimationSample> Samples;
+    unsigned long SampleFrameCount;
+    float SampleRate; // frames per second
+
 public:
     FBXDynamicArray<FBX_CHAR> Name;
 };
 
 
+// output of FBXCompressAnimation. node order is same as AnimationNodes of the source animation
+class FBXCompressedAnimation : public FBXBase{
+public:
+    virtual FBXType getID()const{ return FBXType::FBXType_CompressedAnimation; }
+
+
+public:
+    FBXCompressedAnimation()
+        :
+        NodeCount(0),
+        EndTime(0.f),
+        World(false)
+    {}
+
+
+public:
+    // quantized tracks. layout is private to the module, and only read by FBXDecompressAnimationPose
+    FBXDynamicArray<unsigned char> Data;
+    unsigned long NodeCount;
+    float EndTime;
+    bool World; // whether the tracks are of world transform
+
+public:
+    FBXDynamicArray<FBX_CHAR> Name;
+};
+
+// output of FBXCompressStreamingAnimation. the clip is cut into blocks of BlockDuration, and each block is a self-contained compressed clip.
+// block i covers [i * BlockDuration, (i + 1) * BlockDuration] and lies in Data over [BlockOffsets.Values[i], BlockOffsets.Values[i + 1]).
+// a block can be stored and loaded on its own, from a file or a mapped view, as long as it starts on an 8 bytes boundary
+class FBXStreamingAnimation : public FBXBase{
+public:
+    virtual FBXType getID()const{ return FBXType::FBXType_StreamingAnimation; }
+
+
+public:
+    FBXStreamingAnimation()
+        :
+        NodeCount(0),
+        EndTime(0.f),
+        BlockDuration(0.f),
+        World(false)
+    {}
+
+
+public:
+    // blocks laid back to back. layout of a block is private to the module, and only read by FBXDecompressAnimationBlockPose
+    FBXDynamicArray<unsigned char> Data;
+    FBXDynamicArray<unsigned long long> BlockOffsets; // block count + 1 entries
+    unsigned long NodeCount;
+    float EndTime;
+    float BlockDuration;
+    bool World; // whether the tracks are of world transform
+
+public:
+    FBXDynamicArray<FBX_CHAR> Name;
+};
+
+// structure of arrays over FBXAnimation::AnimationNodes. every plane must have at least AnimationNodes.Length elements
+class FBXAnimationPose{
+public:
+    float* Scaling[3];
+    float* Rotation[4];
+    float* Translation[3];
+};
+
+// link of an animation node to its nearest animated ancestor, made by FBXBuildAnimationPoseLinks. links are ordered so that parents come before their children.
+// world is local, then offset, then world of the parent
+class FBXAnimationPoseLink{
+public:
+    // bind transform of the unanimated nodes in between, or above the node if there is no animated ancestor
+    FBXStaticArray<float, 3> OffsetScaling;
+    FBXStaticArray<float, 4> OffsetRotation;
+    FBXStaticArray<float, 3> OffsetTranslation;
+
+public:
+    unsigned long Node; // index in AnimationNodes
+    unsigned long Parent; // index in AnimationNodes. AnimationNodes.Length if there is no animated ancestor
+};
+
+// components that FBXExtractRootMotion moves from the root node to the root motion track. axes are of the parent space of the root node
+enum class FBXRootMotionFlag : unsigned long{
+    FBXRootMotionFlag_TranslationX = 1 << 0,
+    FBXRootMotionFlag_TranslationY = 1 << 1,
+    FBXRootMotionFlag_TranslationZ = 1 << 2,
+
+    FBXRootMotionFlag_Translation_Mask = (
+    FBXRootMotionFlag_TranslationX
+    | FBXRootMotionFlag_TranslationY
+    | FBXRootMotionFlag_TranslationZ
+    ),
+
+
+    // yaw is the twist of rotation around the axis. only one axis can be set
+    FBXRootMotionFlag_Yaw_XAxis = 1 << 3,
+    FBXRootMotionFlag_Yaw_YAxis = 1 << 4,
+    FBXRootMotionFlag_Yaw_ZAxis = 1 << 5,
+
+    FBXRootMotionFlag_Yaw_Mask = (
+    FBXRootMotionFlag_Yaw_XAxis
+    | FBXRootMotionFlag_Yaw_YAxis
+    | FBXRootMotionFlag_Yaw_ZAxis
+    ),
+};
+
+// caller owned key position of each FBXAnimationNode. must be kept per FBXAnimation, and sequential sampling only steps from here
+class FBXAnimationCursor{
+public:
+    FBXAnimationCursor()
+        :
+        ScalingKey(0),
+        RotationKey(0),
+        TranslationKey(0)
+    {}
+
+
+public:
+    unsigned long ScalingKey;
+    unsigned long RotationKey;
+    unsigned long TranslationKey;
+};
+
+
 #endif // _FBXANIMATION_HPP_
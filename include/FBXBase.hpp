@@ -12,13 +12,15 @@
 #include "FBXType.hpp"
 
 
-// abef g000 0000 c000 d000 0000 0000 0000
+// abef g000 0000 chi0 d000 0000 0000 0000
 // a: root identifier
 // b: node identifier
 // b e: bone identifier
 // b f: mesh identifier
 // b f g: skinned mesh identifier
 // c: animation identifier
+// h: compressed animation identifier
+// i: streaming animation identifier
 // d: material identifier
 
 
@@ -31,6 +33,8 @@ enum class FBXType : unsigned long{
     FBXType_SkinnedMesh = FBXType_Mesh | (1u << 27),
 
     FBXType_Animation = 1u << 19,
+    FBXType_CompressedAnimation = 1u << 18,
+    FBXType_StreamingAnimation = 1u << 17,
 
     FBXType_Material = 1u << 15,
 };
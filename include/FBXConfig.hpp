@@ -64,31 +64,51 @@ public:
         :
         ExportAsASCII(true),
         IgnoreAnimationIO(false),
+        IgnoreAnimationWorldKeys(false),
+        ShareInstancedMesh(false),
+        WeldInSinglePrecision(false),
+        GenerateTangentSpace(false),
+        MinimizeBoneCombination(false),
+        MinimizeInfluenceError(false),
 
         MaxParticipateClusterPerVertex(4),
         MaxBoneCountPerMesh(20),
+        ExtraBoneCountPerMesh(nullptr),
+        ExtraBoneBudgetCount(0),
 
         AxisSystem(FBXAxisSystem::FBXAxisSystem_Preset_DirectX),
         UnitScale(2.54),
         UnitMultiplier(1.),
 
-        AnimationKeyCompareDifference(0.0001)
+        AnimationKeyCompareDifference(0.0001),
+        SkinWeightPruneEpsilon(0.),
+        AnimationSampleRate(0.)
     {}
 
 
 public:
     bool ExportAsASCII;
     bool IgnoreAnimationIO;
+    bool IgnoreAnimationWorldKeys; // World of animation keys and their tangents aren't evaluated on import, which halves the evaluator calls. keys keep their World members, so memory is not reduced. HasWorldKeys of the animation stays false until FBXBuildAnimationWorldKeys fills them from local keys
+    bool ShareInstancedMesh; // non-skinned meshes having identical geometry will share one geometry. see FBXRoot::MeshInstances
+    bool WeldInSinglePrecision; // the optimizer's weld records, hashes and skin weight comparisons use float instead of double, so vertices equal in float get merged. no other path changes precision. keep false for large world coordinates
+    bool GenerateTangentSpace; // tangents and binormals are rebuilt MikkTSpace compatible on the first layer having normals and texcoords. vertices may be split on mirrored uv seams
+    bool MinimizeBoneCombination; // skinned meshes are partitioned into bone palettes by bone set overlap instead of polygon order. used only when it yields less draw calls
+    bool MinimizeInfluenceError; // influences over MaxParticipateClusterPerVertex are dropped and reweighted by the deformation error over the bind pose and sampled animation poses, instead of by weight
 
 public:
     unsigned long MaxParticipateClusterPerVertex;
     unsigned long MaxBoneCountPerMesh;
+    const unsigned long* ExtraBoneCountPerMesh; // additional budgets skinned meshes are partitioned for in the same import, which has ExtraBoneBudgetCount elements. copied by FBXOpenFile. see FBXSkinnedMesh::BoneBudgets
+    unsigned long ExtraBoneBudgetCount;
 
 public:
     FBXAxisSystem AxisSystem;
     double UnitScale;
     double UnitMultiplier;
     double AnimationKeyCompareDifference;
+    double SkinWeightPruneEpsilon; // influences lighter than this ratio of the vertex total are removed before limiting and partitioning
+    double AnimationSampleRate; // frames per second every animation is resampled at into FBXAnimation::Samples. 0 leaves Samples empty
 };
 
 
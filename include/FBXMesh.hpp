@@ -46,7 +46,10 @@ public:
 
 
 public:
-    FBXMesh(){}
+    FBXMesh()
+        :
+        InstanceSource(nullptr)
+    {}
     virtual ~FBXMesh(){}
 
 
@@ -62,6 +65,26 @@ public:
 
 public:
     FBXDynamicArray<FBXMeshLayerElement> LayeredElements;
+
+public:
+    FBXMesh* InstanceSource; // not null if this node shares geometry of another mesh node. all geometry arrays of this node are left empty in that case
+};
+
+
+class FBXMeshInstance{
+public:
+    FBXMeshInstance()
+        :
+        Geometry(nullptr)
+    {}
+
+
+public:
+    FBXMesh* Geometry; // the mesh node which holds shared geometry
+
+public:
+    FBXDynamicArray<FBXMesh*> Nodes; // every mesh node using "Geometry", including "Geometry" itself
+    FBXDynamicArray<FBXStaticArray<float, 16>> WorldMatrices; // must have same count with Nodes
 };
 
 
@@ -76,6 +76,12 @@ __FBXM_MAKE_FUNC(bool, FBXWriteScene, const void* pRoot);
  * @return Current scene.
  */
 __FBXM_MAKE_FUNC(const void*, FBXGetRoot, void);
+/**
+ * @brief Return draw call count made for meshes of current read scene.
+ * @param pGreedyCount Output attribute count partitioning by polygon order would have made. Can be nullptr.
+ * @param pCount Output attribute count actually made. Differs from pGreedyCount only if FBXIOSetting::MinimizeBoneCombination is set. Can be nullptr.
+ */
+__FBXM_MAKE_FUNC(void, FBXGetBoneCombinationReport, unsigned long* pGreedyCount, unsigned long* pCount);
 
 /**
  * @brief Return world matrix of selected node.
@@ -108,7 +114,17 @@ __FBXM_MAKE_FUNC(void, FBXTransformNormal, void* pOutVec3, const void* pVec3, co
  */
 __FBXM_MAKE_FUNC(void, FBXComputeAnimationLocalTransform, void* pOutScale, void* pOutRotation, void* pOutTranslation, const void* pAnimationNode, float time);
 /**
- * @brief Compute world transform on specific time of animation node.
+ * @brief Compute local transform on specific time of animation node, starting key search from previous call.
+ * @param pOutScale Output scale of transform. Must be set to an address of 3xfloat.
+ * @param pOutRotation Output quaternion(rotation) of transform. Must be set to an address of 4xfloat.
+ * @param pOutTranslation Output translation of transform. Must be set to an address of 3xfloat.
+ * @param pCursor Key position of animation node. Must be passed by "FBXAnimationCursor*", and kept for the same animation node. Sequential sampling costs amortized O(1), and random sampling O(log n).
+ * @param pAnimationNode Reference animation node. Must be passed by "const FBXAnimationNode*".
+ * @param time Time in second.
+ */
+__FBXM_MAKE_FUNC(void, FBXComputeAnimationLocalTransformWithCursor, void* pOutScale, void* pOutRotation, void* pOutTranslation, void* pCursor, const void* pAnimationNode, float time);
+/**
+ * @brief Compute world transform on specific time of animation node. Pushes error and leaves output as it is if World of keys is not filled. see FBXAnimationNode::HasWorldKeys.
  * @param pOutScale Output scale of transform. Must be set to an address of 3xfloat.
  * @param pOutRotation Output quaternion(rotation) of transform. Must be set to an address of 4xfloat.
  * @param pOutTranslation Output translation of transform. Must be set to an address of 3xfloat.
@@ -116,6 +132,16 @@ __FBXM_MAKE_FUNC(void, FBXComputeAnimationLocalTransform, void* pOutScale, void*
  * @param time Time in second.
  */
 __FBXM_MAKE_FUNC(void, FBXComputeAnimationWorldTransform, void* pOutScale, void* pOutRotation, void* pOutTranslation, const void* pAnimationNode, float time);
+/**
+ * @brief Compute world transform on specific time of animation node, starting key search from previous call. Pushes error and leaves output as it is if World of keys is not filled. see FBXAnimationNode::HasWorldKeys.
+ * @param pOutScale Output scale of transform. Must be set to an address of 3xfloat.
+ * @param pOutRotation Output quaternion(rotation) of transform. Must be set to an address of 4xfloat.
+ * @param pOutTranslation Output translation of transform. Must be set to an address of 3xfloat.
+ * @param pCursor Key position of animation node. Must be passed by "FBXAnimationCursor*", and kept for the same animation node. Sequential sampling costs amortized O(1), and random sampling O(log n).
+ * @param pAnimationNode Reference animation node. Must be passed by "const FBXAnimationNode*".
+ * @param time Time in second.
+ */
+__FBXM_MAKE_FUNC(void, FBXComputeAnimationWorldTransformWithCursor, void* pOutScale, void* pOutRotation, void* pOutTranslation, void* pCursor, const void* pAnimationNode, float time);
 
 /**
  * @brief Compute local transform on specific time of animation node.
@@ -125,7 +151,7 @@ __FBXM_MAKE_FUNC(void, FBXComputeAnimationWorldTransform, void* pOutScale, void*
  */
 __FBXM_MAKE_FUNC(void, FBXComputeAnimationLocalScale, void* pOutScale, const void* pAnimationNode, float time);
 /**
- * @brief Compute world transform on specific time of animation node.
+ * @brief Compute world transform on specific time of animation node. Pushes error and leaves output as it is if World of keys is not filled. see FBXAnimationNode::HasWorldKeys.
  * @param pOutScale Output scale of transform. Must be set to an address of 3xfloat.
  * @param pAnimationNode Reference animation node. Must be passed by "const FBXAnimationNode*".
  * @param time Time in second.
@@ -140,7 +166,7 @@ __FBXM_MAKE_FUNC(void, FBXComputeAnimationWorldScale, void* pOutScale, const voi
  */
 __FBXM_MAKE_FUNC(void, FBXComputeAnimationLocalRotation, void* pOutRotation, const void* pAnimationNode, float time);
 /**
- * @brief Compute world transform on specific time of animation node.
+ * @brief Compute world transform on specific time of animation node. Pushes error and leaves output as it is if World of keys is not filled. see FBXAnimationNode::HasWorldKeys.
  * @param pOutRotation Output quaternion(rotation) of transform. Must be set to an address of 4xfloat.
  * @param pAnimationNode Reference animation node. Must be passed by "const FBXAnimationNode*".
  * @param time Time in second.
@@ -155,13 +181,218 @@ __FBXM_MAKE_FUNC(void, FBXComputeAnimationWorldRotation, void* pOutRotation, con
  */
 __FBXM_MAKE_FUNC(void, FBXComputeAnimationLocalTranslation, void* pOutTranslation, const void* pAnimationNode, float time);
 /**
- * @brief Compute world transform on specific time of animation node.
+ * @brief Compute world transform on specific time of animation node. Pushes error and leaves output as it is if World of keys is not filled. see FBXAnimationNode::HasWorldKeys.
  * @param pOutTranslation Output translation of transform. Must be set to an address of 3xfloat.
  * @param pAnimationNode Reference animation node. Must be passed by "const FBXAnimationNode*".
  * @param time Time in second.
  */
 __FBXM_MAKE_FUNC(void, FBXComputeAnimationWorldTranslation, void* pOutTranslation, const void* pAnimationNode, float time);
 
+/**
+ * @brief Compute local transforms of every animation node on specific time at once.
+ * @param pOutPose Output SoA pose. Must be passed by "const FBXAnimationPose*", whose planes have same count with AnimationNodes.
+ * @param pCursors Key positions of previous call. Must be set to an address of FBXAnimationCursor array which has same count with AnimationNodes, or nullptr. Sequential sampling with same cursors costs O(1) per track.
+ * @param pAnimation Reference animation. Must be passed by "const FBXAnimation*".
+ * @param time Time in second.
+ * @return Return true if successfully computed, and false otherwise.
+ */
+__FBXM_MAKE_FUNC(bool, FBXComputeAnimationLocalPose, const void* pOutPose, void* pCursors, const void* pAnimation, float time);
+/**
+ * @brief Compute world transforms of every animation node on specific time at once. Fails if HasWorldKeys of the animation is false.
+ * @param pOutPose Output SoA pose. Must be passed by "const FBXAnimationPose*", whose planes have same count with AnimationNodes.
+ * @param pCursors Key positions of previous call. Must be set to an address of FBXAnimationCursor array which has same count with AnimationNodes, or nullptr. Sequential sampling with same cursors costs O(1) per track.
+ * @param pAnimation Reference animation. Must be passed by "const FBXAnimation*".
+ * @param time Time in second.
+ * @return Return true if successfully computed, and false otherwise.
+ */
+__FBXM_MAKE_FUNC(bool, FBXComputeAnimationWorldPose, const void* pOutPose, void* pCursors, const void* pAnimation, float time);
+
+/**
+ * @brief Deform vertices of skinned mesh on CPU.
+ * @param pOutPositions Output positions. Must be set to an address of 3xfloat array which has same count with Vertices.
+ * @param pOutNormals Output normals. Must be set to an address of 3xfloat array which has same count with Vertices, or nullptr to skip.
+ * @param pSkinnedMesh Reference skinned mesh. Must be passed by "const FBXSkinnedMesh*".
+ * @param pBoneMatrices World matrices of bones in pose. Must be set to an address of 16xfloat array which has same count with SkinDeforms, and same order.
+ * @param mode Skinning method. Must be passed by "FBXSkinningMode".
+ * @return Return true if successfully deformed, and false otherwise.
+ */
+__FBXM_MAKE_FUNC(bool, FBXComputeSkinning, void* pOutPositions, void* pOutNormals, const void* pSkinnedMesh, const void* pBoneMatrices, unsigned long mode);
+
+/**
+ * @brief Move root motion of animation out of root node into separate track. Keys of root node and world keys of its descendants are rewritten in place. World keys are left as they are if HasWorldKeys of the animation is false.
+ * @param pOutRootMotion Output root motion track, which is parent of root node. Local and World are same. BindNode is same as of root node. Must be passed by "FBXAnimationNode*".
+ * @param pAnimation Animation to be modified. Must be passed by "FBXAnimation*".
+ * @param pRootNode Root node of motion. Must be passed by "const FBXNode*", which is bound to one of AnimationNodes.
+ * @param flags Components to extract. Must be passed by combination of "FBXRootMotionFlag".
+ * @return Return true if successfully extracted, and false otherwise.
+ */
+__FBXM_MAKE_FUNC(bool, FBXExtractRootMotion, void* pOutRootMotion, void* pAnimation, const void* pRootNode, unsigned long flags);
+/**
+ * @brief Make additive animation of key deltas against reference pose. Scaling delta is ratio, rotation delta is applied after base rotation and translation delta is difference.
+ * @param pOutAnimation Output additive animation, which has same layout with source. Channel without keys gets one key of its bind pose delta. Can be same with pAnimation or pReferenceAnimation. Must be passed by "FBXAnimation*".
+ * @param pAnimation Source animation. Must be passed by "const FBXAnimation*".
+ * @param pReferenceAnimation Animation which reference pose is sampled from, such as pAnimation itself, or nullptr to use bind pose. Nodes not in reference animation use bind pose. Must have world keys if pAnimation has. Must be passed by "const FBXAnimation*".
+ * @param referenceTime Time in second of reference pose. Ignored if pReferenceAnimation is nullptr.
+ * @return Return true if successfully made, and false otherwise.
+ */
+__FBXM_MAKE_FUNC(bool, FBXMakeAdditiveAnimation, void* pOutAnimation, const void* pAnimation, const void* pReferenceAnimation, float referenceTime);
+/**
+ * @brief Remove keys of loaded animation while interpolated error stays below tolerances, in both local and world space. Keys are removed from Local and World together. Only local space is checked if HasWorldKeys of the animation is false.
+ * @param pAnimation Animation to be reduced. Must be passed by "FBXAnimation*".
+ * @param scalingTolerance Tolerance of scaling error relative to scale. Tightened further so that descendants don't move more than translationTolerance.
+ * @param rotationTolerance Tolerance of rotation error in radian. Tightened further so that descendants don't move more than translationTolerance.
+ * @param translationTolerance Tolerance of world space distance. Local translation tolerance is divided by world scale of parent node.
+ * @return Return true if successfully reduced, and false otherwise.
+ */
+__FBXM_MAKE_FUNC(bool, FBXReduceAnimationKeys, void* pAnimation, float scalingTolerance, float rotationTolerance, float translationTolerance);
+/**
+ * @brief Compress animation into quantized tracks. Cubic and stepped segments are converted to linear keys, rotations are stored in smallest three form, and constant or identity tracks are stored without keys.
+ * @param pOutCompressedAnimation Output compressed animation. Must be passed by "FBXCompressedAnimation*".
+ * @param pAnimation Animation to be compressed. Must be passed by "const FBXAnimation*".
+ * @param scalingTolerance Tolerance of scaling error relative to scale. Tightened further so that descendants don't move more than translationTolerance.
+ * @param rotationTolerance Tolerance of rotation error in radian. Tightened further so that descendants don't move more than translationTolerance.
+ * @param translationTolerance Tolerance of world space distance. Local translation tolerance is divided by world scale of parent node.
+ * @param bWorld Compress world transforms if true, and local transforms otherwise. Fails on true if HasWorldKeys of the animation is false.
+ * @return Return true if successfully compressed, and false otherwise.
+ */
+__FBXM_MAKE_FUNC(bool, FBXCompressAnimation, void* pOutCompressedAnimation, const void* pAnimation, float scalingTolerance, float rotationTolerance, float translationTolerance, bool bWorld);
+/**
+ * @brief Compute transforms of every animation node on specific time at once from compressed animation. Transforms are of the space which the animation is compressed in.
+ * @param pOutPose Output SoA pose. Must be passed by "const FBXAnimationPose*", whose planes have same count with NodeCount.
+ * @param pCursors Key positions of previous call. Must be set to an address of FBXAnimationCursor array which has same count with NodeCount, or nullptr. Sequential sampling with same cursors costs O(1) per track.
+ * @param pCompressedAnimation Reference compressed animation. Must be passed by "const FBXCompressedAnimation*".
+ * @param time Time in second.
+ * @return Return true if successfully decompressed, and false otherwise.
+ */
+__FBXM_MAKE_FUNC(bool, FBXDecompressAnimationPose, const void* pOutPose, void* pCursors, const void* pCompressedAnimation, float time);
+/**
+ * @brief Resample every animation node on a fixed frame rate into Samples of the animation, so that a frame can be read by direct indexing. World of samples is left zero if HasWorldKeys of the animation is false.
+ * @param pAnimation Target animation. Must be passed by "FBXAnimation*".
+ * @param sampleRate Frames per second. 0 releases Samples.
+ * @return Return true if successfully resampled, and false otherwise.
+ */
+__FBXM_MAKE_FUNC(bool, FBXResampleAnimation, void* pAnimation, float sampleRate);
+/**
+ * @brief Rebuild World of every key and its tangents from local keys and the node hierarchy, and set HasWorldKeys of the animation. World of a key is the composed transform at the time of the key, as the importer evaluates it.
+ * @param pAnimation Target animation. Must be passed by "FBXAnimation*".
+ * @return Return true if successfully rebuilt, and false otherwise.
+ */
+__FBXM_MAKE_FUNC(bool, FBXBuildAnimationWorldKeys, void* pAnimation);
+/**
+ * @brief Bring every rotation key to the hemisphere of the previous key and renormalize it, so that interpolation takes the short way. Tangents follow the keys. Needs no FBX SDK, so it can run on animations built by hand before export as well as on loaded ones.
+ * @param pAnimation Target animation. Must be passed by "FBXAnimation*".
+ * @param duplicateTolerance Keys whose neighbors are within this angle in radian, and whose segments have slopes under it per second, are removed. 0 keeps every key.
+ * @return Return true if successfully normalized, and false otherwise.
+ */
+__FBXM_MAKE_FUNC(bool, FBXNormalizeAnimationRotations, void* pAnimation, float duplicateTolerance);
+/**
+ * @brief Compress animation into fixed duration blocks, each of which is decompressed on its own. Long clips can be kept on disk, and only the block being played has to be loaded.
+ * @param pOutStreamingAnimation Output streaming animation. Must be passed by "FBXStreamingAnimation*".
+ * @param pAnimation Source animation. Must be passed by "const FBXAnimation*".
+ * @param blockDuration Duration of a block in second.
+ * @param scalingTolerance Same as of FBXCompressAnimation.
+ * @param rotationTolerance Same as of FBXCompressAnimation.
+ * @param translationTolerance Same as of FBXCompressAnimation.
+ * @param bWorld Compress world transforms if true, and local transforms otherwise. Fails on true if HasWorldKeys of the animation is false.
+ * @return Return true if successfully compressed, and false otherwise.
+ */
+__FBXM_MAKE_FUNC(bool, FBXCompressStreamingAnimation, void* pOutStreamingAnimation, const void* pAnimation, float blockDuration, float scalingTolerance, float rotationTolerance, float translationTolerance, bool bWorld);
+/**
+ * @brief Compute transforms of every animation node on specific time at once from a block of streaming animation. Only the block is read.
+ * @param pOutPose Output SoA pose. Must be passed by "const FBXAnimationPose*", whose planes have same count with NodeCount.
+ * @param pCursors Key positions of previous call. Must be set to an address of FBXAnimationCursor array which has same count with NodeCount, or nullptr. Cursors of another block are still valid hints.
+ * @param pBlock Address of the block, which is Data.Values + BlockOffsets.Values[i] of FBXStreamingAnimation or a copy of it. Must be 8 bytes aligned.
+ * @param time Time in second on the whole clip. Block i covers [i * BlockDuration, (i + 1) * BlockDuration], and time out of the block is clamped.
+ * @return Return true if successfully decompressed, and false otherwise.
+ */
+__FBXM_MAKE_FUNC(bool, FBXDecompressAnimationBlockPose, const void* pOutPose, void* pCursors, const void* pBlock, float time);
+/**
+ * @brief Retarget animations of a skeleton onto another skeleton of different proportions and bind pose. The rotation of each bone from its bind pose is carried over in world space, and translations from the bind pose are scaled by the ratio of bone lengths. Clips are retargeted in parallel.
+ * @param pOutAnimations Output animations. Must be passed by "FBXAnimation*", which points an array of animationCount elements. Can be same with pAnimations. Each animation has an animation node for every mapped bone animated by the source, bound to the target bone.
+ * @param pAnimations Source animations. Must be passed by "const FBXAnimation*", which points an array of animationCount elements, such as Animations.Values of FBXRoot.
+ * @param animationCount Count of animations.
+ * @param pSourceRoot Root of the source skeleton. Must be passed by "const FBXRoot*". Animation nodes of the source must be bound to its nodes.
+ * @param pTargetRoot Root of the target skeleton. Must be passed by "const FBXRoot*".
+ * @param szSourceNames Names of source bones which are mapped to szTargetNames of same index. Can be nullptr if mappingCount is 0.
+ * @param szTargetNames Names of target bones. Can be nullptr if mappingCount is 0.
+ * @param mappingCount Count of mapped names. If 0, bones of same name are mapped.
+ * @return Return true if successfully retargeted, and false otherwise.
+ */
+__FBXM_MAKE_FUNC(bool, FBXRetargetAnimations, void* pOutAnimations, const void* pAnimations, unsigned long animationCount, const void* pSourceRoot, const void* pTargetRoot, const FBX_CHAR** szSourceNames, const FBX_CHAR** szTargetNames, unsigned long mappingCount);
+/**
+ * @brief Cut animation into new animations by time ranges. Keys inside a range are copied, and a boundary inside a segment gets a key cut from the segment, so the curves are kept as they are. Times are rebased to start from 0.
+ * @param pOutAnimations Output animations. Must be passed by "FBXAnimation*", which points an array of rangeCount elements. Must not contain pAnimation.
+ * @param pAnimation Source animation. Must be passed by "const FBXAnimation*".
+ * @param pTimeRanges Ranges in second as pairs of start and end time, which has rangeCount * 2 elements. Ranges are clamped to [0, EndTime] of the source, and may overlap.
+ * @param rangeCount Count of ranges.
+ * @return Return true if successfully cut, and false otherwise.
+ */
+__FBXM_MAKE_FUNC(bool, FBXSplitAnimation, void* pOutAnimations, const void* pAnimation, const float* pTimeRanges, unsigned long rangeCount);
+/**
+ * @brief Blend SoA poses by weight. Scaling and translation are averaged by weight, and rotations are summed on the hemisphere of the first pose then normalized. Nodes are processed 4 at a time with SIMD.
+ * @param pOutPose Output SoA pose. Must be passed by "const FBXAnimationPose*", whose planes have nodeCount elements. Can be same with any of pPoses.
+ * @param pPoses Input SoA poses. Must be passed by "const FBXAnimationPose*", which points an array of poseCount elements.
+ * @param pWeights Weight of each pose, which has poseCount elements. Weights don't have to sum to 1. A node whose weights sum to 0 takes the first pose.
+ * @param pMasks Per node weight of each pose, which has poseCount arrays of nodeCount elements, multiplied to pWeights. Can be nullptr, and so can each array, which means 1 for every node.
+ * @param poseCount Count of poses. Nothing is written if 0.
+ * @param nodeCount Count of nodes.
+ * @return Return true if successfully blended, and false otherwise.
+ */
+__FBXM_MAKE_FUNC(bool, FBXBlendAnimationPoses, const void* pOutPose, const void* pPoses, const float* pWeights, const float* const* pMasks, unsigned long poseCount, unsigned long nodeCount);
+/**
+ * @brief Apply SoA pose of an additive animation made by FBXMakeAdditiveAnimation on a base pose. Scaling is multiplied, rotation is applied after the base rotation, and translation is added. Nodes are processed 4 at a time with SIMD.
+ * @param pOutPose Output SoA pose. Must be passed by "const FBXAnimationPose*", whose planes have nodeCount elements. Can be same with pBasePose or pAdditivePose.
+ * @param pBasePose Base SoA pose. Must be passed by "const FBXAnimationPose*".
+ * @param pAdditivePose Additive SoA pose. Must be passed by "const FBXAnimationPose*".
+ * @param weight Weight of the additive pose. 0 gives the base pose, and 1 applies the whole delta.
+ * @param pMask Per node weight, which has nodeCount elements, multiplied to weight. Can be nullptr, which means 1 for every node.
+ * @param nodeCount Count of nodes.
+ * @return Return true if successfully applied, and false otherwise.
+ */
+__FBXM_MAKE_FUNC(bool, FBXApplyAdditiveAnimationPose, const void* pOutPose, const void* pBasePose, const void* pAdditivePose, float weight, const float* pMask, unsigned long nodeCount);
+/**
+ * @brief Build links of animation nodes to their nearest animated ancestors, which FBXConvertAnimationPoseToWorld walks. Links only depend on the hierarchy, so they can be built once and shared by every clip of same node layout.
+ * @param pOutLinks Output links. Must be passed by "FBXAnimationPoseLink*", which points an array of same count with AnimationNodes.
+ * @param pAnimation Reference animation. Must be passed by "const FBXAnimation*".
+ * @return Return true if successfully built, and false otherwise.
+ */
+__FBXM_MAKE_FUNC(bool, FBXBuildAnimationPoseLinks, void* pOutLinks, const void* pAnimation);
+/**
+ * @brief Convert local SoA pose to world SoA pose, such as the output of FBXBlendAnimationPoses. Transforms are concatenated as scaling, rotation and translation, which is exact unless a non-uniform scaling meets a rotation below it. Nodes of same depth are processed 4 at a time with SIMD.
+ * @param pOutPose Output SoA pose. Must be passed by "const FBXAnimationPose*", whose planes have nodeCount elements. Can be same with pLocalPose.
+ * @param pLocalPose Local SoA pose. Must be passed by "const FBXAnimationPose*".
+ * @param pLinks Links made by FBXBuildAnimationPoseLinks. Must be passed by "const FBXAnimationPoseLink*".
+ * @param nodeCount Count of nodes, which is count of AnimationNodes the links are made from.
+ * @return Return true if successfully converted, and false otherwise.
+ */
+__FBXM_MAKE_FUNC(bool, FBXConvertAnimationPoseToWorld, const void* pOutPose, const void* pLocalPose, const void* pLinks, unsigned long nodeCount);
+/**
+ * @brief Collect every node of root in the order FBXBakeWorldMatrices writes them, which is preorder(pretend left->child, right->sibling). Every parent comes before its children.
+ * @param pOutNodes Output nodes. Must be set to an address of "const FBXNode*" array which has pNodeCount elements, or nullptr to get the count only.
+ * @param pNodeCount Output count of nodes. Must not be nullptr.
+ * @param pRoot Reference root. Must be passed by "const FBXRoot*".
+ * @return Return true if successfully collected, and false otherwise.
+ */
+__FBXM_MAKE_FUNC(bool, FBXCollectNodes, const void** pOutNodes, unsigned long* pNodeCount, const void* pRoot);
+/**
+ * @brief Compute world matrices of every node of root in one pass, where each node is multiplied by the world matrix of its parent already computed. Costs O(n) against O(n * depth) of calling FBXGetWorldMatrix per node.
+ * @param pOutMatrices Output world matrices. Must be set to an address of 16xfloat array which has node count elements, in the order of FBXCollectNodes.
+ * @param pRoot Reference root. Must be passed by "const FBXRoot*".
+ * @param pAnimation Animation to pose nodes with. Must be passed by "const FBXAnimation*" whose animation nodes are bound to nodes of root, or nullptr for the bind pose. Nodes the animation doesn't have keep their TransformMatrix.
+ * @param time Time in second. Ignored if pAnimation is nullptr.
+ * @return Return true if successfully computed, and false otherwise.
+ */
+__FBXM_MAKE_FUNC(bool, FBXBakeWorldMatrices, float* pOutMatrices, const void* pRoot, const void* pAnimation, float time);
+/**
+ * @brief Same as FBXBakeWorldMatrices, but matrices are accumulated and written in double precision. Multiplication runs on AVX2 if the module is built with it.
+ * @param pOutMatrices Output world matrices. Must be set to an address of 16xdouble array which has node count elements, in the order of FBXCollectNodes.
+ * @param pRoot Reference root. Must be passed by "const FBXRoot*".
+ * @param pAnimation Animation to pose nodes with. Must be passed by "const FBXAnimation*", or nullptr for the bind pose.
+ * @param time Time in second. Ignored if pAnimation is nullptr.
+ * @return Return true if successfully computed, and false otherwise.
+ */
+__FBXM_MAKE_FUNC(bool, FBXBakeWorldMatricesDouble, double* pOutMatrices, const void* pRoot, const void* pAnimation, float time);
+
 
 __FBXM_MAKE_HIDDEN_FUNC(void, 2555, __hidden_FBXModule_DeleteInnerObject, void* pObj);
 
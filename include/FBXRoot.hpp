@@ -12,6 +12,7 @@
 #include "FBXBase.hpp"
 
 #include "FBXNode.hpp"
+#include "FBXMesh.hpp"
 #include "FBXMaterial.hpp"
 #include "FBXAnimation.hpp"
 
@@ -36,6 +37,9 @@ public:
     FBXDynamicArray<FBXAnimation> Animations;
     FBXDynamicArray<FBXMaterial> Materials;
 
+public:
+    FBXDynamicArray<FBXMeshInstance> MeshInstances; // filled only if "ShareInstancedMesh" of FBXIOSetting is set
+
 public:
     FBXNode* Nodes;
 };
@@ -14,11 +14,29 @@
 #include "FBXMesh.hpp"
 
 
+enum class FBXSkinningMode : unsigned long{
+    FBXSkinningMode_LinearBlend,
+    FBXSkinningMode_DualQuaternion,
+};
+
+
 class FBXSkinElement{
 public:
     FBXNode* BindNode;
     float Weight;
 };
+class FBXBoneBudget{
+public:
+    unsigned long MaxBoneCount;
+
+public:
+    FBXDynamicArray<FBXMeshAttribute> Attributes; // vertex range covers every vertex the attribute references
+    FBXDynamicArray<FBXStaticArray<unsigned long, 3>> Indices; // the index points 'Vertices' from the owner mesh
+    FBXDynamicArray<FBXDynamicArray<unsigned long>> Materials; // must have same count with LayeredElements of the owner mesh; same as FBXMeshLayerElement::Material
+
+public:
+    FBXDynamicArray<FBXDynamicArray<FBXNode*>> BoneCombinations; // must have same count with Attributes
+};
 class FBXSkinDeformElement{
 public:
     FBXStaticArray<float, 16> TransformMatrix;
@@ -43,6 +61,9 @@ public:
     FBXDynamicArray<FBXDynamicArray<FBXNode*>> BoneCombinations; // must have same count with Attributes
     FBXDynamicArray<FBXDynamicArray<FBXSkinElement>> SkinInfos; // must have same count with Vertices
     FBXDynamicArray<FBXSkinDeformElement> SkinDeforms;
+
+public:
+    FBXDynamicArray<FBXBoneBudget> BoneBudgets; // one per FBXIOSetting::ExtraBoneCountPerMesh. shares Vertices, LayeredElements and SkinInfos
 };
 
 
@@ -72,6 +72,8 @@ namespace __hidden_FBXModule{
                 dest_c->Vertices = src_c->Vertices;
 
                 dest_c->LayeredElements = src_c->LayeredElements;
+
+                dest_c->InstanceSource = src_c->InstanceSource;
             }
             if(FBXTypeHasMember(srcID, FBXType::FBXType_SkinnedMesh)){
                 auto* dest_c = static_cast<FBXSkinnedMesh*>(dest);
@@ -80,6 +82,8 @@ namespace __hidden_FBXModule{
                 dest_c->BoneCombinations = src_c->BoneCombinations;
                 dest_c->SkinInfos = src_c->SkinInfos;
                 dest_c->SkinDeforms = src_c->SkinDeforms;
+
+                dest_c->BoneBudgets = src_c->BoneBudgets;
             }
 
             dest->Parent = pDestParent;
@@ -101,6 +105,7 @@ static void FBXCopyRoot(T** pDest, const T* pSrc){
     __hidden_FBXModule::allocateNode(dest->Nodes, src->Nodes);
     dest->Materials = src->Materials;
     dest->Animations = src->Animations;
+    dest->MeshInstances = src->MeshInstances;
 
     __hidden_FBXModule_RebindRoot(dest, src);
 
@@ -177,12 +182,22 @@ static bool FBXCollapseBone(ROOT* pFBXRoot, SKINNED_MESH** pSkinnedMesh, const N
         pNewMesh->SkinInfos = pInnerMesh->SkinInfos;
         pNewMesh->SkinDeforms = pInnerMesh->SkinDeforms;
 
+        pNewMesh->BoneBudgets = pInnerMesh->BoneBudgets;
+
         for(auto* p0 = pNewMesh->BoneCombinations.Values; FBX_PTRDIFFU(p0 - pNewMesh->BoneCombinations.Values) < pNewMesh->BoneCombinations.Length; ++p0){
             for(auto* p1 = p0->Values; FBX_PTRDIFFU(p1 - p0->Values) < p0->Length; ++p1){
                 if((*p1) == pInnerMesh)
                     (*p1) = pNewMesh;
             }
         }
+        for(auto* p0 = pNewMesh->BoneBudgets.Values; FBX_PTRDIFFU(p0 - pNewMesh->BoneBudgets.Values) < pNewMesh->BoneBudgets.Length; ++p0){
+            for(auto* p1 = p0->BoneCombinations.Values; FBX_PTRDIFFU(p1 - p0->BoneCombinations.Values) < p0->BoneCombinations.Length; ++p1){
+                for(auto* p2 = p1->Values; FBX_PTRDIFFU(p2 - p1->Values) < p1->Length; ++p2){
+                    if((*p2) == pInnerMesh)
+                        (*p2) = pNewMesh;
+                }
+            }
+        }
         for(auto* p0 = pNewMesh->SkinInfos.Values; FBX_PTRDIFFU(p0 - pNewMesh->SkinInfos.Values) < pNewMesh->SkinInfos.Length; ++p0){
             for(auto* p1 = p0->Values; FBX_PTRDIFFU(p1 - p0->Values) < p0->Length; ++p1){
                 if(p1->BindNode == pInnerMesh)